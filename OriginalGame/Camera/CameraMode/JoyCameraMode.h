@@ -82,6 +82,15 @@ public:
 
 	virtual void UpdateCameraMode(float DeltaTime);
 
+	/**
+	 * 求值所依赖的输入与上次完整求值相同且过渡已收敛时返回 true，此时 View 已更新为本帧结果，
+	 * 不需要调用 UpdateCameraMode
+	 */
+	virtual bool TryReuseView(float DeltaTime)
+	{
+		return false;
+	}
+
 	float GetBlendTime() const
 	{
 		return BlendTime;
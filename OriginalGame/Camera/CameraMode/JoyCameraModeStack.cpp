@@ -7,6 +7,10 @@
 #include "JoyCameraMode_ThirdPerson.h"
 #include "Kismet/GameplayStatics.h"
 
+static TAutoConsoleVariable<bool> CVarForceFullEvaluation(TEXT("Joy.Camera.ForceFullEvaluation"), false,
+	TEXT("每帧完整求值相机模式，不复用输入未变化时的结果"),
+	ECVF_Default);
+
 UJoyCameraModeStack::UJoyCameraModeStack()
 {
 	bIsActive = true;
@@ -18,9 +22,10 @@ void UJoyCameraModeStack::ActivateStack()
 	{
 		bIsActive = true;
 
-		// Notify camera modes that they are being activated.
-		for (UJoyCameraMode* CameraMode : CameraModeStack)
+		// Notify camera modes that they are being activated, from top to bottom.
+		for (int32 StackIndex = CameraModeStack.Num() - 1; StackIndex >= 0; --StackIndex)
 		{
+			UJoyCameraMode* CameraMode = CameraModeStack[StackIndex];
 			check(CameraMode);
 			CameraMode->OnActivation();
 		}
@@ -35,32 +40,28 @@ void UJoyCameraModeStack::UpdateCameraStack()
 	 * 同时，我们要保证 Camera Stack 内的 Camera Mode 数量要 >= 1，所以只处理当栈长度大于 1 的情况
 	 */
 
-	TArray<FCameraModeAction*> TempCMOperations;
+	// 相邻的同类 Push、Pop 互相抵消，其余操作按顺序直接执行
 	for (int i = 0; i < CameraModeOperations.Num(); i++)
 	{
+		const FCameraModeAction CM = CameraModeOperations[i];
 		const int NextID = i + 1;
 		if (NextID < CameraModeOperations.Num() &&
-			(CameraModeOperations[i].CameraModeClass == CameraModeOperations[NextID].CameraModeClass &&
-				CameraModeOperations[i].OP == ECameraModePushPopOption::Push &&
+			(CM.CameraModeClass == CameraModeOperations[NextID].CameraModeClass &&
+				CM.OP == ECameraModePushPopOption::Push &&
 				CameraModeOperations[NextID].OP == ECameraModePushPopOption::Pop))
 		{
 			i += 1;
 			continue;
 		}
 
-		TempCMOperations.Add(&CameraModeOperations[i]);
-	}
-
-	for (FCameraModeAction* CM : TempCMOperations)
-	{
-		if (CM->OP == ECameraModePushPopOption::Push)
+		if (CM.OP == ECameraModePushPopOption::Push)
 		{
-			PushCameraMode(CM->CameraModeClass, CM->bBlending);
+			PushCameraMode(CM.CameraModeClass, CM.bBlending);
 		}
 		else if (GetCameraStackNum() >= 1)
 		{
 			const UJoyCameraMode* TopCameraMode = GetTopCameraMode();
-			if (TopCameraMode->GetClass() == CM->CameraModeClass)
+			if (TopCameraMode->GetClass() == CM.CameraModeClass)
 			{
 				RemoveTopCameraMode();
 			}
@@ -73,7 +74,7 @@ void UJoyCameraModeStack::UpdateCameraStack()
 		PushCameraMode(GetDefaultCameraModeClass(), true);
 	}
 
-	CameraModeOperations.Empty();
+	CameraModeOperations.Reset();
 }
 
 void UJoyCameraModeStack::DeactivateStack()
@@ -82,9 +83,10 @@ void UJoyCameraModeStack::DeactivateStack()
 	{
 		bIsActive = false;
 
-		// Notify camera modes that they are being deactivated.
-		for (UJoyCameraMode* CameraMode : CameraModeStack)
+		// Notify camera modes that they are being deactivated, from top to bottom.
+		for (int32 StackIndex = CameraModeStack.Num() - 1; StackIndex >= 0; --StackIndex)
 		{
+			UJoyCameraMode* CameraMode = CameraModeStack[StackIndex];
 			check(CameraMode);
 			CameraMode->OnDeactivation();
 		}
@@ -100,7 +102,7 @@ UJoyCameraMode* UJoyCameraModeStack::GetTopCameraMode()
 {
 	if (GetCameraStackNum() > 0)
 	{
-		return CameraModeStack[0];
+		return CameraModeStack.Last();
 	}
 
 	return nullptr;
@@ -110,12 +112,12 @@ void UJoyCameraModeStack::RemoveTopCameraMode()
 {
 	if (CameraModeStack.Num() > 0)
 	{
-		if (const auto CameraMode = CameraModeStack[0]; CameraMode.Get())
+		if (const auto CameraMode = CameraModeStack.Last(); CameraMode.Get())
 		{
 			CameraMode->OnDeactivation();
 		}
 
-		CameraModeStack.RemoveAt(0);
+		CameraModeStack.Pop();
 	}
 }
 
@@ -131,7 +133,7 @@ void UJoyCameraModeStack::PushCameraMode(TSubclassOf<UJoyCameraMode> CameraModeC
 
 	int32 StackSize = CameraModeStack.Num();
 
-	if ((StackSize > 0) && (CameraModeStack[0] == CameraMode))
+	if ((StackSize > 0) && (CameraModeStack.Last() == CameraMode))
 	{
 		// Already top of stack.
 		return;
@@ -142,7 +144,7 @@ void UJoyCameraModeStack::PushCameraMode(TSubclassOf<UJoyCameraMode> CameraModeC
 	int32 ExistingStackIndex = INDEX_NONE;
 	float ExistingStackContribution = 1.0f;
 
-	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	for (int32 StackIndex = StackSize - 1; StackIndex >= 0; --StackIndex)
 	{
 		if (CameraModeStack[StackIndex] == CameraMode)
 		{
@@ -173,10 +175,10 @@ void UJoyCameraModeStack::PushCameraMode(TSubclassOf<UJoyCameraMode> CameraModeC
 	CameraMode->SetBlendWeight(BlendWeight);
 
 	// Add new entry to top of stack.
-	CameraModeStack.Insert(CameraMode, 0);
+	CameraModeStack.Add(CameraMode);
 
 	// Make sure stack bottom is always weighted 100%.
-	CameraModeStack.Last()->SetBlendWeight(1.0f);
+	CameraModeStack[0]->SetBlendWeight(1.0f);
 
 	// Let the camera mode know if it's being added to the stack.
 	if (ExistingStackIndex == INDEX_NONE)
@@ -187,6 +189,7 @@ void UJoyCameraModeStack::PushCameraMode(TSubclassOf<UJoyCameraMode> CameraModeC
 
 bool UJoyCameraModeStack::EvaluateStack(float DeltaTime, FJoyCameraModeView& OutCameraModeView)
 {
+	bViewReused = false;
 	if (!bIsActive)
 	{
 		return false;
@@ -198,6 +201,16 @@ bool UJoyCameraModeStack::EvaluateStack(float DeltaTime, FJoyCameraModeView& Out
 		DeltaTime = DeltaTime / TimeDilationSystem->GetGlobalTimeDilation();
 	}
 
+	// 栈顶已完全混入时只有它参与求值，其输入没有变化就直接复用上次的结果
+	UJoyCameraMode* TopCameraMode = GetTopCameraMode();
+	bViewReused = TopCameraMode != nullptr && TopCameraMode->GetBlendWeight() >= 1.0f &&
+				  !CVarForceFullEvaluation.GetValueOnGameThread() && TopCameraMode->TryReuseView(DeltaTime);
+	if (bViewReused)
+	{
+		OutCameraModeView = TopCameraMode->GetCameraModeView();
+		return true;
+	}
+
 	const int RemoveCount = UpdateStack(DeltaTime);
 	BlendStack(OutCameraModeView, RemoveCount);
 
@@ -209,19 +222,17 @@ UJoyCameraMode* UJoyCameraModeStack::GetCameraModeInstance(TSubclassOf<UJoyCamer
 	check(CameraModeClass);
 
 	// First see if we already created one.
-	for (UJoyCameraMode* CameraMode : CameraModeInstances)
+	TObjectPtr<UJoyCameraMode>& CameraMode = CameraModeInstances.FindOrAdd(CameraModeClass);
+	if (CameraMode != nullptr)
 	{
-		if ((CameraMode != nullptr) && (CameraMode->GetClass() == CameraModeClass))
-		{
-			return CameraMode;
-		}
+		return CameraMode;
 	}
 
 	// Not found, so we need to create it.
 	UJoyCameraMode* NewCameraMode = NewObject<UJoyCameraMode>(GetOuter(), CameraModeClass, NAME_None, RF_NoFlags);
 	check(NewCameraMode);
 
-	CameraModeInstances.Add(NewCameraMode);
+	CameraMode = NewCameraMode;
 
 	return NewCameraMode;
 }
@@ -235,9 +246,8 @@ int UJoyCameraModeStack::UpdateStack(float DeltaTime)
 	}
 
 	int32 RemoveCount = 0;
-	int32 RemoveIndex = INDEX_NONE;
 
-	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	for (int32 StackIndex = StackSize - 1; StackIndex >= 0; --StackIndex)
 	{
 		UJoyCameraMode* CameraMode = CameraModeStack[StackIndex];
 		check(CameraMode);
@@ -247,8 +257,7 @@ int UJoyCameraModeStack::UpdateStack(float DeltaTime)
 		if (CameraMode->GetBlendWeight() >= 1.0f)
 		{
 			// Everything below this mode is now irrelevant and can be removed.
-			RemoveIndex = (StackIndex + 1);
-			RemoveCount = (StackSize - RemoveIndex);
+			RemoveCount = StackIndex;
 			break;
 		}
 	}
@@ -258,19 +267,19 @@ int UJoyCameraModeStack::UpdateStack(float DeltaTime)
 
 void UJoyCameraModeStack::BlendStack(FJoyCameraModeView& OutCameraModeView, const int RemoveCount) const
 {
-	const int32 StackSize = CameraModeStack.Num() - RemoveCount;
-	if (StackSize <= 0)
+	const int32 StackSize = CameraModeStack.Num();
+	if (StackSize - RemoveCount <= 0)
 	{
 		return;
 	}
 
 	// Start at the bottom and blend up the stack
-	const UJoyCameraMode* CameraMode = CameraModeStack[StackSize - 1];
+	const UJoyCameraMode* CameraMode = CameraModeStack[RemoveCount];
 	check(CameraMode);
 
 	OutCameraModeView = CameraMode->GetCameraModeView();
 
-	for (int32 StackIndex = (StackSize - 2); StackIndex >= 0; --StackIndex)
+	for (int32 StackIndex = RemoveCount + 1; StackIndex < StackSize; ++StackIndex)
 	{
 		CameraMode = CameraModeStack[StackIndex];
 		check(CameraMode);
@@ -289,7 +298,8 @@ void UJoyCameraModeStack::GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTag&
 	}
 	else
 	{
-		UJoyCameraMode* TopEntry = CameraModeStack.Last();
+		// 与栈反转前的行为保持一致，取栈底的层
+		UJoyCameraMode* TopEntry = CameraModeStack[0];
 		check(TopEntry);
 		OutWeightOfTopLayer = TopEntry->GetBlendWeight();
 		OutTagOfTopLayer = TopEntry->GetCameraTypeTag();
@@ -28,6 +28,7 @@ struct FCameraModeAction
  * UJoyCameraModeStack
  *
  *	Stack used for blending camera modes.
+ *	栈顶位于数组末尾，压栈与出栈都是 O(1)
  */
 UCLASS()
 class ORIGINALGAME_API UJoyCameraModeStack : public UObject
@@ -35,6 +36,7 @@ class ORIGINALGAME_API UJoyCameraModeStack : public UObject
 	GENERATED_BODY()
 
 	friend class UJoyCameraComponent;
+	friend class FJoyCameraModeStackBlendTest;
 
 public:
 	UJoyCameraModeStack();
@@ -51,6 +53,12 @@ public:
 
 	bool EvaluateStack(float DeltaTime, FJoyCameraModeView& OutCameraModeView);
 
+	// 上次 EvaluateStack 是否直接复用了上一帧的结果
+	bool IsViewReused() const
+	{
+		return bViewReused;
+	}
+
 	// Gets the tag associated with the top layer and the blend weight of it
 	void GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTag& OutTagOfTopLayer) const;
 
@@ -78,9 +86,13 @@ protected:
 private:
 	bool bIsActive;
 
+	bool bViewReused = false;
+
+	// 按类索引的 CameraMode 实例，每个类只创建一次
 	UPROPERTY()
-	TArray<TObjectPtr<UJoyCameraMode>> CameraModeInstances;
+	TMap<TSubclassOf<UJoyCameraMode>, TObjectPtr<UJoyCameraMode>> CameraModeInstances;
 
+	// 下标 0 为栈底，末尾为栈顶
 	UPROPERTY()
 	TArray<TObjectPtr<UJoyCameraMode>> CameraModeStack;
 
@@ -3,6 +3,8 @@
 #include "JoyCameraMode_ThirdPerson.h"
 
 #include "Camera/JoyCameraComponent.h"
+#include "Camera/JoyCameraSpring.h"
+#include "Camera/JoyCameraStats.h"
 #include "Camera/JoyPenetrationAvoidanceFeeler.h"
 #include "Camera/JoyPlayerCameraManager.h"
 #include "Character/JoyCharacter.h"
@@ -19,6 +21,63 @@
 namespace JoyCameraMode_ThirdPerson_Statics
 {
 static const FName NAME_IgnoreCameraCollision = TEXT("IgnoreCameraCollision");
+
+// 判断输入未变化与过渡收敛时的容差
+static constexpr float ReuseTolerance = 1e-3f;
+
+// 相机臂角速度或线速度达到该值时所有 Feeler 每帧检测
+static constexpr float FeelerFastAngularSpeed = 180.f;
+
+static constexpr float FeelerFastLinearSpeed = 600.f;
+
+// 相机臂静止时检测间隔相对配置的倍数
+static constexpr float FeelerIdleIntervalScale = 2.f;
+
+// 最近若干帧内命中过的 Feeler 每帧检测
+static constexpr int32 FeelerRecentHitFrames = 10;
+
+// 遮挡缓存最多连续确认的次数
+static constexpr int32 MaxBlockerConfirmations = 4;
+
+static constexpr int32 MaxPenetrationBlockers = 8;
+
+// 弹簧角频率相对 LagRecoverSpeed 的倍数，使收敛到 1% 的时间与 VInterpTo 相近
+static constexpr float SpringLagFrequencyScale = 1.5f;
+}
+
+static TAutoConsoleVariable<int32> CVarMaxReusedFrames(TEXT("Joy.Camera.MaxReusedFrames"), 15,
+	TEXT("相机输入不变时最多连续复用上次相机臂位姿的帧数，之后完整求值一次；复用时穿透检测仍每帧进行"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarAsyncPenetration(TEXT("Joy.Camera.AsyncPenetration"), false,
+	TEXT("相机穿透检测使用异步检测，结果在下一帧按预测位姿使用；关闭时每帧同步检测"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarAdaptiveFeelers(TEXT("Joy.Camera.AdaptiveFeelers"), true,
+	TEXT("根据相机臂运动与最近命中调整穿透检测 Feeler 的检测间隔；关闭时使用配置的固定间隔"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarPenetrationBlockerCache(TEXT("Joy.Camera.PenetrationBlockerCache"), true,
+	TEXT("穿透检测先对最近挡住相机的图元做检测，仍然遮挡时跳过场景检测"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarSpringLag(TEXT("Joy.Camera.SpringLag"), false,
+	TEXT("相机臂位置与旋转延迟使用临界阻尼弹簧，结果与更新频率无关；关闭时使用 VInterpTo/RInterpTo"),
+	ECVF_Default);
+
+bool FJoyThirdPersonViewInputs::Equals(const FJoyThirdPersonViewInputs& Other) const
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	return TargetLocation.Equals(Other.TargetLocation, ReuseTolerance) &&
+		   TargetRotation.Equals(Other.TargetRotation, ReuseTolerance) &&
+		   PivotLocation.Equals(Other.PivotLocation, ReuseTolerance) &&
+		   PivotRotation.Equals(Other.PivotRotation, ReuseTolerance) &&
+		   FMath::IsNearlyEqual(ArmLength, Other.ArmLength, ReuseTolerance) &&
+		   FMath::IsNearlyEqual(FieldOfView, Other.FieldOfView, ReuseTolerance) &&
+		   FMath::IsNearlyEqual(MinArmLength, Other.MinArmLength, ReuseTolerance) &&
+		   FMath::IsNearlyEqual(MaxArmLength, Other.MaxArmLength, ReuseTolerance) &&
+		   bLocationLag == Other.bLocationLag && bRotationLag == Other.bRotationLag;
 }
 
 UJoyCameraMode_ThirdPerson::UJoyCameraMode_ThirdPerson()
@@ -86,34 +145,92 @@ bool UJoyCameraMode_ThirdPerson::IsEnableRotationLag() const
 	return PlayerCameraManager != nullptr ? PlayerCameraManager->bEnableCameraRotLag : false;
 }
 
-void UJoyCameraMode_ThirdPerson::UpdateView(float DeltaTime)
+void UJoyCameraMode_ThirdPerson::GatherViewInputs(FJoyThirdPersonViewInputs& OutInputs) const
 {
-	UpdateForTarget(DeltaTime);
-	UpdateCrouchOffset(DeltaTime);
+	AActor* TargetActor = GetTargetActor();
+	if (TargetActor != nullptr)
+	{
+		OutInputs.TargetLocation = TargetActor->GetActorLocation();
+		OutInputs.TargetRotation = TargetActor->GetActorQuat();
+	}
 
-	/* ------------------------------------------------------------------------------ */
-	/* ----------------- 计算 ArmLength \ ArmRotation \ ArmLocation ------------------ */
-	/* ------------------------------------------------------------------------------ */
-	float ArmLength = -350;
 	if (PlayerCameraManager != nullptr)
 	{
-		// 获取相机臂长度
-		ArmLength = -PlayerCameraManager->GetCurrentArmLength(GetTargetActor());
-
-		// 更新相机 Fov
-		View.FieldOfView = PlayerCameraManager->GetCurrentCameraFov(GetTargetActor());
+		// 相机臂长度与 Fov
+		OutInputs.ArmLength = PlayerCameraManager->GetCurrentArmLength(TargetActor);
+		OutInputs.FieldOfView = PlayerCameraManager->GetCurrentCameraFov(TargetActor);
 
-		// 更新相机臂配置
-		MinArmLength = PlayerCameraManager->GetBaseMinArmLength();
-		MaxArmLength = PlayerCameraManager->GetBaseMaxArmLength();
+		// 相机臂配置
+		OutInputs.MinArmLength = PlayerCameraManager->GetBaseMinArmLength();
+		OutInputs.MaxArmLength = PlayerCameraManager->GetBaseMaxArmLength();
 	}
 	else
 	{
-		View.FieldOfView = JOY_CAMERA_DEFAULT_FOV;
+		OutInputs.ArmLength = 350;
+		OutInputs.FieldOfView = JOY_CAMERA_DEFAULT_FOV;
+		OutInputs.MinArmLength = MinArmLength;
+		OutInputs.MaxArmLength = MaxArmLength;
+	}
+
+	OutInputs.PivotRotation = CalcPivotRotation();
+	OutInputs.PivotLocation = CalcPivotLocation();
+	OutInputs.bLocationLag = IsEnableLocationLag();
+	OutInputs.bRotationLag = IsEnableRotationLag();
+}
+
+bool UJoyCameraMode_ThirdPerson::TryReuseView(float DeltaTime)
+{
+	if (!bViewConverged || bResetInterpolation || NumReusedFrames >= CVarMaxReusedFrames.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	// ViewTarget 切换等情况会清空相机数据，需要重新求值
+	const UJoyCameraComponent* CameraComponent = GetJoyCameraComponent();
+	if (CameraComponent == nullptr || !CameraComponent->CameraDataThisFrame.ArmLocation.CheckValid() ||
+		!CameraComponent->CameraDataThisFrame.ViewRotation.CheckValid())
+	{
+		return false;
 	}
 
-	FRotator FinalRotator = CalcPivotRotation();
-	FVector FinalLocation = CalcPivotLocation();
+	FJoyThirdPersonViewInputs ViewInputs;
+	GatherViewInputs(ViewInputs);
+	if (!ViewInputs.Equals(LastViewInputs))
+	{
+		return false;
+	}
+
+	// 只复用相机臂位姿与延迟的结果，穿透检测照常进行，场景中新出现的遮挡在当帧生效
+	const float LastBlockedPct = AimLineToDesiredPosBlockedPct;
+	View.Location = LastDesiredViewLocation;
+	UpdatePreventPenetration(DeltaTime);
+
+	// 穿透比例发生变化时下一帧完整求值，直到重新收敛
+	bViewConverged = FMath::IsNearlyEqual(
+		LastBlockedPct, AimLineToDesiredPosBlockedPct, JoyCameraMode_ThirdPerson_Statics::ReuseTolerance);
+
+	NumReusedFrames++;
+	return true;
+}
+
+void UJoyCameraMode_ThirdPerson::UpdateView(float DeltaTime)
+{
+	UpdateForTarget(DeltaTime);
+	UpdateCrouchOffset(DeltaTime);
+
+	/* ------------------------------------------------------------------------------ */
+	/* ----------------- 计算 ArmLength \ ArmRotation \ ArmLocation ------------------ */
+	/* ------------------------------------------------------------------------------ */
+	GatherViewInputs(LastViewInputs);
+	NumReusedFrames = 0;
+
+	const float ArmLength = -LastViewInputs.ArmLength;
+	View.FieldOfView = LastViewInputs.FieldOfView;
+	MinArmLength = LastViewInputs.MinArmLength;
+	MaxArmLength = LastViewInputs.MaxArmLength;
+
+	FRotator FinalRotator = LastViewInputs.PivotRotation;
+	FVector FinalLocation = LastViewInputs.PivotLocation;
 
 	/* --------------------------------------------------- */
 	/* ----------------- 应用镜头位姿延迟 ------------------- */
@@ -139,7 +256,25 @@ void UJoyCameraMode_ThirdPerson::UpdateView(float DeltaTime)
 		}
 	}
 
+	LastDesiredViewLocation = View.Location;
+	const float LastBlockedPct = AimLineToDesiredPosBlockedPct;
 	UpdatePreventPenetration(DeltaTime);
+
+	// 延迟后的相机臂位姿已追上目标，且穿透比例不再插值
+	if (const UJoyCameraComponent* CameraComponent = GetJoyCameraComponent())
+	{
+		using namespace JoyCameraMode_ThirdPerson_Statics;
+
+		const FCameraData& CameraData = CameraComponent->CameraDataThisFrame;
+		bViewConverged = CameraData.ArmLocation.CheckValid() && CameraData.ViewRotation.CheckValid() &&
+						 CameraData.ArmLocation.Data.Equals(LastViewInputs.PivotLocation, ReuseTolerance) &&
+						 CameraData.ViewRotation.Data.Equals(LastViewInputs.PivotRotation, ReuseTolerance) &&
+						 FMath::IsNearlyEqual(LastBlockedPct, AimLineToDesiredPosBlockedPct, ReuseTolerance);
+	}
+	else
+	{
+		bViewConverged = false;
+	}
 }
 
 void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
@@ -158,6 +293,9 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 		if (!CameraComponent->CameraDataThisFrame.ViewRotation.CheckValid())
 		{
 			CameraComponent->CameraDataThisFrame.ViewRotation.Set(DesiredRot);
+			// 镜头数据被清理（切换 ViewTarget 等），弹簧状态同样失效
+			bHasSpringRotationTarget = false;
+			SpringRotationVelocity = FVector::ZeroVector;
 			return;
 		}
 
@@ -166,7 +304,20 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 		const float CameraRotLagRecoverSpeed = PlayerCameraManager != nullptr
 			                                       ? PlayerCameraManager->GetArmRotatorLagRecoverSpeed()
 			                                       : DefaultCameraRotLagSpeed;
-		DesiredRot = FMath::RInterpTo(QCurrent.Rotator(), QTarget.Rotator(), DeltaTime, CameraRotLagRecoverSpeed);
+		if (CVarSpringLag.GetValueOnGameThread())
+		{
+			DesiredRot = UpdateSpringRotationLag(
+				QCurrent.Rotator(), QTarget.Rotator(), DeltaTime, CameraRotLagRecoverSpeed);
+		}
+		else
+		{
+			DesiredRot = FMath::RInterpTo(QCurrent.Rotator(), QTarget.Rotator(), DeltaTime, CameraRotLagRecoverSpeed);
+			bHasSpringRotationTarget = false;
+		}
+	}
+	else
+	{
+		bHasSpringRotationTarget = false;
 	}
 
 	/*
@@ -179,6 +330,7 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 	if (!CameraComponent->CameraDataThisFrame.ArmLocation.CheckValid())
 	{
 		CameraComponent->CameraDataThisFrame.ArmLocation.Set(DesiredLoc);
+		bHasSpringLocationTarget = false;
 		return;
 	}
 
@@ -188,8 +340,18 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 			                                    ? PlayerCameraManager->GetArmCenterLagRecoverSpeed()
 			                                    : DefaultCameraLagRecoverSpeed;
 
-		DesiredLoc = FMath::VInterpTo(
-			CameraComponent->CameraDataThisFrame.ArmLocation.Data, DesiredLoc, DeltaTime, CameraLagRecoverSpeed);
+		const bool bSpringLag = CVarSpringLag.GetValueOnGameThread();
+		if (bSpringLag)
+		{
+			DesiredLoc = UpdateSpringLocationLag(
+				CameraComponent->CameraDataThisFrame.ArmLocation.Data, DesiredLoc, DeltaTime, CameraLagRecoverSpeed);
+		}
+		else
+		{
+			DesiredLoc = FMath::VInterpTo(
+				CameraComponent->CameraDataThisFrame.ArmLocation.Data, DesiredLoc, DeltaTime, CameraLagRecoverSpeed);
+			bHasSpringLocationTarget = false;
+		}
 		const float CameraLagMaxDistanceXY = PlayerCameraManager != nullptr
 			                                     ? PlayerCameraManager->GetArmCenterLagMaxDistanceXY()
 			                                     : DefaultCameraLagMaxDistance;
@@ -222,6 +384,23 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 			{
 				// DesiredLoc = OutCameraLoc + FromOrigin.GetClampedToMaxSize(CameraLagMaxDistanceXY);
 				DesiredLoc = OutCameraLoc + RealCameraLag;
+
+				// 撞到距离限制后去掉弹簧继续远离目标的速度，避免限制解除后反弹
+				if (bSpringLag)
+				{
+					const FVector OutwardXY = RealCameraLag.GetSafeNormal2D();
+					const float OutwardSpeedXY = FVector::DotProduct(SpringLocationVelocity, OutwardXY);
+					if (OutwardSpeedXY > 0.f)
+					{
+						SpringLocationVelocity -= OutwardXY * OutwardSpeedXY;
+					}
+
+					if (SpringLocationVelocity.Z * RealCameraLag.Z > 0.f &&
+						FMath::Abs(RealCameraLag.Z) >= CameraLagMaxDistanceZ)
+					{
+						SpringLocationVelocity.Z = 0.f;
+					}
+				}
 			}
 		}
 
@@ -245,6 +424,10 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 		}
 #endif
 	}
+	else
+	{
+		bHasSpringLocationTarget = false;
+	}
 
 	CameraComponent->CameraDataThisFrame.ArmLocation.Set(DesiredLoc);
 	OutCameraLoc = DesiredLoc;
@@ -253,6 +436,50 @@ void UJoyCameraMode_ThirdPerson::UpdateDesiredViewPose(
 	OutCameraRot = DesiredRot;
 }
 
+FVector UJoyCameraMode_ThirdPerson::UpdateSpringLocationLag(
+	const FVector& CurrentLoc, const FVector& TargetLoc, float DeltaTime, float RecoverSpeed)
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	if (!bHasSpringLocationTarget)
+	{
+		SpringLocationVelocity = FVector::ZeroVector;
+		LastSpringLocationTarget = TargetLoc;
+		bHasSpringLocationTarget = true;
+	}
+
+	FVector NewLoc = CurrentLoc;
+	FJoyCameraSpring::Update(NewLoc, SpringLocationVelocity, LastSpringLocationTarget, TargetLoc,
+		RecoverSpeed * SpringLagFrequencyScale, DeltaTime);
+	LastSpringLocationTarget = TargetLoc;
+	return NewLoc;
+}
+
+FRotator UJoyCameraMode_ThirdPerson::UpdateSpringRotationLag(
+	const FRotator& CurrentRot, const FRotator& TargetRot, float DeltaTime, float RecoverSpeed)
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	if (!bHasSpringRotationTarget)
+	{
+		SpringRotationVelocity = FVector::ZeroVector;
+		LastSpringRotationTarget = TargetRot;
+		bHasSpringRotationTarget = true;
+	}
+
+	// 在相对本帧目标的最短角度差上求解，避免跨越 ±180° 时绕远路
+	const FRotator CurrentOffset = (CurrentRot - TargetRot).GetNormalized();
+	const FRotator PrevTargetOffset = (LastSpringRotationTarget - TargetRot).GetNormalized();
+
+	FVector Offset(CurrentOffset.Pitch, CurrentOffset.Yaw, CurrentOffset.Roll);
+	FJoyCameraSpring::Update(Offset, SpringRotationVelocity,
+		FVector(PrevTargetOffset.Pitch, PrevTargetOffset.Yaw, PrevTargetOffset.Roll), FVector::ZeroVector,
+		RecoverSpeed * SpringLagFrequencyScale, DeltaTime);
+	LastSpringRotationTarget = TargetRot;
+
+	return (TargetRot + FRotator(Offset.X, Offset.Y, Offset.Z)).GetNormalized();
+}
+
 void UJoyCameraMode_ThirdPerson::UpdateForTarget(float DeltaTime)
 {
 	if (const ACharacter* TargetCharacter = Cast<ACharacter>(GetTargetActor()))
@@ -273,6 +500,8 @@ void UJoyCameraMode_ThirdPerson::UpdateForTarget(float DeltaTime)
 
 void UJoyCameraMode_ThirdPerson::UpdatePreventPenetration(float DeltaTime)
 {
+	JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdatePreventPenetration);
+
 	AActor* TargetActor = GetTargetActor();
 
 	APawn* TargetPawn = Cast<APawn>(TargetActor);
@@ -349,6 +578,14 @@ void UJoyCameraMode_ThirdPerson::OnActivation()
 	// 初始化基本参数
 	InitParams();
 	AimLineToDesiredPosBlockedPct = 1.0f;
+	ResetPenetrationSweeps();
+	PenetrationBlockers.Reset();
+	bHasLastSchedulePose = false;
+	bHasSpringLocationTarget = false;
+	bHasSpringRotationTarget = false;
+
+	// 重建 Feeler 以清空上次激活时的检测调度
+	UpdateFeelers();
 }
 
 void UJoyCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc,
@@ -363,15 +600,90 @@ void UJoyCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& Vi
 
 	FVector BaseRay = CameraLoc - SafeLoc;
 
-	const FVector BaseRayLocalUp = View.Rotation.RotateVector(FVector(0.0, 0.0, 1.0));
-	const FVector BaseRayLocalRight = View.Rotation.RotateVector(FVector(0.0, 1.0, 0.0));
-
-	UpdateFeelers();
+	SchedulePenetrationFeelers(SafeLoc, CameraLoc, DeltaTime);
 
 	float DistBlockedPctThisFrame = 1.f;
 
 	int32 const NumRaysToShoot =
 		bSingleRayOnly ? FMath::Min(1, PenetrationAvoidanceFeelers.Num()) : PenetrationAvoidanceFeelers.Num();
+
+	if (CVarAsyncPenetration.GetValueOnGameThread())
+	{
+		// 重置插值或上一帧的结果不可用时同步检测一次，避免这一帧穿透
+		bool bSweptThisFrame = false;
+		if (bResetInterpolation ||
+			!ConsumePenetrationSweeps(ViewTarget, BaseRay, HardBlockedPct, SoftBlockedPct, DistBlockedPctThisFrame))
+		{
+			ResetPenetrationSweeps();
+			HardBlockedPct = DistBlockedPct;
+			SoftBlockedPct = DistBlockedPct;
+			DistBlockedPctThisFrame = 1.f;
+			SweepPenetrationFeelers(ViewTarget, SafeLoc, BaseRay, NumRaysToShoot, HardBlockedPct, SoftBlockedPct,
+				DistBlockedPctThisFrame);
+			bSweptThisFrame = true;
+		}
+
+		SubmitPenetrationSweeps(ViewTarget, SafeLoc, CameraLoc, NumRaysToShoot, bSweptThisFrame);
+	}
+	else
+	{
+		ResetPenetrationSweeps();
+		SweepPenetrationFeelers(ViewTarget, SafeLoc, BaseRay, NumRaysToShoot, HardBlockedPct, SoftBlockedPct,
+			DistBlockedPctThisFrame);
+	}
+
+	if (bResetInterpolation)
+	{
+		DistBlockedPct = DistBlockedPctThisFrame;
+	}
+	else if (DistBlockedPct < DistBlockedPctThisFrame)
+	{
+		// interpolate smoothly out
+		if (PenetrationBlendOutTime > DeltaTime)
+		{
+			DistBlockedPct =
+				DistBlockedPct + DeltaTime / PenetrationBlendOutTime * (DistBlockedPctThisFrame - DistBlockedPct);
+		}
+		else
+		{
+			DistBlockedPct = DistBlockedPctThisFrame;
+		}
+	}
+	else
+	{
+		if (DistBlockedPct > HardBlockedPct)
+		{
+			DistBlockedPct = HardBlockedPct;
+		}
+		else if (DistBlockedPct > SoftBlockedPct)
+		{
+			// interpolate smoothly in
+			if (PenetrationBlendInTime > DeltaTime)
+			{
+				DistBlockedPct =
+					DistBlockedPct - DeltaTime / PenetrationBlendInTime * (DistBlockedPct - SoftBlockedPct);
+			}
+			else
+			{
+				DistBlockedPct = SoftBlockedPct;
+			}
+		}
+	}
+
+	DistBlockedPct = FMath::Clamp<float>(DistBlockedPct, 0.f, 1.f);
+	if (DistBlockedPct < (1.f - ZERO_ANIMWEIGHT_THRESH))
+	{
+		CameraLoc = SafeLoc + (CameraLoc - SafeLoc) * DistBlockedPct;
+	}
+}
+
+void UJoyCameraMode_ThirdPerson::SweepPenetrationFeelers(AActor const& ViewTarget, FVector const& SafeLoc,
+	FVector const& BaseRay, int32 NumRaysToShoot, float& HardBlockedPct, float& SoftBlockedPct,
+	float& DistBlockedPctThisFrame)
+{
+	const FVector BaseRayLocalUp = View.Rotation.RotateVector(FVector(0.0, 0.0, 1.0));
+	const FVector BaseRayLocalRight = View.Rotation.RotateVector(FVector(0.0, 1.0, 0.0));
+
 	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPen), false, nullptr /*PlayerCamera*/);
 
 	SphereParams.AddIgnoredActor(&ViewTarget);
@@ -401,8 +713,14 @@ void UJoyCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& Vi
 
 			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
 			FHitResult Hit;
-			const bool bHit = World->SweepSingleByChannel(
-				Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+			const bool bConfirmedByCache = TraceCachedBlocker(RayIdx, SafeLoc, RayTarget, SphereShape, Hit);
+			bool bHit = bConfirmedByCache;
+			if (!bConfirmedByCache)
+			{
+				bHit = World->SweepSingleByChannel(
+					Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				JOY_CAMERA_INC_DWORD_STAT(STAT_JoyCamera_PenetrationSweeps);
+			}
 #if ENABLE_DRAW_DEBUG
 			if (PlayerCameraManager != nullptr && PlayerCameraManager->bDrawDebugPenetrationMarkers)
 			{
@@ -412,67 +730,28 @@ void UJoyCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& Vi
 			}
 #endif	  // ENABLE_DRAW_DEBUG
 
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+			Feeler.FramesUntilNextTrace = Feeler.ScheduledTraceInterval;
 
-			AActor* HitActor = Hit.GetActor();
-			if (bHit && HitActor)
+			float NewBlockPct = 1.f;
+			bool bIgnoreActor = false;
+			if (bHit &&
+				EvaluatePenetrationHit(
+					ViewTarget, Hit, SafeLoc, (RayTarget - SafeLoc).Size(), NewBlockPct, bIgnoreActor))
 			{
-				bool bIgnoreHit = false;
+				DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
 
-				if (HitActor->ActorHasTag(JoyCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+				// This feeler got a hit, so do another trace next frame
+				Feeler.FramesUntilNextTrace = 0;
+				Feeler.FramesSinceLastHit = 0;
+				UpdateBlockerCache(RayIdx, &Hit, bConfirmedByCache);
+			}
+			else
+			{
+				UpdateBlockerCache(RayIdx, nullptr, bConfirmedByCache);
+				if (bIgnoreActor)
 				{
-					bIgnoreHit = true;
-					SphereParams.AddIgnoredActor(HitActor);
-				}
-
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
-				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
-				}
-
-				if (!bIgnoreHit)
-				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
-
-					// Recompute blocked pct taking into account pushout distance.
-					NewBlockPct =
-						((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
-
-#if ENABLE_DRAW_DEBUG
-					if (PlayerCameraManager != nullptr && PlayerCameraManager->bDrawDebugPenetrationMarkers)
-					{
-						DrawDebugSphere(World, Hit.Location, 10, 8, FColor::Orange);
-						DrawDebugLine(World, SafeLoc, Hit.Location, FColor::White);
-					}
-#endif
-
-					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
-
-					// This feeler got a hit, so do another trace next frame
-					Feeler.FramesUntilNextTrace = 0;
-
-#if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
+					SphereParams.AddIgnoredActor(Hit.GetActor());
+					IgnoredPenetrationActors.AddUnique(Hit.GetActor());
 				}
 			}
 
@@ -492,50 +771,377 @@ void UJoyCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& Vi
 			--Feeler.FramesUntilNextTrace;
 		}
 	}
+}
 
-	if (bResetInterpolation)
+bool UJoyCameraMode_ThirdPerson::ConsumePenetrationSweeps(AActor const& ViewTarget, FVector const& BaseRay,
+	float& HardBlockedPct, float& SoftBlockedPct, float& DistBlockedPctThisFrame)
+{
+	// 忽略列表只保留本帧检测结果中的 Actor，避免某一帧忽略的 CameraBlockingVolume 之后一直被忽略
+	IgnoredPenetrationActors.Reset();
+
+	UWorld* World = GetWorld();
+	if (World == nullptr || PendingPenetrationSweeps.IsEmpty())
 	{
-		DistBlockedPct = DistBlockedPctThisFrame;
+		return false;
 	}
-	else if (DistBlockedPct < DistBlockedPctThisFrame)
+
+	TArray<FTraceDatum, TInlineAllocator<8>> TraceData;
+	TraceData.SetNum(PendingPenetrationSweeps.Num());
+	for (int32 Index = 0; Index < PendingPenetrationSweeps.Num(); ++Index)
 	{
-		// interpolate smoothly out
-		if (PenetrationBlendOutTime > DeltaTime)
-		{
-			DistBlockedPct =
-				DistBlockedPct + DeltaTime / PenetrationBlendOutTime * (DistBlockedPctThisFrame - DistBlockedPct);
-		}
-		else
+		const FJoyPenetrationSweepRequest& Request = PendingPenetrationSweeps[Index];
+		if (!Request.bConfirmedByCache && !World->QueryTraceData(Request.TraceHandle, TraceData[Index]))
 		{
-			DistBlockedPct = DistBlockedPctThisFrame;
+			return false;
 		}
 	}
-	else
+
+	// 检测基于预测的位姿，命中点按到起点的距离换算为本帧射线上的遮挡比例
+	const float RayLength = BaseRay.Size();
+	for (int32 Index = 0; Index < PendingPenetrationSweeps.Num(); ++Index)
 	{
-		if (DistBlockedPct > HardBlockedPct)
+		const FJoyPenetrationSweepRequest& Request = PendingPenetrationSweeps[Index];
+		if (!PenetrationAvoidanceFeelers.IsValidIndex(Request.FeelerIndex))
 		{
-			DistBlockedPct = HardBlockedPct;
+			continue;
 		}
-		else if (DistBlockedPct > SoftBlockedPct)
+
+		FJoyPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[Request.FeelerIndex];
+
+		const FTraceDatum& TraceDatum = TraceData[Index];
+		const FHitResult* Hit = Request.bConfirmedByCache ? &Request.CachedHit
+														  : TraceDatum.OutHits.FindByPredicate(
+																[](const FHitResult& Result)
+																{
+																	return Result.bBlockingHit;
+																});
+
+#if ENABLE_DRAW_DEBUG
+		if (!Request.bConfirmedByCache && PlayerCameraManager != nullptr &&
+			PlayerCameraManager->bDrawDebugPenetrationMarkers)
 		{
-			// interpolate smoothly in
-			if (PenetrationBlendInTime > DeltaTime)
+			DrawDebugSphere(World, TraceDatum.Start, Feeler.Extent, 8, FColor::Red);
+			DrawDebugSphere(World, Hit != nullptr ? Hit->Location : TraceDatum.End, 10, 8, FColor::Purple);
+			DrawDebugLine(World, TraceDatum.Start, Hit != nullptr ? Hit->Location : TraceDatum.End, FColor::Red);
+		}
+#endif	  // ENABLE_DRAW_DEBUG
+
+		float NewBlockPct = 1.f;
+		bool bIgnoreActor = false;
+		if (Hit != nullptr &&
+			EvaluatePenetrationHit(ViewTarget, *Hit, Request.Start, RayLength, NewBlockPct, bIgnoreActor))
+		{
+			DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+
+			// This feeler got a hit, so do another trace next frame
+			Feeler.FramesUntilNextTrace = 0;
+			Feeler.FramesSinceLastHit = 0;
+			UpdateBlockerCache(Request.FeelerIndex, Hit, Request.bConfirmedByCache);
+		}
+		else
+		{
+			UpdateBlockerCache(Request.FeelerIndex, nullptr, Request.bConfirmedByCache);
+			if (bIgnoreActor)
 			{
-				DistBlockedPct =
-					DistBlockedPct - DeltaTime / PenetrationBlendInTime * (DistBlockedPct - SoftBlockedPct);
+				IgnoredPenetrationActors.AddUnique(Hit->GetActor());
 			}
-			else
+		}
+
+		if (Request.FeelerIndex == 0)
+		{
+			HardBlockedPct = DistBlockedPctThisFrame;
+		}
+		else
+		{
+			SoftBlockedPct = DistBlockedPctThisFrame;
+		}
+	}
+
+	PendingPenetrationSweeps.Reset();
+	return true;
+}
+
+void UJoyCameraMode_ThirdPerson::SubmitPenetrationSweeps(AActor const& ViewTarget, FVector const& SafeLoc,
+	FVector const& CameraLoc, int32 NumRaysToShoot, bool bSweptThisFrame)
+{
+	PendingPenetrationSweeps.Reset();
+
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	// 结果下一帧才使用，按上一帧到这一帧的变化外推延迟后的位姿
+	FVector PredictedSafeLoc = SafeLoc;
+	FVector PredictedCameraLoc = CameraLoc;
+	if (bHasLastPenetrationPose)
+	{
+		PredictedSafeLoc += SafeLoc - LastPenetrationSafeLoc;
+		PredictedCameraLoc += CameraLoc - LastPenetrationCameraLoc;
+	}
+
+	LastPenetrationSafeLoc = SafeLoc;
+	LastPenetrationCameraLoc = CameraLoc;
+	bHasLastPenetrationPose = true;
+
+	const FVector BaseRay = PredictedCameraLoc - PredictedSafeLoc;
+	const FVector BaseRayLocalUp = View.Rotation.RotateVector(FVector(0.0, 0.0, 1.0));
+	const FVector BaseRayLocalRight = View.Rotation.RotateVector(FVector(0.0, 1.0, 0.0));
+
+	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPen), false, nullptr /*PlayerCamera*/);
+	SphereParams.AddIgnoredActor(&ViewTarget);
+
+	IgnoredPenetrationActors.RemoveAllSwap(
+		[](const TWeakObjectPtr<const AActor>& Actor)
+		{
+			return !Actor.IsValid();
+		});
+	for (const TWeakObjectPtr<const AActor>& IgnoredActor : IgnoredPenetrationActors)
+	{
+		SphereParams.AddIgnoredActor(IgnoredActor.Get());
+	}
+
+	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+	{
+		FJoyPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+		if (Feeler.FramesUntilNextTrace > 0)
+		{
+			// 同步检测已在本帧推进过间隔
+			if (!bSweptThisFrame)
 			{
-				DistBlockedPct = SoftBlockedPct;
+				--Feeler.FramesUntilNextTrace;
 			}
+			continue;
 		}
+
+		FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
+		RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
+
+		const FCollisionShape SphereShape = FCollisionShape::MakeSphere(Feeler.Extent);
+
+		FJoyPenetrationSweepRequest& Request = PendingPenetrationSweeps.AddDefaulted_GetRef();
+		Request.FeelerIndex = RayIdx;
+		Request.Start = PredictedSafeLoc;
+		Request.bConfirmedByCache = TraceCachedBlocker(
+			RayIdx, PredictedSafeLoc, PredictedSafeLoc + RotatedRay, SphereShape, Request.CachedHit);
+		if (!Request.bConfirmedByCache)
+		{
+			Request.TraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, PredictedSafeLoc,
+				PredictedSafeLoc + RotatedRay, FQuat::Identity, ECC_Camera, SphereShape, SphereParams);
+			JOY_CAMERA_INC_DWORD_STAT(STAT_JoyCamera_PenetrationSweeps);
+		}
+
+		Feeler.FramesUntilNextTrace = Feeler.ScheduledTraceInterval;
 	}
+}
 
-	DistBlockedPct = FMath::Clamp<float>(DistBlockedPct, 0.f, 1.f);
-	if (DistBlockedPct < (1.f - ZERO_ANIMWEIGHT_THRESH))
+void UJoyCameraMode_ThirdPerson::ResetPenetrationSweeps()
+{
+	PendingPenetrationSweeps.Reset();
+	IgnoredPenetrationActors.Reset();
+	bHasLastPenetrationPose = false;
+}
+
+void UJoyCameraMode_ThirdPerson::SchedulePenetrationFeelers(
+	FVector const& SafeLoc, FVector const& CameraLoc, float DeltaTime)
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	const FQuat Rotation = View.Rotation.Quaternion();
+
+	// 0 表示相机臂静止，1 表示快速转动或移动
+	float MotionAlpha = 1.f;
+	if (bHasLastSchedulePose && DeltaTime > UE_KINDA_SMALL_NUMBER)
 	{
-		CameraLoc = SafeLoc + (CameraLoc - SafeLoc) * DistBlockedPct;
+		const float AngularSpeed =
+			FMath::RadiansToDegrees(Rotation.AngularDistance(LastScheduleRotation)) / DeltaTime;
+		const float LinearSpeed = FVector::Dist(CameraLoc, LastScheduleCameraLoc) / DeltaTime;
+		MotionAlpha = FMath::Clamp(
+			FMath::Max(AngularSpeed / FeelerFastAngularSpeed, LinearSpeed / FeelerFastLinearSpeed), 0.f, 1.f);
+	}
+
+	LastScheduleRotation = Rotation;
+	LastScheduleCameraLoc = CameraLoc;
+	bHasLastSchedulePose = true;
+
+	const bool bAdaptive = CVarAdaptiveFeelers.GetValueOnGameThread();
+
+	// 中等速度时使用配置的间隔，静止时放宽，快速运动时每帧检测
+	const float IntervalScale = FMath::Lerp(FeelerIdleIntervalScale, 0.f, MotionAlpha);
+	for (FJoyPenetrationAvoidanceFeeler& Feeler : PenetrationAvoidanceFeelers)
+	{
+		if (Feeler.FramesSinceLastHit < MAX_int32)
+		{
+			++Feeler.FramesSinceLastHit;
+		}
+
+		if (!bAdaptive)
+		{
+			Feeler.ScheduledTraceInterval = Feeler.TraceInterval;
+		}
+		else if (Feeler.FramesSinceLastHit <= FeelerRecentHitFrames)
+		{
+			Feeler.ScheduledTraceInterval = 0;
+		}
+		else
+		{
+			Feeler.ScheduledTraceInterval = FMath::RoundToInt32(Feeler.TraceInterval * IntervalScale);
+		}
+
+		// 间隔变短时不必等到原来的检测时间
+		Feeler.FramesUntilNextTrace = FMath::Min(Feeler.FramesUntilNextTrace, Feeler.ScheduledTraceInterval);
+	}
+}
+
+bool UJoyCameraMode_ThirdPerson::TraceCachedBlocker(int32 FeelerIndex, FVector const& Start, FVector const& End,
+	const FCollisionShape& CollisionShape, FHitResult& OutHit)
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	if (!CVarPenetrationBlockerCache.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	const int32 BlockerIndex = PenetrationBlockers.IndexOfByPredicate(
+		[FeelerIndex](const FJoyPenetrationBlocker& Blocker)
+		{
+			return Blocker.FeelerIndex == FeelerIndex;
+		});
+	if (BlockerIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FJoyPenetrationBlocker& Blocker = PenetrationBlockers[BlockerIndex];
+	UPrimitiveComponent* Component = Blocker.Component.Get();
+
+	// 图元移动过或已连续确认多次时重新检测整个场景
+	if (Component == nullptr || Blocker.NumConfirmations >= MaxBlockerConfirmations ||
+		!Component->Bounds.Origin.Equals(Blocker.Bounds.Origin) ||
+		!Component->Bounds.BoxExtent.Equals(Blocker.Bounds.BoxExtent))
+	{
+		PenetrationBlockers.RemoveAtSwap(BlockerIndex);
+		return false;
+	}
+
+	// 先用包围盒快速排除
+	const FBox BlockerBox = Blocker.Bounds.GetBox().ExpandBy(CollisionShape.GetSphereRadius());
+	if (!FMath::LineBoxIntersection(BlockerBox, Start, End, End - Start) ||
+		!Component->SweepComponent(OutHit, Start, End, FQuat::Identity, CollisionShape))
+	{
+		PenetrationBlockers.RemoveAtSwap(BlockerIndex);
+		return false;
+	}
+
+	OutHit.bBlockingHit = true;
+	OutHit.HitObjectHandle = FActorInstanceHandle(Component->GetOwner());
+	++Blocker.NumConfirmations;
+	JOY_CAMERA_INC_DWORD_STAT(STAT_JoyCamera_PenetrationCachedBlocks);
+	return true;
+}
+
+void UJoyCameraMode_ThirdPerson::UpdateBlockerCache(
+	int32 FeelerIndex, const FHitResult* BlockingHit, bool bConfirmedByCache)
+{
+	using namespace JoyCameraMode_ThirdPerson_Statics;
+
+	const int32 BlockerIndex = PenetrationBlockers.IndexOfByPredicate(
+		[FeelerIndex](const FJoyPenetrationBlocker& Blocker)
+		{
+			return Blocker.FeelerIndex == FeelerIndex;
+		});
+
+	UPrimitiveComponent* Component = BlockingHit != nullptr ? BlockingHit->GetComponent() : nullptr;
+	if (Component == nullptr)
+	{
+		if (BlockerIndex != INDEX_NONE)
+		{
+			PenetrationBlockers.RemoveAtSwap(BlockerIndex);
+		}
+		return;
+	}
+
+	if (bConfirmedByCache)
+	{
+		return;
+	}
+
+	FJoyPenetrationBlocker* Blocker = nullptr;
+	if (BlockerIndex != INDEX_NONE)
+	{
+		Blocker = &PenetrationBlockers[BlockerIndex];
+	}
+	else
+	{
+		if (PenetrationBlockers.Num() >= MaxPenetrationBlockers)
+		{
+			PenetrationBlockers.RemoveAt(0);
+		}
+
+		Blocker = &PenetrationBlockers.AddDefaulted_GetRef();
+		Blocker->FeelerIndex = FeelerIndex;
+	}
+
+	Blocker->Component = Component;
+	Blocker->Bounds = Component->Bounds;
+	Blocker->NumConfirmations = 0;
+}
+
+bool UJoyCameraMode_ThirdPerson::EvaluatePenetrationHit(AActor const& ViewTarget, const FHitResult& Hit,
+	FVector const& SafeLoc, float RayLength, float& OutBlockedPct, bool& bOutIgnoreActor)
+{
+	bOutIgnoreActor = false;
+
+	AActor* HitActor = Hit.GetActor();
+	if (HitActor == nullptr)
+	{
+		return false;
+	}
+
+	if (HitActor->ActorHasTag(JoyCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+	{
+		bOutIgnoreActor = true;
+		return false;
 	}
+
+	// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+	if (HitActor->IsA<ACameraBlockingVolume>())
+	{
+		const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+		const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+		const FVector HitOffset = Hit.Location - ViewTargetLocation;
+		const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+		const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+		if (DotHitDirection > 0.0f)
+		{
+			// Ignore this CameraBlockingVolume on the remaining sweeps.
+			bOutIgnoreActor = true;
+			return false;
+		}
+
+#if ENABLE_DRAW_DEBUG
+		DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+	}
+
+	// Recompute blocked pct taking into account pushout distance.
+	OutBlockedPct = RayLength > UE_KINDA_SMALL_NUMBER
+						? ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / RayLength
+						: 0.f;
+
+#if ENABLE_DRAW_DEBUG
+	if (PlayerCameraManager != nullptr && PlayerCameraManager->bDrawDebugPenetrationMarkers)
+	{
+		DrawDebugSphere(GetWorld(), Hit.Location, 10, 8, FColor::Orange);
+		DrawDebugLine(GetWorld(), SafeLoc, Hit.Location, FColor::White);
+	}
+
+	DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+
+	return true;
 }
 
 void UJoyCameraMode_ThirdPerson::SetTargetCrouchOffset(FVector NewTargetOffset)
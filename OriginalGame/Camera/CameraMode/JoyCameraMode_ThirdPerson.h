@@ -1,10 +1,75 @@
 ﻿#pragma once
 #include "JoyCameraMode.h"
+#include "WorldCollision.h"
 
 #include "JoyCameraMode_ThirdPerson.generated.h"
 
+class UPrimitiveComponent;
 struct FJoyPenetrationAvoidanceFeeler;
 
+/**
+ * 第三人称相机一次完整求值所依赖的输入
+ * 相机臂中心位置与旋转、臂长、Fov 已包含配置、淡入淡出与 Modifier 的结果
+ */
+struct FJoyThirdPersonViewInputs
+{
+	FVector TargetLocation{ForceInit};
+
+	FQuat TargetRotation{ForceInit};
+
+	FVector PivotLocation{ForceInit};
+
+	FRotator PivotRotation{ForceInit};
+
+	float ArmLength{0.f};
+
+	float FieldOfView{0.f};
+
+	float MinArmLength{0.f};
+
+	float MaxArmLength{0.f};
+
+	bool bLocationLag{false};
+
+	bool bRotationLag{false};
+
+	bool Equals(const FJoyThirdPersonViewInputs& Other) const;
+};
+
+/**
+ * 已提交、下一帧取回结果的异步穿透检测
+ */
+struct FJoyPenetrationSweepRequest
+{
+	FTraceHandle TraceHandle{};
+
+	int32 FeelerIndex{INDEX_NONE};
+
+	// 提交时预测的检测起点
+	FVector Start{ForceInit};
+
+	// 由遮挡缓存确认仍被遮挡，没有提交检测
+	bool bConfirmedByCache{false};
+
+	FHitResult CachedHit{};
+};
+
+/**
+ * 最近挡住某个 Feeler 的图元
+ * 图元包围盒没有变化时，先只对该图元做一次检测确认仍然遮挡，省去整个场景的检测
+ */
+struct FJoyPenetrationBlocker
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component{};
+
+	FBoxSphereBounds Bounds{ForceInit};
+
+	int32 FeelerIndex{INDEX_NONE};
+
+	// 连续由缓存确认的次数，达到上限后重新检测整个场景以发现更近的遮挡
+	int32 NumConfirmations{0};
+};
+
 /**
  * UJoyCameraMode_ThirdPerson
  *
@@ -32,14 +97,53 @@ protected:
 
 	virtual void UpdateView(float DeltaTime) override;
 
+	virtual bool TryReuseView(float DeltaTime) override;
+
+	void GatherViewInputs(FJoyThirdPersonViewInputs& OutInputs) const;
+
 	virtual void UpdateDesiredViewPose(
 		float DeltaTime, const FVector& ArmOffset, FVector& OutCameraLoc, FRotator& OutCameraRot);
 
+	// 临界阻尼弹簧延迟，结果与更新频率无关
+	FVector UpdateSpringLocationLag(
+		const FVector& CurrentLoc, const FVector& TargetLoc, float DeltaTime, float RecoverSpeed);
+
+	FRotator UpdateSpringRotationLag(
+		const FRotator& CurrentRot, const FRotator& TargetRot, float DeltaTime, float RecoverSpeed);
+
 	void UpdateForTarget(float DeltaTime);
 	void UpdatePreventPenetration(float DeltaTime);
 	virtual void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc,
 		float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
 
+	// 同步检测本帧到期的 Feeler
+	void SweepPenetrationFeelers(AActor const& ViewTarget, FVector const& SafeLoc, FVector const& BaseRay,
+		int32 NumRaysToShoot, float& HardBlockedPct, float& SoftBlockedPct, float& DistBlockedPctThisFrame);
+
+	// 取回上一帧提交的异步检测结果，结果未就绪时返回 false
+	bool ConsumePenetrationSweeps(AActor const& ViewTarget, FVector const& BaseRay, float& HardBlockedPct,
+		float& SoftBlockedPct, float& DistBlockedPctThisFrame);
+
+	// 按预测的下一帧位姿一次性提交所有到期 Feeler 的异步检测，本帧已同步检测时不再推进检测间隔
+	void SubmitPenetrationSweeps(AActor const& ViewTarget, FVector const& SafeLoc, FVector const& CameraLoc,
+		int32 NumRaysToShoot, bool bSweptThisFrame);
+
+	void ResetPenetrationSweeps();
+
+	// 根据相机臂的角速度、线速度与最近命中调整每个 Feeler 的检测间隔
+	void SchedulePenetrationFeelers(FVector const& SafeLoc, FVector const& CameraLoc, float DeltaTime);
+
+	// 只对缓存的遮挡图元检测，仍然遮挡时返回 true
+	bool TraceCachedBlocker(int32 FeelerIndex, FVector const& Start, FVector const& End,
+		const FCollisionShape& CollisionShape, FHitResult& OutHit);
+
+	// 记录 Feeler 的检测结果，BlockingHit 为空表示没有被遮挡
+	void UpdateBlockerCache(int32 FeelerIndex, const FHitResult* BlockingHit, bool bConfirmedByCache);
+
+	// 计算命中点对应的遮挡比例，返回 false 表示忽略该命中，bOutIgnoreActor 表示后续检测应忽略该 Actor
+	bool EvaluatePenetrationHit(AActor const& ViewTarget, const FHitResult& Hit, FVector const& SafeLoc,
+		float RayLength, float& OutBlockedPct, bool& bOutIgnoreActor);
+
 	virtual void OnActivation() override;
 
 	virtual void OnDeactivation();
@@ -119,4 +223,52 @@ private:
 
 	UPROPERTY()
 	float DefaultCameraLagRecoverSpeed = 1;
+
+	// 上次完整求值时的输入
+	FJoyThirdPersonViewInputs LastViewInputs{};
+
+	// 上次完整求值后延迟与穿透插值都已收敛，输入不变时相机臂位姿也不会变化
+	bool bViewConverged = false;
+
+	// 上次完整求值时穿透检测前的相机位置，复用时从这里重新做穿透检测
+	FVector LastDesiredViewLocation = FVector::ZeroVector;
+
+	// 连续复用的帧数，超过上限后强制完整求值一次
+	int32 NumReusedFrames = 0;
+
+	// 等待下一帧取回结果的异步穿透检测，按 Feeler 顺序排列
+	TArray<FJoyPenetrationSweepRequest> PendingPenetrationSweeps;
+
+	// 本帧检测结果中可忽略的 Actor，下一次提交的异步检测忽略它们，每帧重新收集
+	TArray<TWeakObjectPtr<const AActor>> IgnoredPenetrationActors;
+
+	// 上一次穿透检测时的安全点与相机位置，用于预测下一帧的位姿
+	FVector LastPenetrationSafeLoc = FVector::ZeroVector;
+
+	FVector LastPenetrationCameraLoc = FVector::ZeroVector;
+
+	bool bHasLastPenetrationPose = false;
+
+	// 最近挡住各 Feeler 的图元
+	TArray<FJoyPenetrationBlocker, TInlineAllocator<8>> PenetrationBlockers;
+
+	// 上一次调度 Feeler 时的相机位置与朝向
+	FVector LastScheduleCameraLoc = FVector::ZeroVector;
+
+	FQuat LastScheduleRotation = FQuat::Identity;
+
+	bool bHasLastSchedulePose = false;
+
+	// 弹簧延迟的速度与上一帧的目标，旋转速度按 (Pitch, Yaw, Roll) 存储
+	FVector SpringLocationVelocity = FVector::ZeroVector;
+
+	FVector LastSpringLocationTarget = FVector::ZeroVector;
+
+	bool bHasSpringLocationTarget = false;
+
+	FVector SpringRotationVelocity = FVector::ZeroVector;
+
+	FRotator LastSpringRotationTarget = FRotator::ZeroRotator;
+
+	bool bHasSpringRotationTarget = false;
 };
@@ -5,30 +5,12 @@
 #include "JoyCameraInputController.h"
 #include "JoyCameraMeta.h"
 #include "JoyLogChannels.h"
+#include "Camera/JoyCameraData.h"
+#include "Camera/JoyCameraStats.h"
 #include "Camera/JoyPlayerCameraManager.h"
 #include "Settings/JoyGlobalGameSettings.h"
 #include "Utils/JoyCameraBlueprintLibrary.h"
 
-UCameraConfig::UCameraConfig()
-{
-}
-
-void UCameraConfig::LoadProto(const FJoyCameraConfigTable& Config)
-{
-	Description = Config.Description;
-	Type = Config.Type;
-	FadeInTime = Config.FadeInTime;
-	FadeOutTime = Config.FadeOutTime;
-	bIgnoreTimeDilation = Config.bIgnoreTimeDilation;
-	bOverrideCameraInput = Config.bOverrideCameraInput;
-	bArmCenterLagEnable = Config.bArmCenterLagEnable;
-	Priority = Config.Priority;
-	bFadeArmPitch = false;
-	FadeTargetArmPitch = 0.f;
-	BasicConfig = Config.Basic;
-	InputConfig = Config.Input;
-}
-
 UJoyCameraConfigController::UJoyCameraConfigController()
 {
 }
@@ -54,23 +36,37 @@ void UJoyCameraConfigController::UpdateInternal(float DeltaSeconds)
 	UpdateConfig();
 }
 
-UCameraConfig* LoadProtoConfig(const FJoyCameraConfigTable& ProtoConfig)
-{
-	UCameraConfig* CameraConfig = NewObject<UCameraConfig>();
-	CameraConfig->LoadProto(ProtoConfig);
-	return CameraConfig;
-}
-
 void UJoyCameraConfigController::LoadConfig()
 {
-	TMap<FName, FJoyCameraConfigTable> ConfigMap;
-	UJoyCameraBlueprintLibrary::GetCameraConfigMap(this, ConfigMap);
+	UJoyCameraData* CameraDataConfig = UJoyGlobalGameSettings::GetCameraDataConfig(this);
+	if (CameraDataConfig == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraConfigController::LoadConfig(): 找不到镜头数据配置"));
+		return;
+	}
+
+	if (!CameraDataConfig->OnConfigRegistryChanged.IsBoundToObject(this))
+	{
+		CameraDataConfig->OnConfigRegistryChanged.AddUObject(this, &UJoyCameraConfigController::LoadConfig);
+	}
+
+	FJoyCameraConfigRegistryPtr NewConfigRegistry = CameraDataConfig->GetConfigRegistry();
+	if (!NewConfigRegistry.IsValid())
+	{
+		return;
+	}
+
+	// 热重载时整体重建
+	ConfigRegistry = MoveTemp(NewConfigRegistry);
+	DefaultConfig = nullptr;
+	CachedConfigMap.Reset();
+	MergedConfigCache.Reset();
 
 	bool bHasBasicType = false;
-	for (auto Iterator = ConfigMap.CreateConstIterator(); Iterator; ++Iterator)
+	for (int32 Index = 0; Index < ConfigRegistry->Configs.Num(); ++Index)
 	{
-		FName CameraID = Iterator->Key;
-		const auto& Config = Iterator->Value;
+		const FName CameraID = ConfigRegistry->CameraIDs[Index];
+		const FJoyCameraConfig& Config = ConfigRegistry->Configs[Index];
 
 		if (Config.Type == EJoyCameraType::Basic)
 		{
@@ -82,13 +78,13 @@ void UJoyCameraConfigController::LoadConfig()
 			else
 			{
 				// 基础镜头配置
-				DefaultConfig = LoadProtoConfig(Config);
+				DefaultConfig = &Config;
 				bHasBasicType = true;
 			}
 		}
 		else if (Config.Type == EJoyCameraType::Sub)
 		{
-			CachedConfigMap.Add(CameraID, LoadProtoConfig(Config));
+			CachedConfigMap.Add(CameraID, &Config);
 		}
 		else
 		{
@@ -107,6 +103,8 @@ void UJoyCameraConfigController::LoadConfig()
 
 void UJoyCameraConfigController::UpdateConfig(bool bForceUpdate)
 {
+	JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateConfig);
+
 	if (CameraManager == nullptr || DefaultConfig == nullptr)
 	{
 		UE_LOG(LogJoyCamera, Warning, TEXT("JoyCameraConfigController::UpdateConfig(): Camera manager is nullptr. "));
@@ -116,60 +114,83 @@ void UJoyCameraConfigController::UpdateConfig(bool bForceUpdate)
 	// 检查 GameplayTag 是否发生了变动，若有则更新镜头配置参数
 	if (bConfigDirty || bForceUpdate)
 	{
-		TArray<UCameraConfig*> TmpConfigList;
-		TmpConfigList.Add(DefaultConfig);
-
+		// 只有存在配置的镜头 ID 参与合并
+		TArray<FName> CameraStack;
+		uint32 StackHash = 0;
 		const FCameraConfigDescription& CameraConfigDesc = CameraManager->GetCameraConfigDescription();
-		for (auto CameraNameIterator = CameraConfigDesc.CameraStack.CreateConstIterator(); CameraNameIterator;
-		     ++CameraNameIterator)
+		for (const FName& CameraName : CameraConfigDesc.CameraStack)
 		{
-			if (CachedConfigMap.Contains(*CameraNameIterator))
+			if (CachedConfigMap.Contains(CameraName))
 			{
-				TmpConfigList.Add(CachedConfigMap[*CameraNameIterator]);
+				CameraStack.Add(CameraName);
+				StackHash = HashCombineFast(StackHash, GetTypeHash(CameraName));
 			}
 		}
 
-		TmpConfigList.Sort([](const UCameraConfig& A, const UCameraConfig& B)
+		FJoyCameraMergedConfig* MergedConfig = MergedConfigCache.Find(StackHash);
+		if (MergedConfig == nullptr || MergedConfig->CameraStack != CameraStack)
 		{
-			return (A.Type == EJoyCameraType::Basic) || (A.Priority < B.Priority);
-		});
-
-		for (const auto* Config : TmpConfigList)
-		{
-			UpdateConfigData(Config);
-			ConfigFadeDurationTime = Config->FadeOutTime;
-			bFadeArmPitch = Config->bFadeArmPitch;
-			FadeTargetArmPitch = Config->FadeTargetArmPitch;
-			bArmCenterLagEnable = Config->bArmCenterLagEnable;
-		}
+			INC_DWORD_STAT(STAT_JoyCamera_ConfigRecomputes);
 
-		const int ConfigNum = TmpConfigList.Num();
-		ConfigFadeDurationTime = TmpConfigList.IsEmpty() ? 0 : TmpConfigList[ConfigNum - 1]->FadeInTime;
-
-		bool bOverrideCameraInput = false;
-		if (!TmpConfigList.IsEmpty())
-		{
-			if (const UCameraConfig* TopCameraConfig = TmpConfigList[TmpConfigList.Num() - 1])
+			if (MergedConfig == nullptr && MergedConfigCache.Num() >= MaxMergedConfigs)
 			{
-				bOverrideCameraInput = TopCameraConfig->bOverrideCameraInput;
+				MergedConfigCache.Reset();
 			}
+
+			MergedConfig = &MergedConfigCache.FindOrAdd(StackHash);
+			MergedConfig->CameraStack = CameraStack;
+			MergeConfigs(MergedConfig->CameraStack, *MergedConfig);
 		}
 
+		UpdateConfigData(*MergedConfig);
+
 		CameraManager->ApplyConfig();
 		CameraManager->StartFade(ConfigFadeDurationTime, true, true, bFadeArmPitch, false, true, true,
-			true, bOverrideCameraInput);
+			true, MergedConfig->bOverrideCameraInput);
 	}
 
 	bConfigDirty = false;
 }
 
-void UJoyCameraConfigController::UpdateConfigData(const UCameraConfig* Config)
+void UJoyCameraConfigController::MergeConfigs(
+	const TArray<FName>& CameraStack, FJoyCameraMergedConfig& OutMergedConfig) const
 {
-	if (CameraManager == nullptr || Config == nullptr)
+	TArray<const FJoyCameraConfig*, TInlineAllocator<8>> TmpConfigList;
+	TmpConfigList.Add(DefaultConfig);
+	for (const FName& CameraName : CameraStack)
 	{
-		return;
+		TmpConfigList.Add(CachedConfigMap[CameraName]);
 	}
 
-	CameraManager->SetConfigs(Config->BasicConfig);
-	CameraManager->CameraInputController->SetConfigs(Config->InputConfig);
+	TmpConfigList.Sort([](const FJoyCameraConfig& A, const FJoyCameraConfig& B)
+	{
+		return (A.Type == EJoyCameraType::Basic) || (A.Priority < B.Priority);
+	});
+
+	// 按优先级依次覆盖，与逐个应用配置的结果一致
+	OutMergedConfig.BasicConfig = FJoyCameraBasicConfig();
+	OutMergedConfig.InputConfig = FJoyCameraInputConfig();
+	for (const FJoyCameraConfig* Config : TmpConfigList)
+	{
+		OutMergedConfig.BasicConfig.Merge(Config->BasicConfig);
+		OutMergedConfig.InputConfig.Merge(Config->InputConfig);
+		OutMergedConfig.bFadeArmPitch = Config->bFadeArmPitch;
+		OutMergedConfig.FadeTargetArmPitch = Config->FadeTargetArmPitch;
+		OutMergedConfig.bArmCenterLagEnable = Config->bArmCenterLagEnable;
+	}
+
+	const FJoyCameraConfig* TopCameraConfig = TmpConfigList.Last();
+	OutMergedConfig.FadeDurationTime = TopCameraConfig->FadeInTime;
+	OutMergedConfig.bOverrideCameraInput = TopCameraConfig->bOverrideCameraInput;
+}
+
+void UJoyCameraConfigController::UpdateConfigData(const FJoyCameraMergedConfig& MergedConfig)
+{
+	ConfigFadeDurationTime = MergedConfig.FadeDurationTime;
+	bFadeArmPitch = MergedConfig.bFadeArmPitch;
+	FadeTargetArmPitch = MergedConfig.FadeTargetArmPitch;
+	bArmCenterLagEnable = MergedConfig.bArmCenterLagEnable;
+
+	CameraManager->SetConfigs(MergedConfig.BasicConfig);
+	CameraManager->CameraInputController->SetConfigs(MergedConfig.InputConfig);
 }
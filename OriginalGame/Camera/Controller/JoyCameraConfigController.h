@@ -2,52 +2,35 @@
 
 #pragma once
 
+#include "Camera/Controller/JoyCameraMeta.h"
+#include "Camera/JoyCameraData.h"
 #include "CoreMinimal.h"
 #include "JoyCameraControllerBase.h"
 #include "UObject/Object.h"
 
 #include "JoyCameraConfigController.generated.h"
 
-struct FJoyCameraConfigTable;
-
-UCLASS()
-class ORIGINALGAME_API UCameraConfig : public UObject
+/**
+ * 一组镜头 ID 按优先级依次应用后的合并结果
+ */
+struct FJoyCameraMergedConfig
 {
-	GENERATED_BODY()
+	// 参与合并的镜头 ID，用于校验哈希冲突
+	TArray<FName> CameraStack;
 
-public:
-	// 更新至此配置需要的时间
-	float FadeInTime{0.f};
+	FJoyCameraBasicConfig BasicConfig{};
 
-	// 离开此配置需要的时间
-	float FadeOutTime{0.f};
+	FJoyCameraInputConfig InputConfig{};
 
-	bool bIgnoreTimeDilation{false};
+	float FadeDurationTime{0.f};
 
 	bool bFadeArmPitch{false};
 
-	float FadeTargetArmPitch{0.};
-
-	bool bOverrideCameraInput{true};
+	float FadeTargetArmPitch{0.f};
 
 	bool bArmCenterLagEnable{false};
 
-	// 镜头优先级
-	int32 Priority{0};
-
-	// 默认相机参数
-	TMap<EJoyCameraBasic, float> BasicConfig;
-
-	TMap<EJoyCameraInput, float> InputConfig;
-
-	// 相机类型
-	EJoyCameraType Type;
-
-	FString Description{};
-
-	UCameraConfig();
-
-	void LoadProto(const FJoyCameraConfigTable& Config);
+	bool bOverrideCameraInput{false};
 };
 
 UCLASS()
@@ -58,9 +41,8 @@ class ORIGINALGAME_API UJoyCameraConfigController : public UJoyCameraControllerB
 	friend class AJoyPlayerCameraManager;
 
 public:
-	// 默认相机参数
-	UPROPERTY()
-	UCameraConfig* DefaultConfig = nullptr;
+	// 默认相机参数，指向 ConfigRegistry 中的基础镜头
+	const FJoyCameraConfig* DefaultConfig = nullptr;
 
 	UJoyCameraConfigController();
 
@@ -85,10 +67,20 @@ protected:
 	void UpdateConfig(bool bForceUpdate = false);
 
 private:
-	void UpdateConfigData(const UCameraConfig* Config);
+	// 合并缓存的上限，战斗姿态切换只会在少数几种组合之间来回
+	static constexpr int32 MaxMergedConfigs = 64;
+
+	void MergeConfigs(const TArray<FName>& CameraStack, FJoyCameraMergedConfig& OutMergedConfig) const;
+
+	void UpdateConfigData(const FJoyCameraMergedConfig& MergedConfig);
+
+	// 持有加载时的注册表，保证配置指针在热重载后依然有效
+	FJoyCameraConfigRegistryPtr ConfigRegistry;
+
+	TMap<FName, const FJoyCameraConfig*> CachedConfigMap;
 
-	UPROPERTY()
-	TMap<FName, UCameraConfig*> CachedConfigMap;
+	// 以镜头 ID 栈的哈希为键缓存合并结果，回到已知组合时只需一次查找与拷贝
+	TMap<uint32, FJoyCameraMergedConfig> MergedConfigCache;
 
 	bool bConfigDirty = false;
 };
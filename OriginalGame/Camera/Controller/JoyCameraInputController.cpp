@@ -7,6 +7,17 @@
 #include "Character/JoyCharacter.h"
 #include "Gameplay/JoyCharacterControlManageSubsystem.h"
 #include "Player/JoyPlayerController.h"
+#include "Camera/Replay/JoyCameraReplay.h"
+
+static TAutoConsoleVariable<bool> CVarTimedLookInput(TEXT("Joy.Camera.TimedLookInput"), true,
+	TEXT("镜头方向输入记录时间戳并按时间顺序积分，使用与帧率无关的平滑；关闭时使用每帧最后一次输入与逐帧缓动"),
+	ECVF_Default);
+
+namespace JoyCameraInputController_Statics
+{
+// 单个输入最多覆盖的时长，与原有逻辑对 DeltaTime 的限制一致，超出的部分视为没有输入
+static constexpr double MaxLookSampleInterval = 0.05;
+}
 
 UJoyCameraInputController::UJoyCameraInputController()
 {
@@ -59,48 +70,57 @@ void UJoyCameraInputController::UpdateRotationInput(float DeltaSeconds)
 
 	// 开始缓冲
 	const float DeltaTime = FMath::Clamp(DeltaSeconds, 0, 0.05);
-	// 鼠标实际输入值 yaw
-	const float MoveYaw = YawInputValue * SensitivityYaw * DeltaTime;
-	// @TODO 此处乘以 DeltaTime 后可能会有抖动
-	// const float MoveYaw = YawInputValue * SensitivityYaw;
-	// 鼠标实际输入值 pitch
-	const float MovePitch = PitchInputValue * SensitivityPitch * DeltaTime;
-	// @TODO 此处乘以 DeltaTime 后可能会有抖动
-	// const float MovePitch = PitchInputValue * SensitivityPitch;
-
-	// 每帧的镜头输入需要插值缓动
-	CachedAccYawInput = CachedAccYawInput * (1.0 - RotationInputSmoothFactor) + MoveYaw * RotationInputSmoothFactor;
-	CachedAccPitchInput = CachedAccPitchInput * (1.0 - RotationInputSmoothFactor) + MovePitch * RotationInputSmoothFactor;
-
-	// 限制镜头最大输入速率
-	CachedAccYawInput = FMath::Clamp(CachedAccYawInput, -MaxRotationInputSpeed, MaxRotationInputSpeed);
-	CachedAccPitchInput = FMath::Clamp(CachedAccPitchInput, -MaxRotationInputSpeed, MaxRotationInputSpeed);
-
-	// 如果 yaw 输入方向改变了，则将缓存变为 0
-	if (CachedAccYawInput * MoveYaw < 0)
+	float MinRotationInput = MinRotationInputSpeed;
+	if (CVarTimedLookInput.GetValueOnGameThread())
+	{
+		MinRotationInput = MinRotationInputRate * UpdateTimedRotationInput();
+	}
+	else
 	{
-		CachedAccYawInput = 0.f;
+		// 鼠标实际输入值 yaw
+		const float MoveYaw = YawInputValue * SensitivityYaw * DeltaTime;
+		// @TODO 此处乘以 DeltaTime 后可能会有抖动
+		// const float MoveYaw = YawInputValue * SensitivityYaw;
+		// 鼠标实际输入值 pitch
+		const float MovePitch = PitchInputValue * SensitivityPitch * DeltaTime;
+		// @TODO 此处乘以 DeltaTime 后可能会有抖动
+		// const float MovePitch = PitchInputValue * SensitivityPitch;
+
+		// 每帧的镜头输入需要插值缓动
+		CachedAccYawInput = CachedAccYawInput * (1.0 - RotationInputSmoothFactor) + MoveYaw * RotationInputSmoothFactor;
+		CachedAccPitchInput =
+			CachedAccPitchInput * (1.0 - RotationInputSmoothFactor) + MovePitch * RotationInputSmoothFactor;
+
+		// 限制镜头最大输入速率
+		CachedAccYawInput = FMath::Clamp(CachedAccYawInput, -MaxRotationInputSpeed, MaxRotationInputSpeed);
+		CachedAccPitchInput = FMath::Clamp(CachedAccPitchInput, -MaxRotationInputSpeed, MaxRotationInputSpeed);
+
+		// 如果 yaw 输入方向改变了，则将缓存变为 0
+		if (CachedAccYawInput * MoveYaw < 0)
+		{
+			CachedAccYawInput = 0.f;
+		}
 	}
 
 	if (LockArmRotationYawStack <= 0)
 	{
 		// 限制镜头最小输入速率
-		if (!FMath::IsNearlyZero(CachedAccYawInput, MinRotationInputSpeed))
+		if (!FMath::IsNearlyZero(CachedAccYawInput, MinRotationInput))
 		{
 			// 移动输入下一帧生效
 			PlayerCtrl->AddYawInput(CachedAccYawInput);
-			ViewTargetCamera->bArmYaw_HasModified = true;
+			ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::Yaw;
 		}
 	}
 
 	if (LockArmRotationPitchStack <= 0 && bPitchInput)
 	{
 		// 限制镜头最小输入速率
-		if (!FMath::IsNearlyZero(CachedAccPitchInput, MinRotationInputSpeed))
+		if (!FMath::IsNearlyZero(CachedAccPitchInput, MinRotationInput))
 		{
 			// 移动输入下一帧生效
 			PlayerCtrl->AddPitchInput(CachedAccPitchInput);
-			ViewTargetCamera->bArmPitch_HasModified = true;
+			ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::Pitch;
 		}
 	}
 
@@ -120,8 +140,151 @@ void UJoyCameraInputController::UpdateRotationInput(float DeltaSeconds)
 
 	if (CurrentViewTarget != CameraManager->PendingViewTarget.Target)
 	{
-		ViewTargetCamera->DesiredCamera.ArmCenterRotation = PlayerCtrl->GetControlRotation();
+		ViewTargetCamera->DesiredCamera.SetArmCenterRotation(PlayerCtrl->GetControlRotation());
+	}
+}
+
+float UJoyCameraInputController::UpdateTimedRotationInput()
+{
+	using namespace JoyCameraInputController_Statics;
+
+	const double Now = GetLookInputTime();
+	if (Now < LastLookInputFrameTime)
+	{
+		// 时钟回退（开始回放），之前的状态已经失效
+		ResetLookInputState(Now);
+	}
+
+	// 按到达顺序积分截止到本帧的输入，晚于本帧时间的输入留到下一帧
+	while (NumLookInputSamples > 0 && LookInputSamples[LookInputSampleHead].Time <= Now)
+	{
+		IntegrateLookInputSample(LookInputSamples[LookInputSampleHead]);
+		LookInputSampleHead = (LookInputSampleHead + 1) % MaxLookInputSamples;
+		NumLookInputSamples--;
+	}
+
+	// 最后一个输入到本帧之间没有输入，平滑速率继续衰减
+	IntegrateLookInputSegment(YawInputState, 0.f, Now);
+	IntegrateLookInputSegment(PitchInputState, 0.f, Now);
+
+	CachedAccYawInput = YawInputState.Move;
+	CachedAccPitchInput = PitchInputState.Move;
+	YawInputState.Move = 0.f;
+	PitchInputState.Move = 0.f;
+
+	const float FrameTime = static_cast<float>(FMath::Clamp(Now - LastLookInputFrameTime, 0., MaxLookSampleInterval));
+	LastLookInputFrameTime = Now;
+	return FrameTime;
+}
+
+void UJoyCameraInputController::AddLookInputSample(ELookInputAxis Axis, float Value)
+{
+	const double Now = GetLookInputTime();
+
+	// 同一时刻的多次输入只保留最后一次，与原有逻辑一致
+	for (int32 Index = NumLookInputSamples - 1; Index >= 0; --Index)
+	{
+		FLookInputSample& Sample = LookInputSamples[(LookInputSampleHead + Index) % MaxLookInputSamples];
+		if (Sample.Time != Now)
+		{
+			break;
+		}
+
+		if (Sample.Axis == Axis)
+		{
+			Sample.Value = Value;
+			return;
+		}
+	}
+
+	// 队列已满时提前积分最早的输入，转动量计入本帧
+	if (NumLookInputSamples == MaxLookInputSamples)
+	{
+		IntegrateLookInputSample(LookInputSamples[LookInputSampleHead]);
+		LookInputSampleHead = (LookInputSampleHead + 1) % MaxLookInputSamples;
+		NumLookInputSamples--;
+	}
+
+	FLookInputSample& Sample = LookInputSamples[(LookInputSampleHead + NumLookInputSamples) % MaxLookInputSamples];
+	Sample.Time = Now;
+	Sample.Value = Value;
+	Sample.Axis = Axis;
+	NumLookInputSamples++;
+}
+
+void UJoyCameraInputController::IntegrateLookInputSample(const FLookInputSample& Sample)
+{
+	using namespace JoyCameraInputController_Statics;
+
+	const bool bYaw = Sample.Axis == ELookInputAxis::Yaw;
+	FLookInputAxisState& State = bYaw ? YawInputState : PitchInputState;
+	const float Sensitivity = bYaw ? SensitivityYaw : SensitivityPitch;
+
+	// 输入值是速率，覆盖从上一个输入到本次输入的区间
+	const double SampleStart = FMath::Max(State.LastSampleTime, Sample.Time - MaxLookSampleInterval);
+	const float SampleDuration = static_cast<float>(FMath::Max(Sample.Time - SampleStart, 0.));
+	const float Displacement = Sample.Value * Sensitivity * SampleDuration;
+	State.LastSampleTime = Sample.Time;
+
+	// 区间之前没有输入的部分按零速率积分
+	if (State.IntegratedTime < SampleStart)
+	{
+		IntegrateLookInputSegment(State, 0.f, SampleStart);
+	}
+
+	// 区间中已经积分过的部分（上一帧末尾按没有输入处理）压缩到剩余的区间内，总位移不变
+	const float Duration = static_cast<float>(Sample.Time - State.IntegratedTime);
+	if (Duration <= UE_SMALL_NUMBER)
+	{
+		State.Move += Displacement;
+		return;
+	}
+
+	// 限制镜头最大输入速率
+	const float Rate = FMath::Clamp(Displacement / Duration, -MaxRotationInputRate, MaxRotationInputRate);
+
+	// 如果 yaw 输入方向改变了，则将缓存变为 0
+	if (bYaw && State.SmoothedRate * Rate < 0)
+	{
+		State.SmoothedRate = 0.f;
+	}
+
+	IntegrateLookInputSegment(State, Rate, Sample.Time);
+}
+
+void UJoyCameraInputController::IntegrateLookInputSegment(FLookInputAxisState& State, float Rate, double EndTime) const
+{
+	const float Duration = static_cast<float>(EndTime - State.IntegratedTime);
+	if (Duration <= 0.f)
+	{
+		return;
+	}
+
+	State.IntegratedTime = EndTime;
+	if (RotationInputSmoothTime <= UE_SMALL_NUMBER)
+	{
+		State.SmoothedRate = Rate;
+		State.Move += Rate * Duration;
+		return;
 	}
+
+	// 平滑速率以时间常数 RotationInputSmoothTime 指数趋近 Rate，转动量为平滑速率在区间内的精确积分
+	const float Decay = FMath::Exp(-Duration / RotationInputSmoothTime);
+	State.Move += Rate * Duration + (State.SmoothedRate - Rate) * RotationInputSmoothTime * (1.f - Decay);
+	State.SmoothedRate = Rate + (State.SmoothedRate - Rate) * Decay;
+}
+
+void UJoyCameraInputController::ResetLookInputState(double Time)
+{
+	for (FLookInputAxisState* State : {&YawInputState, &PitchInputState})
+	{
+		State->LastSampleTime = Time;
+		State->IntegratedTime = Time;
+		State->SmoothedRate = 0.f;
+		State->Move = 0.f;
+	}
+
+	LastLookInputFrameTime = Time;
 }
 
 bool UJoyCameraInputController::ArmInputReversed() const
@@ -189,11 +352,12 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 
 				// 更新 Arm Fov
 				const float FovZoomDelta = CurrentZoomFov - OldZoomFov;
-				ViewTargetCamera->DesiredCamera.Fov += FovZoomDelta;
-				ViewTargetCamera->DesiredCamera.Fov = FMath::Clamp(ViewTargetCamera->DesiredCamera.Fov, MinFov, MaxFov);
-				ViewTargetCamera->bCameraFov_HasModified = true;
+				ViewTargetCamera->DesiredCamera.SetFov(
+					FMath::Clamp(ViewTargetCamera->DesiredCamera.GetFov() + FovZoomDelta, MinFov, MaxFov));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::Fov;
 
-				if (ArmZoomValue > 0 && FMath::IsNearlyEqual(ViewTargetCamera->DesiredCamera.Fov, CameraManager->BaseFov))
+				if (ArmZoomValue > 0 &&
+					FMath::IsNearlyEqual(ViewTargetCamera->DesiredCamera.GetFov(), CameraManager->BaseFov))
 				{
 					bProcessFov = false;
 				}
@@ -215,12 +379,12 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 
 				// 更新 Arm Length
 				const float ArmLengthZoomDelta = CurrentZoomArmLength - OldZoomArmLength;
-				ViewTargetCamera->DesiredCamera.ArmLength += ArmLengthZoomDelta;
-				ViewTargetCamera->DesiredCamera.ArmLength =
-					FMath::Clamp(ViewTargetCamera->DesiredCamera.ArmLength, MinArmLength, MaxArmLength);
-				ViewTargetCamera->bCameraArmLength_HasModified = true;
+				const float NewArmLength = ViewTargetCamera->DesiredCamera.GetArmLength() + ArmLengthZoomDelta;
+				ViewTargetCamera->DesiredCamera.SetArmLength(FMath::Clamp(NewArmLength, MinArmLength, MaxArmLength));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::ArmLength;
 
-				if (ArmZoomValue < 0 && FMath::IsNearlyEqual(ViewTargetCamera->DesiredCamera.ArmLength, MinArmLength) &&
+				if (ArmZoomValue < 0 &&
+					FMath::IsNearlyEqual(ViewTargetCamera->DesiredCamera.GetArmLength(), MinArmLength) &&
 					CameraManager->BaseFov != FovOnHitFace)
 				{
 					// 此时臂长已经缩短到了最小值，开启调整 Fov
@@ -241,9 +405,9 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 			if (FMath::Abs(DesiredZoomFov - CurrentZoomFov) < UE_SMALL_NUMBER)
 			{
 				// Fov 修正完毕
-				ViewTargetCamera->DesiredCamera.Fov += (DesiredZoomFov - CurrentZoomFov);
-				ViewTargetCamera->DesiredCamera.Fov = FMath::Clamp(ViewTargetCamera->DesiredCamera.Fov, MinFov, MaxFov);
-				ViewTargetCamera->bCameraFov_HasModified = true;
+				ViewTargetCamera->DesiredCamera.SetFov(FMath::Clamp(
+					ViewTargetCamera->DesiredCamera.GetFov() + (DesiredZoomFov - CurrentZoomFov), MinFov, MaxFov));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::Fov;
 
 				// 清理 Fov 状态
 				bArmLengthZooming = false;
@@ -255,9 +419,9 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 				const float OldZoomArmFov = CurrentZoomFov;
 				CurrentZoomFov = FMath::FInterpTo(CurrentZoomFov, DesiredZoomFov, DeltaSeconds, FovSpeedOnHitFace);
 				const float FovZoomDelta = CurrentZoomFov - OldZoomArmFov;
-				ViewTargetCamera->DesiredCamera.Fov += FovZoomDelta;
-				ViewTargetCamera->DesiredCamera.Fov = FMath::Clamp(ViewTargetCamera->DesiredCamera.Fov, MinFov, MaxFov);
-				ViewTargetCamera->bCameraFov_HasModified = true;
+				ViewTargetCamera->DesiredCamera.SetFov(
+					FMath::Clamp(ViewTargetCamera->DesiredCamera.GetFov() + FovZoomDelta, MinFov, MaxFov));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::Fov;
 			}
 		}
 		else
@@ -266,10 +430,10 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 			if (FMath::Abs(DesiredZoomArmLength - CurrentZoomArmLength) < UE_SMALL_NUMBER)
 			{
 				// 回弹完毕
-				ViewTargetCamera->DesiredCamera.ArmLength += (DesiredZoomArmLength - CurrentZoomArmLength);
-				ViewTargetCamera->DesiredCamera.ArmLength =
-					FMath::Clamp(ViewTargetCamera->DesiredCamera.ArmLength, MinArmLength, MaxArmLength);
-				ViewTargetCamera->bCameraArmLength_HasModified = true;
+				const float NewArmLength =
+					ViewTargetCamera->DesiredCamera.GetArmLength() + (DesiredZoomArmLength - CurrentZoomArmLength);
+				ViewTargetCamera->DesiredCamera.SetArmLength(FMath::Clamp(NewArmLength, MinArmLength, MaxArmLength));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::ArmLength;
 
 				// 清理状态
 				bArmLengthZooming = false;
@@ -282,10 +446,9 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 				CurrentZoomArmLength =
 					FMath::FInterpTo(CurrentZoomArmLength, DesiredZoomArmLength, DeltaSeconds, ArmZoomLagSpeed);
 				const float ArmLengthZoomDelta = CurrentZoomArmLength - OldZoomArmLength;
-				ViewTargetCamera->DesiredCamera.ArmLength += ArmLengthZoomDelta;
-				ViewTargetCamera->DesiredCamera.ArmLength =
-					FMath::Clamp(ViewTargetCamera->DesiredCamera.ArmLength, MinArmLength, MaxArmLength);
-				ViewTargetCamera->bCameraArmLength_HasModified = true;
+				const float NewArmLength = ViewTargetCamera->DesiredCamera.GetArmLength() + ArmLengthZoomDelta;
+				ViewTargetCamera->DesiredCamera.SetArmLength(FMath::Clamp(NewArmLength, MinArmLength, MaxArmLength));
+				ViewTargetCamera->ModifiedChannels |= EJoyCameraChannel::ArmLength;
 			}
 		}
 	}
@@ -293,17 +456,40 @@ void UJoyCameraInputController::UpdateZoomInput(float DeltaSeconds)
 
 void UJoyCameraInputController::AddYawInput(float Val)
 {
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+	{
+		Recorder->RecordInput(EJoyCameraReplayEvent::YawInput, Val, GetLookInputTime());
+	}
+#endif
+
 	YawInputValue = Val;
+	AddLookInputSample(ELookInputAxis::Yaw, Val);
 }
 
 void UJoyCameraInputController::AddPitchInput(float Val)
 {
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+	{
+		Recorder->RecordInput(EJoyCameraReplayEvent::PitchInput, Val, GetLookInputTime());
+	}
+#endif
+
 	bPitchInput = true;
 	PitchInputValue = Val;
+	AddLookInputSample(ELookInputAxis::Pitch, Val);
 }
 
 void UJoyCameraInputController::AddDeviceArmLengthInput(float Val)
 {
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+	{
+		Recorder->RecordInput(EJoyCameraReplayEvent::ArmLengthInput, Val);
+	}
+#endif
+
 	bArmLengthInput = true;
 	ArmZoomValue = Val;
 }
@@ -315,6 +501,16 @@ void UJoyCameraInputController::ResetDeviceInput()
 
 	YawInputValue = 0.f;
 
+	// 本帧没有积分的输入（没有可控制的角色等）直接丢弃，与原有逻辑一致
+	const double Now = GetLookInputTime();
+	while (NumLookInputSamples > 0 && LookInputSamples[LookInputSampleHead].Time <= Now)
+	{
+		LookInputSampleHead = (LookInputSampleHead + 1) % MaxLookInputSamples;
+		NumLookInputSamples--;
+	}
+	YawInputState.Move = 0.f;
+	PitchInputState.Move = 0.f;
+
 	bArmLengthInput = false;
 	ArmZoomValue = 0.f;
 }
@@ -354,7 +550,7 @@ void UJoyCameraInputController::UnlockArmRotationYaw()
 	LockArmRotationYawStack--;
 }
 
-void UJoyCameraInputController::SetConfigs(const TMap<EJoyCameraInput, float>& Config)
+void UJoyCameraInputController::SetConfigs(const FJoyCameraInputConfig& Config)
 {
 	UPDATE_INPUT_CONFIGS(ArmZoomSpeed);
 	UPDATE_INPUT_CONFIGS(RotationInputSmoothFactor);
@@ -362,6 +558,9 @@ void UJoyCameraInputController::SetConfigs(const TMap<EJoyCameraInput, float>& C
 	UPDATE_INPUT_CONFIGS(SensitivityPitch);
 	UPDATE_INPUT_CONFIGS(MinRotationInputSpeed);
 	UPDATE_INPUT_CONFIGS(MaxRotationInputSpeed);
+	UPDATE_INPUT_CONFIGS(RotationInputSmoothTime);
+	UPDATE_INPUT_CONFIGS(MinRotationInputRate);
+	UPDATE_INPUT_CONFIGS(MaxRotationInputRate);
 	UPDATE_INPUT_CONFIGS(ArmZoomLagSpeed);
 	UPDATE_INPUT_CONFIGS(FovZoomSpeed);
 	UPDATE_INPUT_CONFIGS(FovOnHitFace);
@@ -41,16 +41,70 @@ public:
 
 	void AddDeviceArmLengthInput(float Val);
 
-	void SetConfigs(const TMap<EJoyCameraInput, float>& InputConfig);
+	void SetConfigs(const FJoyCameraInputConfig& InputConfig);
 
 	float GetZoomLagSpeed() const
 	{
 		return ArmZoomLagSpeed;
 	}
 
+	// 镜头方向输入使用的时钟，录制与回放时指定为录制时的时间，保证回放结果一致
+	double GetLookInputTime() const
+	{
+		return LookInputTimeOverride.IsSet() ? LookInputTimeOverride.GetValue() : FPlatformTime::Seconds();
+	}
+
+	void SetLookInputTimeOverride(double Time)
+	{
+		LookInputTimeOverride = Time;
+	}
+
+	void ClearLookInputTimeOverride()
+	{
+		LookInputTimeOverride.Reset();
+	}
+
 private:
+	enum class ELookInputAxis : uint8
+	{
+		Yaw,
+		Pitch,
+	};
+
+	// 带时间戳的镜头方向输入，Value 为输入速率，覆盖从同一方向上一个输入到 Time 的区间
+	struct FLookInputSample
+	{
+		double Time = 0.;
+		float Value = 0.f;
+		ELookInputAxis Axis = ELookInputAxis::Yaw;
+	};
+
+	struct FLookInputAxisState
+	{
+		// 上一个输入的时间
+		double LastSampleTime = 0.;
+		// 已经积分到的时间
+		double IntegratedTime = 0.;
+		// 平滑后的输入速率（每秒）
+		float SmoothedRate = 0.f;
+		// 本帧积分得到的转动量
+		float Move = 0.f;
+	};
+
 	void UpdateRotationInput(float DeltaSeconds);
 
+	// 按时间顺序积分截止到本帧时间的输入，返回本帧覆盖的时长
+	float UpdateTimedRotationInput();
+
+	void AddLookInputSample(ELookInputAxis Axis, float Value);
+
+	void IntegrateLookInputSample(const FLookInputSample& Sample);
+
+	// 以恒定的输入速率 Rate 把平滑速率积分到 EndTime
+	void IntegrateLookInputSegment(FLookInputAxisState& State, float Rate, double EndTime) const;
+
+	void ResetLookInputState(double Time);
+
 	void UpdateZoomInput(float DeltaSeconds);
 
 	bool FovInputReversed(float StartFov, float EndFov) const;
@@ -70,6 +124,20 @@ private:
 	float CachedAccYawInput = 0;
 	float CachedAccPitchInput = 0;
 
+	// 尚未积分的镜头方向输入，环形队列
+	static constexpr int32 MaxLookInputSamples = 64;
+	FLookInputSample LookInputSamples[MaxLookInputSamples];
+	int32 LookInputSampleHead = 0;
+	int32 NumLookInputSamples = 0;
+
+	FLookInputAxisState YawInputState;
+	FLookInputAxisState PitchInputState;
+
+	// 上一次积分镜头方向输入时的时间
+	double LastLookInputFrameTime = 0.;
+
+	TOptional<double> LookInputTimeOverride;
+
 	// 每帧缓存的设备输入值
 	bool bArmLengthInput{false};
 	float ArmZoomValue{0};
@@ -113,6 +181,12 @@ private:
 	float MinRotationInputSpeed = 0.01;
 	// 最大镜头方向输入速率
 	float MaxRotationInputSpeed = 6.;
+	// 镜头方向输入缓动时间（秒），60 帧下与缓动系数 0.55 一致
+	float RotationInputSmoothTime = 0.02;
+	// 最小镜头方向输入速率（每秒）
+	float MinRotationInputRate = 0.6;
+	// 最大镜头方向输入速率（每秒）
+	float MaxRotationInputRate = 360.;
 	float MinRotationInputSpeed_LockTarget = 1.;
 	// 检查角色是否处于移动时相机臂修正状态
 	bool bInArmLengthCorrectionOnMove = false;
@@ -33,6 +33,7 @@ enum class EJoyCameraBasic : uint8
 	ArmRotationLagRecoverSpeed = 14 UMETA(DisplayName = "相机方向输入时相机旋转的滞后恢复速度"),
 
 	ViewTargetSwitchTime = 15 UMETA(DisplayName = "相机臂中心切换过度时间"),
+	NumMax UMETA(Hidden),
 };
 
 /**
@@ -51,6 +52,10 @@ enum class EJoyCameraInput : uint8
 	ArmZoomLagSpeed = 7 UMETA(DisplayName = "滚轮轴影响相机臂长度的变化延迟速度"),
 	FovZoomSpeed = 8 UMETA(DisplayName = "滚轮轴影响 Fov 弹性系数"),
 	FovOnHitFace = 9 UMETA(DisplayName = "相机臂缩短到脸部最近距离时的 Fov 值"),
+	RotationInputSmoothTime = 10 UMETA(DisplayName = "镜头方向输入缓动时间（秒）"),
+	MinRotationInputRate = 11 UMETA(DisplayName = "最小镜头方向输入速率（每秒）"),
+	MaxRotationInputRate = 12 UMETA(DisplayName = "最大镜头方向输入速率（每秒）"),
+	NumMax UMETA(Hidden),
 };
 
 /**
@@ -100,6 +105,67 @@ struct FJoyCameraConfigTable : public FTableRowBase
 	EJoyCameraType Type = EJoyCameraType::Basic;
 };
 
+/**
+ * 以枚举为下标的相机参数表，PresentMask 记录配置了哪些参数
+ * 接口与 TMap 的 Contains/operator[] 一致，合并与拷贝都是定长数组操作
+ */
+template <typename EnumType>
+struct TJoyCameraConfigValues
+{
+	static constexpr int32 NumValues = static_cast<int32>(EnumType::NumMax);
+	static_assert(NumValues <= 32, "PresentMask 只有 32 位");
+
+	float Values[NumValues]{};
+
+	uint32 PresentMask = 0;
+
+	TJoyCameraConfigValues() = default;
+
+	explicit TJoyCameraConfigValues(const TMap<EnumType, float>& Config)
+	{
+		for (const TPair<EnumType, float>& Pair : Config)
+		{
+			Set(Pair.Key, Pair.Value);
+		}
+	}
+
+	bool Contains(EnumType Key) const
+	{
+		return (PresentMask & (1u << static_cast<uint32>(Key))) != 0;
+	}
+
+	float operator[](EnumType Key) const
+	{
+		checkSlow(Contains(Key));
+		return Values[static_cast<int32>(Key)];
+	}
+
+	void Set(EnumType Key, float Value)
+	{
+		const int32 Index = static_cast<int32>(Key);
+		if (Index >= 0 && Index < NumValues)
+		{
+			Values[Index] = Value;
+			PresentMask |= 1u << Index;
+		}
+	}
+
+	// 用 Other 中配置了的参数覆盖自身，等价于先后应用两份配置
+	void Merge(const TJoyCameraConfigValues& Other)
+	{
+		for (uint32 Mask = Other.PresentMask; Mask != 0; Mask &= Mask - 1)
+		{
+			const int32 Index = FMath::CountTrailingZeros(Mask);
+			Values[Index] = Other.Values[Index];
+		}
+		PresentMask |= Other.PresentMask;
+	}
+};
+
+using FJoyCameraBasicConfig = TJoyCameraConfigValues<EJoyCameraBasic>;
+
+using FJoyCameraInputConfig = TJoyCameraConfigValues<EJoyCameraInput>;
+
 #define UPDATE_INPUT_CONFIGS(Key)             \
 	if (Config.Contains(EJoyCameraInput::Key)) \
 	{                                         \
@@ -111,3 +177,21 @@ struct FJoyCameraConfigTable : public FTableRowBase
 	{                                         \
 		Key = Config[EJoyCameraBasic::Key];    \
 	}
+
+/** 虚拟相机中可被单独淡入或修改的参数通道 */
+enum class EJoyCameraChannel : uint8
+{
+	None = 0,
+	ArmLength = 1 << 0,
+	ArmLengthRange = 1 << 1,
+	Offset = 1 << 2,
+	Pitch = 1 << 3,
+	Yaw = 1 << 4,
+	Roll = 1 << 5,
+	Fov = 1 << 6,
+
+	Rotation = Pitch | Yaw | Roll,
+	All = ArmLength | ArmLengthRange | Offset | Rotation | Fov,
+};
+ENUM_CLASS_FLAGS(EJoyCameraChannel);
+
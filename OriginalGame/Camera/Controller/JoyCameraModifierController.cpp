@@ -1,18 +1,68 @@
 ﻿#include "JoyCameraModifierController.h"
 
+#include "Algo/BinarySearch.h"
 #include "Camera/JoyCameraComponent.h"
+#include "Camera/JoyCameraCurveCache.h"
+#include "Camera/JoyCameraModifierPreset.h"
 #include "Camera/JoyPlayerCameraManager.h"
 #include "Character/JoyCharacter.h"
+#include "Gameplay/Gravity/JoyGravityManageSubsystem.h"
 #include "Gameplay/JoyCharacterControlManageSubsystem.h"
 #include "Gameplay/TimeDilation/JoyTimeDilationManageSubsystem.h"
 #include "JoyGameBlueprintLibrary.h"
 #include "JoyLogChannels.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Player/JoyPlayerController.h"
-#include "Utils/JoyMathBlueprintLibrary.h"
+#include "Camera/Replay/JoyCameraReplay.h"
 
 constexpr int32 GModify_Small_Length = 1;
 
+namespace JoyCameraModifier
+{
+	// 淡入淡出阶段用曲线重新映射混合 Alpha，没有曲线时保持线性
+	static float ApplyBlendCurve(const UCurveFloat* Curve, const FJoyBakedCurve* BakedCurve, EBlendState State,
+		float Alpha, float RawAlpha)
+	{
+		if (Curve == nullptr || BakedCurve == nullptr)
+		{
+			return Alpha;
+		}
+
+		if (State == EBlendState::BlendIn)
+		{
+			return BakedCurve->GetNormalizedValue(Curve, RawAlpha);
+		}
+
+		if (State == EBlendState::BlendOut)
+		{
+			return 1.0 - BakedCurve->GetNormalizedValue(Curve, 1.0 - RawAlpha);
+		}
+
+		return Alpha;
+	}
+
+	// 覆盖层淡入时从低优先级层的结果混合到目标值，Loop 阶段保持目标值
+	template <typename T>
+	static T BlendOverride(EBlendState State, float Alpha, const T& From, const T& Target)
+	{
+		return State == EBlendState::BlendIn ? FMath::Lerp(From, Target, Alpha) : Target;
+	}
+
+	// 叠加层在当前阶段的混合权重
+	static float GetAdditiveWeight(EBlendState State, float Alpha)
+	{
+		switch (State)
+		{
+			case EBlendState::BlendIn:
+				return Alpha;
+			case EBlendState::BlendOut:
+				return 1.f - Alpha;
+			default:
+				return 1.f;
+		}
+	}
+}
+
 bool FloatInterpTo(float Current, float Target, float DeltaTime, float Speed, float& InterValue)
 {
 	InterValue = FMath::FInterpTo(Current, Target, DeltaTime, Speed);
@@ -34,6 +84,17 @@ bool RotatorInterpTo(FRotator Current, FRotator Target, float DeltaTime, float S
 	return true;
 }
 
+// 带自适应选项的修改设置需要依据当前状态修正，不能直接共享
+static bool HasAdaptiveOption(const FCameraModifiers& Modifiers)
+{
+	return (Modifiers.LocalRotationSettings.bModifyYaw &&
+			   Modifiers.LocalRotationSettings.RelativeYawAdaptiveOption.bAdaptiveOption) ||
+		   (Modifiers.LocalRotationSettings.bModifyRoll &&
+			   Modifiers.LocalRotationSettings.RelativeRollAdaptiveOption.bAdaptiveOption) ||
+		   (Modifiers.LocalOffsetSettings.bModified &&
+			   Modifiers.LocalOffsetSettings.LocalArmOffsetYAdaptiveOption.bAdaptiveOption);
+}
+
 void PreProcessCameraModifiers(FCameraModifiers& Modifiers, const UJoyCameraModifierController* ModifierController)
 {
 	// 对 Modifiers 中的一些参数依据当前允许状态做修正
@@ -107,73 +168,182 @@ void PreProcessCameraModifiers(FCameraModifiers& Modifiers, const UJoyCameraModi
 	}
 }
 
+const FCameraModifiers& FJoyCameraModifyLayer::GetModifiers() const
+{
+	return Preset != nullptr ? Preset->CameraModifiers : Spec.CameraModifiers;
+}
+
+bool FJoyCameraModifyLayer::IsCameraRotationModified() const
+{
+	return bNeedModifyAdditionalCameraRotation || GetModifiers().WorldRotationSettings.bModified ||
+		   GetModifiers().LocalRotationSettings.bModifyPitch ||
+		   GetModifiers().LocalRotationSettings.bModifyYaw ||
+		   GetModifiers().LocalRotationSettings.bModifyRoll;
+}
+
 UJoyCameraModifierController::UJoyCameraModifierController()
 {
 }
 
-void UJoyCameraModifierController::SetModifyTarget(AActor* ModifyTarget)
+void UJoyCameraModifierController::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UJoyCameraModifierController* This = CastChecked<UJoyCameraModifierController>(InThis);
+	for (FJoyCameraModifyLayer& Layer : This->ModifyLayers)
+	{
+		// 修改层未反射，层内引用的预设与曲线需要手动上报
+		Collector.AddReferencedObject(Layer.Preset, This);
+
+		FCameraModifiers& Modifiers = Layer.Spec.CameraModifiers;
+		Collector.AddReferencedObject(Modifiers.ArmLengthSettings.ArmLengthCurve, This);
+		Collector.AddReferencedObject(Modifiers.CameraFovSettings.CameraFovCurve, This);
+		Collector.AddReferencedObject(Modifiers.LocalRotationSettings.BlendInCameraRotationAlphaCurve, This);
+		Collector.AddReferencedObject(Modifiers.ArmRotationCurve, This);
+
+		FJoyCameraModifyProgram& Program = Layer.Program;
+		Collector.AddReferencedObject(Program.ArmLengthCurve, This);
+		Collector.AddReferencedObject(Program.FovCurve, This);
+		Collector.AddReferencedObject(Program.ArmRotationCurve, This);
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+void UJoyCameraModifierController::SetModifyTarget(
+	AActor* ModifyTarget, const FViewTargetCameraHandle& InViewTargetHandle)
 {
 	ModifiedViewTarget = ModifyTarget;
+	ViewTargetHandle = InViewTargetHandle;
+}
+
+void UJoyCameraModifierController::ResetForReuse()
+{
+	ModifyLayers.Reset();
+	if (CameraManager != nullptr)
+	{
+		// 恢复仍被修改层屏蔽的输入
+		RefreshInputOverride();
+	}
+
+	bNeedModifyFadeOut = false;
+	bIgnoreTimeDilation = false;
+	PendingDeltaTime = 0.f;
+	bPendingEndModify = false;
+	bResetViewTarget = false;
+	TimeToResetViewTarget = 0.;
+	ModifyFadeOutData = FCameraFadeOutData();
+	ModifyArmRotationLagSpeed = 1.;
+	ModifyArmLengthLagSpeed = 1.;
+	ExternalDependencyCameraData.Clean();
+	ModifiedViewTarget = nullptr;
+	ViewTargetHandle = FViewTargetCameraHandle();
+	LastModifierHandle = FCameraModifyHandle(0);
+
+	// 仍持有本对象的一方使用旧句柄时不再作用于下一个所有者
+	OwnerGeneration = OwnerGeneration == MAX_uint32 ? 1 : OwnerGeneration + 1;
+}
+
+FViewTargetCameraInfo& UJoyCameraModifierController::GetModifyTargetCameraInfo() const
+{
+	FViewTargetCameraInfo* TargetCameraInfo = CameraManager->MultiViewTargetCameraManager.Resolve(ViewTargetHandle);
+	check(TargetCameraInfo);
+	return *TargetCameraInfo;
+}
+
+int32 UJoyCameraModifierController::FindLayerIndex(FCameraModifyHandle ModifyHandler) const
+{
+	return ModifyLayers.IndexOfByPredicate(
+		[ModifyHandler](const FJoyCameraModifyLayer& Layer) { return Layer.Handle == ModifyHandler; });
 }
 
 bool UJoyCameraModifierController::IsModifiedAndNeedUpdate() const
 {
-	if (bIsModified)
+	for (const FJoyCameraModifyLayer& Layer : ModifyLayers)
 	{
-		if (!bNeedManualBreakModify)
+		// 需要手动停止的层在 Loop 阶段等待中断，无需更新
+		if (!Layer.bNeedManualBreak || Layer.BlendState != EBlendState::Loop || Layer.bHasManualBreak)
 		{
-			// 无需手动停止
 			return true;
 		}
-		else
-		{
-			// 需要手动停止
-			if (CurrentBlendState != EBlendState::Loop || bHasManualBreakModify == true)
-			{
-				return true;
-			}
-		}
-	}
-	else if (bNeedModifyFadeOut)
-	{
-		// 已经修改完毕，且处于 fade out 状态
-		return true;
 	}
 
-	return false;
+	// 已经修改完毕，且处于 fade out 状态
+	return bNeedModifyFadeOut;
 }
 
 void UJoyCameraModifierController::UpdateInternal(float InDeltaSeconds)
+{
+	if (PreUpdate(InDeltaSeconds))
+	{
+		ComputeUpdate();
+		PostUpdate();
+	}
+}
+
+bool UJoyCameraModifierController::PreUpdate(float InDeltaSeconds)
 {
 	if (CameraManager == nullptr)
 	{
-		return;
+		return false;
 	}
 
-	const float DeltaTime = bIgnoreTimeDilation ? CameraManager->DeltaTimeThisFrame_IgnoreTimeDilation : CameraManager->DeltaTimeThisFrame;
-	Super::UpdateInternal(DeltaTime);
+	PendingDeltaTime = bIgnoreTimeDilation ? CameraManager->DeltaTimeThisFrame_IgnoreTimeDilation : CameraManager->DeltaTimeThisFrame;
+	Super::UpdateInternal(PendingDeltaTime);
 
 	if (ModifiedViewTarget.Get() == nullptr)
 	{
-		return;
+		return false;
 	}
 
-	if (bIsModified)
+	if (IsModified())
 	{
 		// 当正在修改相机镜头时，需要更新依赖的外部相机数据
 		ExternalDependencyCameraData.UpdateCameraData(ModifiedViewTarget->GetActorRotation().Quaternion());
 	}
 
-	if (CameraManager == nullptr)
+	return true;
+}
+
+void UJoyCameraModifierController::ComputeUpdate()
+{
+	// 修改相机参数
+	UpdateModifiers();
+
+	// 由于镜头被打断后，一部分参数可能尚未复原，所以需要在此处复原参数；
+	// 本帧有层结束时淡出数据要等 EndLayer 生成，推迟到 PostUpdate
+	if (!bPendingEndModify)
+	{
+		UpdateModifyFadeOut(PendingDeltaTime);
+	}
+}
+
+void UJoyCameraModifierController::PostUpdate()
+{
+	if (!bPendingEndModify)
 	{
 		return;
 	}
 
-	// 修改相机参数
-	UpdateModifiers(DeltaTime);
+	bPendingEndModify = false;
+	FEndedModifyHandles EndedHandles;
+	for (int32 LayerIndex = ModifyLayers.Num() - 1; LayerIndex >= 0; --LayerIndex)
+	{
+		const FJoyCameraModifyLayer& Layer = ModifyLayers[LayerIndex];
+		if (Layer.bPendingEnd)
+		{
+			if (Layer.GetModifiers().bResetViewTarget)
+			{
+				bResetViewTarget = true;
+				TimeToResetViewTarget = Layer.GetModifiers().TimeToResetViewTarget;
+			}
+
+			EndLayer(LayerIndex, EndedHandles);
+		}
+	}
 
-	// 由于镜头被打断后，一部分参数可能尚未复原，所以需要在此处复原参数
-	UpdateModifyFadeOut(DeltaTime);
+	ResetViewTarget();
+	UpdateModifyFadeOut(PendingDeltaTime);
+
+	BroadcastModifyEnd(EndedHandles);
 }
 
 void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
@@ -195,28 +365,29 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 		return;
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
+	FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
 	if (ModifyFadeOutData.bModifyArmLength)
 	{
 		// 如果修改了弹簧臂
-		if (TargetCameraInfo.bCameraArmLength_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::ArmLength))
 		{
 			// 当 ArmLength 又被修改时，则不再进行 FadeOut 处理
 			ModifyFadeOutData.bModifyArmLength = false;
 		}
 		else
 		{
-			ModifyFadeOutData.bModifyArmLength =
-				FloatInterpTo(TargetCameraInfo.CurrentCamera.ArmLength, ModifyFadeOutData.ArmLength, DeltaSeconds,
-					ModifyArmLengthLagSpeed, TargetCameraInfo.DesiredCamera.ArmLength);
-			TargetCameraInfo.bCameraArmLength_HasModified = true;
+			float ArmLength{0.f};
+			ModifyFadeOutData.bModifyArmLength = FloatInterpTo(TargetCameraInfo.CurrentCamera.GetArmLength(),
+				ModifyFadeOutData.ArmLength, DeltaSeconds, ModifyArmLengthLagSpeed, ArmLength);
+			TargetCameraInfo.DesiredCamera.SetArmLength(ArmLength);
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::ArmLength;
 		}
 	}
 
 	/*
 	if (ModifyFadeOutData.bModifyArmRotation)
 	{
-		if (TargetCameraInfo.bArmYaw_HasModified || TargetCameraInfo.bArmPitch_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Yaw | EJoyCameraChannel::Pitch))
 		{
 			// 当 ArmRotation 又被修改时，则不再进行 FadeOut 处理
 			ModifyFadeOutData.bModifyArmRotation = false;
@@ -227,15 +398,14 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 				RotatorInterpTo(TargetCameraInfo.CurrentCamera.ArmCenterRotation, ModifyFadeOutData.ArmRotation,
 					DeltaSeconds, ModifyArmRotationLagSpeed, TargetCameraInfo.DesiredCamera.ArmCenterRotation);
 
-			TargetCameraInfo.bArmYaw_HasModified = true;
-			TargetCameraInfo.bArmPitch_HasModified = true;
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::Yaw | EJoyCameraChannel::Pitch;
 		}
 	}
 	*/
 
 	if (ModifyFadeOutData.bModifyArmPitch)
 	{
-		if (TargetCameraInfo.bArmPitch_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Pitch))
 		{
 			// 当 ArmRotation 又被修改时，则不再进行 FadeOut 处理
 			ModifyFadeOutData.bModifyArmPitch = false;
@@ -243,16 +413,16 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 		else
 		{
 			float ArmPitch{0.f};
-			ModifyFadeOutData.bModifyArmPitch = FloatInterpTo(TargetCameraInfo.CurrentCamera.ArmCenterRotation.Pitch,
+			ModifyFadeOutData.bModifyArmPitch = FloatInterpTo(TargetCameraInfo.CurrentCamera.GetArmPitch(),
 				ModifyFadeOutData.ArmRotation.Pitch, DeltaSeconds, ModifyArmRotationLagSpeed, ArmPitch);
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation.Pitch = ArmPitch;
-			TargetCameraInfo.bArmPitch_HasModified = true;
+			TargetCameraInfo.DesiredCamera.SetArmPitch(ArmPitch);
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::Pitch;
 		}
 	}
 
 	if (ModifyFadeOutData.bModifyArmYaw)
 	{
-		if (TargetCameraInfo.bArmYaw_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Yaw))
 		{
 			// 当 ArmRotation 又被修改时，则不再进行 FadeOut 处理
 			ModifyFadeOutData.bModifyArmYaw = false;
@@ -260,16 +430,16 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 		else
 		{
 			float ArmYaw{0.f};
-			ModifyFadeOutData.bModifyArmYaw = FloatInterpTo(TargetCameraInfo.CurrentCamera.ArmCenterRotation.Yaw,
+			ModifyFadeOutData.bModifyArmYaw = FloatInterpTo(TargetCameraInfo.CurrentCamera.GetArmYaw(),
 				ModifyFadeOutData.ArmRotation.Yaw, DeltaSeconds, ModifyArmRotationLagSpeed, ArmYaw);
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation.Yaw = ArmYaw;
-			TargetCameraInfo.bArmYaw_HasModified = true;
+			TargetCameraInfo.DesiredCamera.SetArmYaw(ArmYaw);
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::Yaw;
 		}
 	}
 
 	if (ModifyFadeOutData.bModifyArmRoll)
 	{
-		if (TargetCameraInfo.bArmRoll_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Roll))
 		{
 			// 当 ArmRotation 又被修改时，则不再进行 FadeOut 处理
 			ModifyFadeOutData.bModifyArmRoll = false;
@@ -277,24 +447,26 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 		else
 		{
 			float ArmRoll{0.f};
-			ModifyFadeOutData.bModifyArmRoll = FloatInterpTo(TargetCameraInfo.CurrentCamera.ArmCenterRotation.Roll,
+			ModifyFadeOutData.bModifyArmRoll = FloatInterpTo(TargetCameraInfo.CurrentCamera.GetArmRoll(),
 				ModifyFadeOutData.ArmRotation.Roll, DeltaSeconds, ModifyArmRotationLagSpeed, ArmRoll);
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation.Roll = ArmRoll;
-			TargetCameraInfo.bArmRoll_HasModified = true;
+			TargetCameraInfo.DesiredCamera.SetArmRoll(ArmRoll);
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::Roll;
 		}
 	}
 
 	if (ModifyFadeOutData.bModifyFov)
 	{
-		if (TargetCameraInfo.bCameraFov_HasModified)
+		if (EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Fov))
 		{
 			ModifyFadeOutData.bModifyFov = false;
 		}
 		else
 		{
-			ModifyFadeOutData.bModifyFov = FloatInterpTo(TargetCameraInfo.CurrentCamera.Fov, ModifyFadeOutData.Fov,
-				DeltaSeconds, ModifyArmLengthLagSpeed, TargetCameraInfo.DesiredCamera.Fov);
-			TargetCameraInfo.bCameraFov_HasModified = true;
+			float Fov{0.f};
+			ModifyFadeOutData.bModifyFov = FloatInterpTo(TargetCameraInfo.CurrentCamera.GetFov(), ModifyFadeOutData.Fov,
+				DeltaSeconds, ModifyArmLengthLagSpeed, Fov);
+			TargetCameraInfo.DesiredCamera.SetFov(Fov);
+			TargetCameraInfo.ModifiedChannels |= EJoyCameraChannel::Fov;
 		}
 	}
 
@@ -303,33 +475,89 @@ void UJoyCameraModifierController::UpdateModifyFadeOut(float DeltaSeconds)
 						 ModifyFadeOutData.bModifyArmRoll || ModifyFadeOutData.bModifyFov;
 }
 
-void UJoyCameraModifierController::UpdateModifiers(float DeltaSeconds)
+void UJoyCameraModifierController::UpdateModifiers()
 {
-	if (!bIsModified)
+	if (ModifyLayers.Num() == 0)
+	{
+		return;
+	}
+
+	if (CameraManager == nullptr || ModifiedViewTarget.Get() == nullptr)
 	{
+		UE_LOG(LogJoyCamera, Error, TEXT("UpdateModifiers: PCM or ModifiedViewTarget is null"));
 		return;
 	}
 
-	ModifyElapsedTime += DeltaSeconds;
+	FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	FJoyCameraModifyStackState StackState;
+	StackState.bRotationInterrupted = EnumHasAnyFlags(TargetCameraInfo.ModifiedChannels, EJoyCameraChannel::Rotation);
+
+	// 按优先级从低到高求值，高优先级层以低优先级层的结果为混合起点
+	for (FJoyCameraModifyLayer& Layer : ModifyLayers)
+	{
+		const float DeltaSeconds = Layer.GetModifiers().bIgnoreTimeDilation
+									   ? CameraManager->DeltaTimeThisFrame_IgnoreTimeDilation
+									   : CameraManager->DeltaTimeThisFrame;
+		const float BlendAlpha = UpdateLayerBlend(Layer, DeltaSeconds);
+		bPendingEndModify |= Layer.bPendingEnd;
+
+		// 只执行编译时确定需要修改的通道
+		const EJoyCameraChannel ActiveChannels = Layer.Program.ActiveChannels;
+		if (EnumHasAnyFlags(ActiveChannels, EJoyCameraChannel::ArmLength))
+		{
+			// 更新相机臂最终臂长
+			UpdateArmLengthModifier(TargetCameraInfo, Layer, BlendAlpha, StackState);
+		}
+
+		if (Layer.Program.bModifyLocalOffset)
+		{
+			// 更新角色坐标系下的相机臂中心偏移
+			UpdateLocalArmCenterOffsetModifier(TargetCameraInfo, Layer, BlendAlpha, StackState);
+		}
+
+		if (Layer.Program.bModifyWorldOffset)
+		{
+			// 更新世界坐标系下面的相机臂中心偏移
+			UpdateWorldArmCenterOffsetModifier(TargetCameraInfo, Layer, BlendAlpha, StackState);
+		}
+
+		if (EnumHasAnyFlags(ActiveChannels, EJoyCameraChannel::Rotation))
+		{
+			// 更新相机臂旋转
+			UpdateArmRotationModifier(TargetCameraInfo, Layer, BlendAlpha, StackState);
+		}
+
+		if (EnumHasAnyFlags(ActiveChannels, EJoyCameraChannel::Fov))
+		{
+			UpdateFovModifier(TargetCameraInfo, Layer, BlendAlpha, StackState);
+		}
+	}
+
+	TargetCameraInfo.ModifiedChannels |= StackState.WrittenChannels;
+}
+
+float UJoyCameraModifierController::UpdateLayerBlend(FJoyCameraModifyLayer& Layer, float DeltaSeconds) const
+{
+	Layer.ElapsedTime += DeltaSeconds;
 
 	// 更新淡入淡出状态，以及插值数值
 	EBlendState BlendState = EBlendState::None;
 	float BlendAlpha = 0;
 
-	if (ModifyElapsedTime < ModifyBlendInTime)
+	if (Layer.ElapsedTime < Layer.BlendInTime)
 	{
 		// 淡入
 		BlendState = EBlendState::BlendIn;
 
-		CurrentRawBlendAlpha = ModifyBlendInTime > 0 ? this->ModifyElapsedTime / ModifyBlendInTime : 1;
-		BlendAlpha = CurrentRawBlendAlpha;
+		Layer.RawBlendAlpha = Layer.BlendInTime > 0 ? Layer.ElapsedTime / Layer.BlendInTime : 1;
+		BlendAlpha = Layer.RawBlendAlpha;
 	}
-	else if (!bNeedManualBreakModify && ModifyElapsedTime < ModifyBlendInTime + ModifyDuration)
+	else if (!Layer.bNeedManualBreak && Layer.ElapsedTime < Layer.BlendInTime + Layer.Duration)
 	{
 		/** 无需手动中断，且还未到持续时长，则保持值不变，设置为 Loop */
 		BlendState = EBlendState::Loop;
 	}
-	else if (bNeedManualBreakModify && !bHasManualBreakModify)
+	else if (Layer.bNeedManualBreak && !Layer.bHasManualBreak)
 	{
 		/** 需要手动中断修改过程，但尚未中断，则保持值不变，设置为 Loop */
 		BlendState = EBlendState::Loop;
@@ -338,51 +566,40 @@ void UJoyCameraModifierController::UpdateModifiers(float DeltaSeconds)
 	{
 		// 淡出
 		BlendState = EBlendState::BlendOut;
-		if (!bNeedManualBreakModify)
+		if (!Layer.bNeedManualBreak)
 		{
 			/** 如果是到达时间限制进入淡出，则统计 BlendIn + BlendDuration + BlendOut 阶段经过时间 */
-			CurrentRawBlendAlpha = ModifyBlendOutTime > 0
-									   ? (ModifyElapsedTime - ModifyBlendInTime - ModifyDuration) / ModifyBlendOutTime
-									   : 1;
-			BlendAlpha = CurrentRawBlendAlpha;
+			Layer.RawBlendAlpha = Layer.BlendOutTime > 0
+									  ? (Layer.ElapsedTime - Layer.BlendInTime - Layer.Duration) / Layer.BlendOutTime
+									  : 1;
+			BlendAlpha = Layer.RawBlendAlpha;
 		}
 		else
 		{
 			/** 如果是手动中断导致进入淡出，则统计 BlendOut 阶段经过时间 */
-			ModifyBlendOutElapsedTime += DeltaSeconds;
-			CurrentRawBlendAlpha = ModifyBlendOutTime > 0 ? ModifyBlendOutElapsedTime / ModifyBlendOutTime : 1;
-			BlendAlpha = CurrentRawBlendAlpha;
+			Layer.BlendOutElapsedTime += DeltaSeconds;
+			Layer.RawBlendAlpha = Layer.BlendOutTime > 0 ? Layer.BlendOutElapsedTime / Layer.BlendOutTime : 1;
+			BlendAlpha = Layer.RawBlendAlpha;
 		}
 	}
 
-	CurrentRawBlendAlpha = FMath::Clamp(CurrentRawBlendAlpha, 0, 1.);
-	BlendAlpha = FMath::Clamp(BlendAlpha, 0, 1.);
-	CurrentBlendState = BlendState;
+	Layer.RawBlendAlpha = FMath::Clamp(Layer.RawBlendAlpha, 0, 1.);
+	Layer.BlendState = BlendState;
 
-	// 更新相机臂最终臂长
-	UpdateArmLengthModifier(BlendState, BlendAlpha);
-	// 更新角色坐标系下的相机臂中心偏移
-	UpdateLocalArmCenterOffsetModifier(BlendState, BlendAlpha);
-	// 更新世界坐标系下面的相机臂中心偏移
-	UpdateWorldArmCenterOffsetModifier(BlendState, BlendAlpha);
-	// 更新相机臂旋转
-	UpdateArmRotationModifier(BlendState, BlendAlpha);
-	UpdateFovModifier(BlendState, BlendAlpha);
-
-	if (!bNeedManualBreakModify)
+	if (!Layer.bNeedManualBreak)
 	{
-		if (ModifyElapsedTime > ModifyBlendInTime + ModifyDuration + ModifyBlendOutTime)
+		if (Layer.ElapsedTime > Layer.BlendInTime + Layer.Duration + Layer.BlendOutTime)
 		{
-			EndModify();
-			ResetViewTarget();
+			Layer.bPendingEnd = true;
 		}
 	}
-	else if (ModifyBlendOutElapsedTime >= ModifyBlendOutTime)
+	else if (Layer.BlendOutElapsedTime >= Layer.BlendOutTime)
 	{
 		// 已经手动中断了修改过程，则结束修改
-		EndModify();
-		ResetViewTarget();
+		Layer.bPendingEnd = true;
 	}
+
+	return FMath::Clamp(BlendAlpha, 0, 1.);
 }
 
 void UJoyCameraModifierController::ApplyCameraModify_Immediately(const FCameraModifiers& InCameraModifiers)
@@ -394,18 +611,22 @@ void UJoyCameraModifierController::ApplyCameraModify_Immediately(const FCameraMo
 		TotalTime = TotalTime * (1.0 / Dilation);
 	}
 
-	ApplyCameraModify(TotalTime, 0, 0, InCameraModifiers);
+	const FCameraModifyHandle ModifyHandle = ApplyCameraModify(TotalTime, 0, 0, InCameraModifiers);
+	if (!ModifyHandle.IsValid())
+	{
+		return;
+	}
 
 	constexpr float ElapsedTime = 1.;
 	UpdateInternal(ElapsedTime);
 	if (CameraManager != nullptr)
 	{
 		// 强制将 DesiredCamera 同步到 CurrentCamera
-		FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
+		FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
 		TargetCameraInfo.CurrentCamera.CopyCamera(TargetCameraInfo.DesiredCamera);
-		CameraManager->UpdateActorTransform(1.);
+		CameraManager->UpdateActorTransform(TargetCameraInfo, UJoyGravityManageSubsystem::Get(GetWorld()));
 	}
-	EndModify();
+	EndModify(ModifyHandle);
 	ResetViewTarget();
 }
 
@@ -414,8 +635,55 @@ FCameraModifyHandle UJoyCameraModifierController::GetLastModifierHandle() const
 	return LastModifierHandle;
 }
 
+FCameraModifyHandle UJoyCameraModifierController::GetAllLayersHandle() const
+{
+	FCameraModifyHandle Handle(0);
+	Handle.OwnerGeneration = OwnerGeneration;
+	return Handle;
+}
+
 FCameraModifyHandle UJoyCameraModifierController::ApplyCameraModify(float Duration, float BlendInTime,
-	float BlendOutTime, FCameraModifiers const& InCameraModifiers, bool bNeedManualBreak)
+	float BlendOutTime, FCameraModifiers const& InCameraModifiers, bool bNeedManualBreak, int32 Priority,
+	EJoyCameraModifyBlendMode BlendMode)
+{
+	FJoyCameraModifyLayer Layer;
+	Layer.Spec.CameraModifiers = InCameraModifiers;
+	return PushModifyLayer(
+		MoveTemp(Layer), Duration, BlendInTime, BlendOutTime, bNeedManualBreak, Priority, BlendMode);
+}
+
+FCameraModifyHandle UJoyCameraModifierController::ApplyCameraPreset(const UJoyCameraModifierPreset* Preset,
+	float Duration, float BlendInTime, float BlendOutTime, bool bNeedManualBreak,
+	const FJoyCameraModifierPresetOverrides* Overrides)
+{
+	if (Preset == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("ApplyCameraPreset: Preset is null"));
+		return FCameraModifyHandle(0);
+	}
+
+	FJoyCameraModifyLayer Layer;
+	const bool bHasOverrides = Overrides != nullptr && Overrides->HasAnyOverride();
+	if (bHasOverrides || HasAdaptiveOption(Preset->CameraModifiers))
+	{
+		// 需要逐次修正的预设退化为拷贝
+		Layer.Spec.CameraModifiers = Preset->CameraModifiers;
+		if (bHasOverrides)
+		{
+			Overrides->ApplyTo(Layer.Spec.CameraModifiers);
+		}
+	}
+	else
+	{
+		Layer.Preset = Preset;
+	}
+
+	return PushModifyLayer(MoveTemp(Layer), Duration, BlendInTime, BlendOutTime, bNeedManualBreak,
+		Preset->Priority, Preset->BlendMode);
+}
+
+FCameraModifyHandle UJoyCameraModifierController::PushModifyLayer(FJoyCameraModifyLayer&& Layer, float Duration,
+	float BlendInTime, float BlendOutTime, bool bNeedManualBreak, int32 Priority, EJoyCameraModifyBlendMode BlendMode)
 {
 	if (CameraManager == nullptr)
 	{
@@ -429,126 +697,174 @@ FCameraModifyHandle UJoyCameraModifierController::ApplyCameraModify(float Durati
 		return FCameraModifyHandle(0);
 	}
 
-	// 如果存在状态混合，则终止
-	EndModify();
-	CurrentCameraModifySpec.Clear();
-
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	TargetCameraInfo.LastCamera.CopyCamera(TargetCameraInfo.CurrentCamera);
-	TargetCameraInfo.RestoreCamera.CopyCamera(TargetCameraInfo.CurrentCamera);
-	MakeRestoreCameraData(TargetCameraInfo.RestoreCamera);
+	// 被打断或移除的层在新层压入后再广播结束事件，避免回调在压栈过程中修改层栈
+	FEndedModifyHandles EndedHandles;
 
-	ModifyDuration = Duration >= 0 ? Duration : 0;
-	ModifyBlendInTime = BlendInTime;
-	ModifyBlendOutTime = BlendOutTime;
-	ModifyElapsedTime = 0.;
-	CurrentCameraModifySpec.CameraModifiers = InCameraModifiers;
-	PreProcessCameraModifiers(CurrentCameraModifySpec.CameraModifiers, this);
-
-	bNeedManualBreakModify = bNeedManualBreak;
-	bHasManualBreakModify = false;
-
-	bNeedModifyAdditionalArmLength =
-		!FMath::IsNearlyEqual(CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLengthAdditional, 0);
-	bNeedModifyAdditionalLocalCameraOffset =
-		!CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.LocalArmOffsetAdditional.IsNearlyZero();
-	bNeedModifyAdditionalCameraRotation =
-		!CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotationAdditional.IsNearlyZero();
-
-	bIsModified = true;
-	bResetViewTarget = CurrentCameraModifySpec.CameraModifiers.bResetViewTarget;
-	TimeToResetViewTarget = CurrentCameraModifySpec.CameraModifiers.TimeToResetViewTarget;
-	bNeedModifyFadeOut = false;
-	bIgnoreTimeDilation = CurrentCameraModifySpec.CameraModifiers.bIgnoreTimeDilation;
-
-	if (CurrentCameraModifySpec.CameraModifiers.bOverrideCameraInput)
+	// 同优先级的覆盖层互相打断
+	if (BlendMode == EJoyCameraModifyBlendMode::Override)
 	{
-		if (IsCameraRotationModified())
+		for (int32 LayerIndex = ModifyLayers.Num() - 1; LayerIndex >= 0; --LayerIndex)
 		{
-			// 锁定镜头旋转输入
-			CameraManager->SetArmPitchInputEnabled(false);
-			CameraManager->SetArmYawInputEnabled(false);
+			const FJoyCameraModifyLayer& ExistingLayer = ModifyLayers[LayerIndex];
+			if (ExistingLayer.Priority == Priority && ExistingLayer.BlendMode == EJoyCameraModifyBlendMode::Override)
+			{
+				EndLayer(LayerIndex, EndedHandles);
+			}
 		}
+	}
 
-		if (bNeedModifyAdditionalArmLength || CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bModified)
+	if (ModifyLayers.Num() >= MaxModifyLayers)
+	{
+		// 新层的优先级低于所有已有层时拒绝压入，否则移除优先级最低且最早压入的层
+		if (Priority < ModifyLayers[0].Priority)
 		{
-			// 锁定相机臂长修改
-			CameraManager->SetArmLengthInputEnabled(false);
+			UE_LOG(LogJoyCamera, Warning,
+				TEXT("ApplyCameraModify: %s 的修改层达到上限 %d，新层优先级 %d 低于已有层，不压入"),
+				*GetNameSafe(ModifiedViewTarget), MaxModifyLayers, Priority);
+			BroadcastModifyEnd(EndedHandles);
+			return FCameraModifyHandle(0);
 		}
 
-		// 锁定角色切换
-		if (auto* CharacterControlManager = UJoyCharacterControlManageSubsystem::Get(GetWorld()))
-		{
-			CharacterControlManager->SetCharacterSwitchEnabled(false);
-		}
+		UE_LOG(LogJoyCamera, Warning, TEXT("ApplyCameraModify: %s 的修改层达到上限 %d，移除优先级最低的层"),
+			*GetNameSafe(ModifiedViewTarget), MaxModifyLayers);
+		EndLayer(0, EndedHandles);
 	}
 
-	bNeedModifyFov = CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.bModified;
+	FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	if (ModifyLayers.Num() == 0)
+	{
+		// 层栈为空时以当前相机作为修改前的相机
+		TargetCameraInfo.LastCamera.CopyCamera(TargetCameraInfo.CurrentCamera);
+		MakeRestoreCameraData(TargetCameraInfo);
+		bNeedModifyFadeOut = false;
+	}
+
+	Layer.Priority = Priority;
+	Layer.BlendMode = BlendMode;
+	Layer.Duration = Duration >= 0 ? Duration : 0;
+	Layer.BlendInTime = BlendInTime;
+	Layer.BlendOutTime = BlendOutTime;
+	Layer.bNeedManualBreak = bNeedManualBreak;
+
+#if JOY_CAMERA_WITH_REPLAY
+	// 记录修正前的设置，回放时重新修正
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+	{
+		Recorder->RecordApplyCameraModify(ModifiedViewTarget.Get(), Duration, BlendInTime, BlendOutTime,
+			Layer.GetModifiers(), bNeedManualBreak, Priority, BlendMode, SequenceNumber + 1);
+	}
+#endif
+
+	if (Layer.Preset == nullptr)
+	{
+		PreProcessCameraModifiers(Layer.Spec.CameraModifiers, this);
+	}
+
+	const FCameraModifiers& Modifiers = Layer.GetModifiers();
+	Layer.bNeedModifyAdditionalArmLength = !FMath::IsNearlyEqual(Modifiers.ArmLengthSettings.ArmLengthAdditional, 0);
+	Layer.bNeedModifyAdditionalLocalCameraOffset = !Modifiers.LocalOffsetSettings.LocalArmOffsetAdditional.IsNearlyZero();
+	Layer.bNeedModifyAdditionalCameraRotation = !Modifiers.WorldRotationSettings.ArmRotationAdditional.IsNearlyZero();
+	Layer.bNeedModifyFov = Modifiers.CameraFovSettings.bModified;
+	CompileModifyProgram(Layer);
 
 	SequenceNumber++;
-	LastModifierHandle = FCameraModifyHandle(SequenceNumber);
+	Layer.Handle = FCameraModifyHandle(SequenceNumber);
+	Layer.Handle.OwnerGeneration = OwnerGeneration;
+	LastModifierHandle = Layer.Handle;
+	bIgnoreTimeDilation = Modifiers.bIgnoreTimeDilation;
 
-	return LastModifierHandle;
-}
+	// 插入到同优先级的层之后
+	const int32 InsertIndex = Algo::UpperBoundBy(ModifyLayers, Priority, &FJoyCameraModifyLayer::Priority);
+	ModifyLayers.Insert(MoveTemp(Layer), InsertIndex);
 
-bool UJoyCameraModifierController::IsCameraOffsetModified() const
-{
-	return bNeedModifyAdditionalLocalCameraOffset ||
-		   CurrentCameraModifySpec.CameraModifiers.WorldOffsetAdditionalSettings.bModified ||
-		   CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.bModified;
+	// 锁定镜头旋转、臂长输入与角色切换
+	RefreshInputOverride();
+
+	// 开始修改后加入活跃集合，直到修改与 Fade Out 都结束才会被移出
+	CameraManager->ActivateViewTarget(ViewTargetHandle);
+
+	// 回调中可能再次压入修改层并改写 LastModifierHandle
+	const FCameraModifyHandle NewHandle = LastModifierHandle;
+	BroadcastModifyEnd(EndedHandles);
+
+	return NewHandle;
 }
 
-bool UJoyCameraModifierController::IsCameraRotationModified() const
+void UJoyCameraModifierController::RefreshInputOverride()
 {
-	return bNeedModifyAdditionalCameraRotation ||
-		   CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified ||
-		   CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch ||
-		   CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw ||
-		   CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll;
+	bool bOverrideArmRotationInput = false;
+	bool bOverrideArmLengthInput = false;
+	bool bOverrideCharacterSwitch = false;
+	for (const FJoyCameraModifyLayer& Layer : ModifyLayers)
+	{
+		if (Layer.GetModifiers().bOverrideCameraInput)
+		{
+			bOverrideArmRotationInput |= Layer.IsCameraRotationModified();
+			bOverrideArmLengthInput |= Layer.IsArmLengthModified();
+			bOverrideCharacterSwitch = true;
+		}
+	}
+
+	if (bArmRotationInputOverridden != bOverrideArmRotationInput)
+	{
+		bArmRotationInputOverridden = bOverrideArmRotationInput;
+		CameraManager->SetArmPitchInputEnabled(!bOverrideArmRotationInput);
+		CameraManager->SetArmYawInputEnabled(!bOverrideArmRotationInput);
+	}
+
+	if (bArmLengthInputOverridden != bOverrideArmLengthInput)
+	{
+		bArmLengthInputOverridden = bOverrideArmLengthInput;
+		CameraManager->SetArmLengthInputEnabled(!bOverrideArmLengthInput);
+	}
+
+	if (bCharacterSwitchOverridden != bOverrideCharacterSwitch)
+	{
+		bCharacterSwitchOverridden = bOverrideCharacterSwitch;
+		if (auto* CharacterControlManager = UJoyCharacterControlManageSubsystem::Get(GetWorld()))
+		{
+			CharacterControlManager->SetCharacterSwitchEnabled(!bOverrideCharacterSwitch);
+		}
+	}
 }
 
-void UJoyCameraModifierController::StartModifyFadeOut()
+void UJoyCameraModifierController::StartModifyFadeOut(const FJoyCameraModifyLayer& Layer)
 {
+	const FCameraModifiers& Modifiers = Layer.GetModifiers();
+
 	// 检查是否需要复位 ArmLength
-	ModifyFadeOutData.bModifyArmLength =
-		CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bModified || bNeedModifyAdditionalArmLength;
-	if (ModifyFadeOutData.bModifyArmLength)
+	if (Layer.IsArmLengthModified())
 	{
-		ModifyFadeOutData.ArmLength = GetFinalArmLength();
+		ModifyFadeOutData.bModifyArmLength = true;
+		ModifyFadeOutData.ArmLength = GetFinalArmLength(Layer);
 	}
 
 	// 检查是否需要复位 ArmRotation
-	ModifyFadeOutData.bModifyArmPitch = CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch ||
-										CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified ||
-										bNeedModifyAdditionalCameraRotation;
-
-	ModifyFadeOutData.bModifyArmYaw = CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw ||
-									  CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified ||
-									  bNeedModifyAdditionalCameraRotation;
-
-	ModifyFadeOutData.bModifyArmRoll = CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll ||
-									   CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified ||
-									   bNeedModifyAdditionalCameraRotation;
-
-	if (ModifyFadeOutData.bModifyArmPitch || ModifyFadeOutData.bModifyArmYaw || ModifyFadeOutData.bModifyArmRoll)
+	const bool bModifyWorldRotation =
+		Modifiers.WorldRotationSettings.bModified || Layer.bNeedModifyAdditionalCameraRotation;
+	const bool bModifyArmPitch = Modifiers.LocalRotationSettings.bModifyPitch || bModifyWorldRotation;
+	const bool bModifyArmYaw = Modifiers.LocalRotationSettings.bModifyYaw || bModifyWorldRotation;
+	const bool bModifyArmRoll = Modifiers.LocalRotationSettings.bModifyRoll || bModifyWorldRotation;
+	if (bModifyArmPitch || bModifyArmYaw || bModifyArmRoll)
 	{
-		ModifyFadeOutData.ArmRotation = GetFinalArmRotation();
+		ModifyFadeOutData.bModifyArmPitch |= bModifyArmPitch;
+		ModifyFadeOutData.bModifyArmYaw |= bModifyArmYaw;
+		ModifyFadeOutData.bModifyArmRoll |= bModifyArmRoll;
+		ModifyFadeOutData.ArmRotation = GetFinalArmRotation(Layer);
 	}
 
 	// 检查是否需要复位 Fov
-	ModifyFadeOutData.bModifyFov = bNeedModifyFov;
-	if (ModifyFadeOutData.bModifyFov)
+	if (Layer.bNeedModifyFov)
 	{
+		ModifyFadeOutData.bModifyFov = true;
 		ModifyFadeOutData.Fov = CameraManager->GetBaseCameraFov();
 	}
 
-	ModifyFadeOutData.bModifyArmOffset =
-		CurrentCameraModifySpec.CameraModifiers.WorldOffsetAdditionalSettings.bModified ||
-		bNeedModifyAdditionalLocalCameraOffset;
-	if (ModifyFadeOutData.bModifyArmOffset)
+	if (Modifiers.WorldOffsetAdditionalSettings.bModified || Layer.bNeedModifyAdditionalLocalCameraOffset)
 	{
 		// 恢复世界坐标位移
-		ModifyFadeOutData.WorldCameraOffsetAdditional = GetFinalWorldArmOffset();
+		ModifyFadeOutData.bModifyArmOffset = true;
+		ModifyFadeOutData.WorldCameraOffsetAdditional = GetFinalWorldArmOffset(Layer);
 	}
 
 	bNeedModifyFadeOut = ModifyFadeOutData.bModifyArmLength | ModifyFadeOutData.bModifyArmPitch |
@@ -556,484 +872,483 @@ void UJoyCameraModifierController::StartModifyFadeOut()
 						 ModifyFadeOutData.bModifyFov;
 }
 
-void UJoyCameraModifierController::MakeRestoreCameraData(FVirtualCamera& RestoreCamera) const
+void UJoyCameraModifierController::MakeRestoreCameraData(FViewTargetCameraInfo& TargetCameraInfo) const
 {
 	// 不处理 Arm Length 恢复，因为它会默认恢复到基础臂长
 
 	// 处理 Arm Rotation 恢复
+	TargetCameraInfo.RestoreArmCenterRotation = FRotator3f(TargetCameraInfo.CurrentCamera.GetArmCenterRotation());
 	if (ModifyFadeOutData.bModifyArmPitch || ModifyFadeOutData.bModifyArmYaw || ModifyFadeOutData.bModifyArmRoll)
 	{
-		RestoreCamera.SetArmCenterRotation(ModifyFadeOutData.ArmRotation);
+		TargetCameraInfo.RestoreArmCenterRotation = FRotator3f(ModifyFadeOutData.ArmRotation);
 	}
 
 	// 不处理 Arm Fov 恢复，因为它会默认恢复到基础 Fov
 
 	// 不处理 Arm Local Offset 恢复，因为它会默认恢复基础局部偏移
 
-	// 处理 Arm World Offset
-	if (ModifyFadeOutData.bModifyArmOffset)
-	{
-		RestoreCamera.WorldArmOffsetAdditional = ModifyFadeOutData.WorldCameraOffsetAdditional;
-	}
+	// 不处理 Arm World Offset 恢复，它由 GetFinalWorldArmOffset 决定
 }
 
-void UJoyCameraModifierController::EndModify()
+void UJoyCameraModifierController::EndLayer(int32 LayerIndex, FEndedModifyHandles& OutEndedHandles)
 {
-	if (!bIsModified)
-	{
-		return;
-	}
+	const FJoyCameraModifyLayer Layer = MoveTemp(ModifyLayers[LayerIndex]);
+	ModifyLayers.RemoveAt(LayerIndex);
 
-	// 重新开启输入屏蔽
-	if (CurrentCameraModifySpec.CameraModifiers.bOverrideCameraInput)
-	{
-		// 恢复输入输出的禁用
-		if (IsCameraRotationModified())
-		{
-			CameraManager->SetArmPitchInputEnabled(true);
-			CameraManager->SetArmYawInputEnabled(true);
-		}
+	// 恢复不再被任何层屏蔽的输入
+	RefreshInputOverride();
 
-		if (bNeedModifyAdditionalArmLength || CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bModified)
-		{
-			CameraManager->SetArmLengthInputEnabled(true);
-		}
+	StartModifyFadeOut(Layer);
 
-		// 恢复角色切换
-		if (auto* CharacterControlManager = UJoyCharacterControlManageSubsystem::Get(GetWorld()))
-		{
-			CharacterControlManager->SetCharacterSwitchEnabled(true);
-		}
-	}
-
-	StartModifyFadeOut();
-
-	bNeedModifyAdditionalArmLength = false;
-	bNeedModifyAdditionalLocalCameraOffset = false;
-
-	if (/* CurrentCameraModifySpec.CameraModifiers.bIsModifiedArmRotation || */ bNeedModifyAdditionalCameraRotation)
+	if (ModifyLayers.Num() == 0)
 	{
-		bNeedModifyAdditionalCameraRotation = false;
-	}
-
-	bNeedModifyFov = false;
-
-	ModifyBlendOutElapsedTime = 0;
-	bNeedManualBreakModify = false;
-	bHasManualBreakModify = false;
+		bIgnoreTimeDilation = true;
 
-	bIsModified = false;
-	bIgnoreTimeDilation = true;
+		// 清空依赖数据
+		ExternalDependencyCameraData.Clean();
+	}
 
-	// 清空依赖数据
-	ExternalDependencyCameraData.Clean();
+	OutEndedHandles.Add(Layer.Handle);
+}
 
-	if (CameraManager)
+void UJoyCameraModifierController::BroadcastModifyEnd(const FEndedModifyHandles& EndedHandles) const
+{
+	if (EndedHandles.Num() == 0 || CameraManager == nullptr)
 	{
-		CameraManager->OnCameraModifyEndDelegate.Broadcast(ModifiedViewTarget, LastModifierHandle);
+		return;
 	}
-}
 
-void UJoyCameraModifierController::BreakModifier(FCameraModifyHandle ModifyHandler)
-{
-	if (!ModifyHandler.IsValid() || ModifyHandler == LastModifierHandle)
+	// 回调可能改变修改目标，先取出本次结束的层所属的目标
+	AActor* EndedViewTarget = ModifiedViewTarget.Get();
+	for (const FCameraModifyHandle& Handle : EndedHandles)
 	{
-		if (bNeedManualBreakModify && !bHasManualBreakModify)
-		{
-			bHasManualBreakModify = true;
-		}
+		CameraManager->OnCameraModifyEndDelegate.Broadcast(EndedViewTarget, Handle);
 	}
 }
 
-void UJoyCameraModifierController::UpdateFovModifier(EBlendState State, float Alpha)
+void UJoyCameraModifierController::EndModify(FCameraModifyHandle ModifyHandler)
 {
 	if (CameraManager == nullptr)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateFovModifier: PCM is null"));
-		return;
-	}
-
-	if (ModifiedViewTarget.Get() == nullptr)
-	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateFovModifier: ModifiedViewTarget is null"));
 		return;
 	}
 
-	if (!bNeedModifyFov)
+	if (!IsCurrentOwnerHandle(ModifyHandler))
 	{
+		UE_LOG(LogJoyCamera, Warning, TEXT("EndModify: 句柄 %lld 属于 Modifier 之前的所有者，已忽略"),
+			ModifyHandler.SequenceID);
 		return;
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-
-	if (CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.bCameraFovCurveControl &&
-		CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.CameraFovCurve != nullptr)
+	FEndedModifyHandles EndedHandles;
+	for (int32 LayerIndex = ModifyLayers.Num() - 1; LayerIndex >= 0; --LayerIndex)
 	{
-		if (State == EBlendState::BlendIn)
-		{
-			Alpha = UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-				CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.CameraFovCurve, CurrentRawBlendAlpha);
-		}
-		else if (State == EBlendState::BlendOut)
+		const FJoyCameraModifyLayer& Layer = ModifyLayers[LayerIndex];
+		if (!ModifyHandler.IsValid() || Layer.Handle == ModifyHandler)
 		{
-			Alpha = 1.0 - UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-							  CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.CameraFovCurve,
-							  1.0 - CurrentRawBlendAlpha);
-		}
-	}
+			if (Layer.GetModifiers().bResetViewTarget)
+			{
+				bResetViewTarget = true;
+				TimeToResetViewTarget = Layer.GetModifiers().TimeToResetViewTarget;
+			}
 
-	const float TargetFov = CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.CameraFov;
-	switch (State)
-	{
-		case EBlendState::BlendIn:
-			TargetCameraInfo.DesiredCamera.Fov = FMath::Lerp(TargetCameraInfo.LastCamera.Fov, TargetFov, Alpha);
-			break;
-		case EBlendState::Loop:
-			TargetCameraInfo.DesiredCamera.Fov = TargetFov;
-			break;
-		case EBlendState::BlendOut:
-			// TargetCameraInfo.DesiredCamera.Fov = FMath::Lerp(TargetFov, PCM->GetBaseCameraFov(), Alpha);
-			TargetCameraInfo.DesiredCamera.Fov = FMath::Lerp(TargetFov, GetFinalFov(), Alpha);
-			break;
-		default:
-			break;
+			EndLayer(LayerIndex, EndedHandles);
+		}
 	}
 
-	TargetCameraInfo.bCameraFov_HasModified = true;
+	BroadcastModifyEnd(EndedHandles);
 }
 
-void UJoyCameraModifierController::UpdateArmRotationModifier(EBlendState State, float Alpha)
+void UJoyCameraModifierController::BreakModifier(FCameraModifyHandle ModifyHandler)
 {
-	if (CameraManager == nullptr)
+	if (!IsCurrentOwnerHandle(ModifyHandler))
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateArmRotationModifier: PCM is null"));
+		UE_LOG(LogJoyCamera, Warning, TEXT("BreakModifier: 句柄 %lld 属于 Modifier 之前的所有者，已忽略"),
+			ModifyHandler.SequenceID);
 		return;
 	}
 
-	if (ModifiedViewTarget.Get() == nullptr)
+	bool bHasBreak = false;
+	for (FJoyCameraModifyLayer& Layer : ModifyLayers)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateArmRotationModifier: ModifiedViewTarget is null"));
-		return;
+		if ((!ModifyHandler.IsValid() || Layer.Handle == ModifyHandler) && Layer.bNeedManualBreak &&
+			!Layer.bHasManualBreak)
+		{
+			Layer.bHasManualBreak = true;
+			bHasBreak = true;
+		}
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	if (TargetCameraInfo.bArmYaw_HasModified || TargetCameraInfo.bArmPitch_HasModified ||
-		TargetCameraInfo.bArmRoll_HasModified)
+	if (!bHasBreak)
 	{
-		CurrentCameraModifySpec.bArmRotationModifyInterrupted = true;
+		return;
 	}
 
-	if (CurrentCameraModifySpec.bArmRotationModifyInterrupted)
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
 	{
-		return;
+		Recorder->RecordBreakModifier(ModifiedViewTarget.Get(), ModifyHandler.SequenceID);
 	}
+#endif
 
-	FRotator TargetArmRotator = FRotator::ZeroRotator;
-	bool bArmRotatorModified = true;
-	// 判断有没有修改相对 (Pitch, Yaw, Roll)
-	if (CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified)
-	{
-		// 修改相机臂旋转（世界坐标系）
-		TargetArmRotator = CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotation;
-		TargetCameraInfo.bArmYaw_HasModified = true;
-		TargetCameraInfo.bArmPitch_HasModified = true;
-		TargetCameraInfo.bArmRoll_HasModified = true;
-
-		if (CurrentCameraModifySpec.CameraModifiers.bArmRotationCurveControl &&
-			CurrentCameraModifySpec.CameraModifiers.ArmRotationCurve != nullptr)
-		{
-			if (State == EBlendState::BlendIn)
-			{
-				Alpha = UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-					CurrentCameraModifySpec.CameraModifiers.ArmRotationCurve, CurrentRawBlendAlpha);
-			}
-			else if (State == EBlendState::BlendOut)
-			{
-				Alpha = 1.0 - UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-								  CurrentCameraModifySpec.CameraModifiers.ArmRotationCurve, 1.0 - CurrentRawBlendAlpha);
-			}
-		}
-	}
-	else if (CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch ||
-			 CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw ||
-			 CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll)
+	// 等待手动中断期间不参与更新，可能已被移出活跃集合
+	if (CameraManager != nullptr)
 	{
-		/** 修改相机臂旋转（角色局部坐标系） */
-		if (State == EBlendState::BlendOut || (CameraManager != nullptr && CameraManager->bMoveInput))
-		{
-			// 进入 Blend Out 状态时，锁定依赖的角色朝向数据
-			ExternalDependencyCameraData.LockPawnFaceViewQuat();
-		}
+		CameraManager->ActivateViewTarget(ViewTargetHandle);
+	}
+}
 
-		const FQuat PawnFaceQuat =
-			ExternalDependencyCameraData.IsValid()
-				? ExternalDependencyCameraData.GetPawnFaceViewQuat()
-				: (ModifiedViewTarget.Get() != nullptr ? ModifiedViewTarget->GetActorRotation().Quaternion()
-													   : FRotator::ZeroRotator.Quaternion());
-
-		const FQuat AdderQuat = FRotator(CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch
-											 ? CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.Pitch
-											 : 0,
-			CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw
-				? CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.Yaw
-				: 0,
-			CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll
-				? CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.Roll
-				: 0)
-									.Quaternion();
-		TargetArmRotator = (PawnFaceQuat * AdderQuat).Rotator();
-
-		if (!CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch)
+void UJoyCameraModifierController::CompileModifyProgram(FJoyCameraModifyLayer& Layer) const
+{
+	const FCameraModifiers& Modifiers = Layer.GetModifiers();
+	FJoyCameraModifyProgram& Program = Layer.Program;
+	Program.Reset();
+
+	// 臂长
+	const FCameraArmLengthSettings& ArmLengthSettings = Modifiers.ArmLengthSettings;
+	if (ArmLengthSettings.bModified || Layer.bNeedModifyAdditionalArmLength)
+	{
+		Program.ActiveChannels |= EJoyCameraChannel::ArmLength;
+		Program.bArmLengthFromBase = !ArmLengthSettings.bModified;
+		Program.TargetArmLength = ArmLengthSettings.bModified ? ArmLengthSettings.ArmLength : 0.f;
+		if (Layer.bNeedModifyAdditionalArmLength)
 		{
-			TargetArmRotator.Pitch = TargetCameraInfo.LastCamera.ArmCenterRotation.Pitch;
+			Program.TargetArmLength += ArmLengthSettings.ArmLengthAdditional;
 		}
 
-		if (!CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw)
+		if (ArmLengthSettings.bArmLengthCurveControl)
 		{
-			TargetArmRotator.Yaw = TargetCameraInfo.LastCamera.ArmCenterRotation.Yaw;
+			Program.ArmLengthCurve = ArmLengthSettings.ArmLengthCurve;
+			Program.ArmLengthBakedCurve = FJoyCameraCurveCache::GetBakedCurve(Program.ArmLengthCurve);
 		}
+	}
 
-		if (!CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll)
+	// 局部偏移
+	const FCameraLocalOffsetSettings& LocalOffsetSettings = Modifiers.LocalOffsetSettings;
+	if (LocalOffsetSettings.bModified || Layer.bNeedModifyAdditionalLocalCameraOffset)
+	{
+		Program.ActiveChannels |= EJoyCameraChannel::Offset;
+		Program.bModifyLocalOffset = true;
+		Program.bLocalOffsetFromCameraManager = !LocalOffsetSettings.bModified;
+		Program.TargetLocalArmOffset =
+			LocalOffsetSettings.bModified ? LocalOffsetSettings.LocalArmOffset : FVector::ZeroVector;
+		if (Layer.bNeedModifyAdditionalLocalCameraOffset)
 		{
-			TargetArmRotator.Roll = TargetCameraInfo.LastCamera.ArmCenterRotation.Roll;
+			Program.TargetLocalArmOffset += LocalOffsetSettings.LocalArmOffsetAdditional;
 		}
-
-		TargetCameraInfo.bArmPitch_HasModified |=
-			CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch;
-		TargetCameraInfo.bArmYaw_HasModified |=
-			CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw;
-		TargetCameraInfo.bArmRoll_HasModified |=
-			CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll;
 	}
-	else
+
+	// 世界偏移
+	if (Modifiers.WorldOffsetAdditionalSettings.bModified)
 	{
-		// 不做改变
-		bArmRotatorModified = false;
-		TargetArmRotator = TargetCameraInfo.LastCamera.ArmCenterRotation;
+		Program.ActiveChannels |= EJoyCameraChannel::Offset;
+		Program.bModifyWorldOffset = true;
+		Program.TargetWorldArmOffset = Modifiers.WorldOffsetAdditionalSettings.WorldArmOffsetAdditional;
 	}
 
-	// 额外 Rotation
-	if (bNeedModifyAdditionalCameraRotation)
+	// 旋转
+	const FCameraLocalRotationSettings& LocalRotationSettings = Modifiers.LocalRotationSettings;
+	if (Modifiers.WorldRotationSettings.bModified)
 	{
-		// 在当前相机臂旋转的基础上，做旋转递增修改
-		TargetArmRotator += CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotationAdditional;
-
-		TargetCameraInfo.bArmPitch_HasModified |=
-			(CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotationAdditional.Pitch != 0);
-		TargetCameraInfo.bArmYaw_HasModified |=
-			(CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotationAdditional.Yaw != 0);
-		TargetCameraInfo.bArmRoll_HasModified |=
-			(CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.ArmRotationAdditional.Roll != 0);
+		Program.RotationSource = FJoyCameraModifyProgram::ERotationSource::World;
+		Program.TargetArmRotation = Modifiers.WorldRotationSettings.ArmRotation;
+		Program.ActiveChannels |= EJoyCameraChannel::Rotation;
+		if (Modifiers.bArmRotationCurveControl)
+		{
+			Program.ArmRotationCurve = Modifiers.ArmRotationCurve;
+			Program.ArmRotationBakedCurve = FJoyCameraCurveCache::GetBakedCurve(Program.ArmRotationCurve);
+		}
 	}
-	else if (!bArmRotatorModified)
+	else if (LocalRotationSettings.bModifyPitch || LocalRotationSettings.bModifyYaw ||
+			 LocalRotationSettings.bModifyRoll)
 	{
-		// 完全没有修改，则直接返回
-		return;
+		Program.RotationSource = FJoyCameraModifyProgram::ERotationSource::Local;
+		Program.LocalRotationAdder = FRotator(LocalRotationSettings.bModifyPitch ? LocalRotationSettings.Pitch : 0,
+			LocalRotationSettings.bModifyYaw ? LocalRotationSettings.Yaw : 0,
+			LocalRotationSettings.bModifyRoll ? LocalRotationSettings.Roll : 0)
+										 .Quaternion();
+		Program.LocalRotationChannels =
+			(LocalRotationSettings.bModifyPitch ? EJoyCameraChannel::Pitch : EJoyCameraChannel::None) |
+			(LocalRotationSettings.bModifyYaw ? EJoyCameraChannel::Yaw : EJoyCameraChannel::None) |
+			(LocalRotationSettings.bModifyRoll ? EJoyCameraChannel::Roll : EJoyCameraChannel::None);
+		Program.ActiveChannels |= Program.LocalRotationChannels;
 	}
 
-	// 初始化为目标位置
-	TargetCameraInfo.DesiredCamera.ArmCenterRotation = TargetArmRotator;
-	switch (State)
+	if (Layer.bNeedModifyAdditionalCameraRotation)
 	{
-		case EBlendState::BlendIn:
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation = FQuat::Slerp(
-				TargetCameraInfo.LastCamera.ArmCenterRotation.Quaternion(), TargetArmRotator.Quaternion(), Alpha)
-																   .Rotator();
-			break;
-		case EBlendState::Loop:
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation = TargetArmRotator;
-			break;
-		case EBlendState::BlendOut:
-			TargetCameraInfo.DesiredCamera.ArmCenterRotation =
-				FQuat::Slerp(TargetArmRotator.Quaternion(), GetFinalArmRotation().Quaternion(), Alpha).Rotator();
-			break;
-		default:
-			break;
+		const FRotator& ArmRotationAdditional = Modifiers.WorldRotationSettings.ArmRotationAdditional;
+		Program.bArmRotationAdditional = true;
+		Program.ArmRotationAdditional = ArmRotationAdditional;
+		Program.ActiveChannels |=
+			(ArmRotationAdditional.Pitch != 0 ? EJoyCameraChannel::Pitch : EJoyCameraChannel::None) |
+			(ArmRotationAdditional.Yaw != 0 ? EJoyCameraChannel::Yaw : EJoyCameraChannel::None) |
+			(ArmRotationAdditional.Roll != 0 ? EJoyCameraChannel::Roll : EJoyCameraChannel::None);
 	}
-}
 
-void UJoyCameraModifierController::UpdateLocalArmCenterOffsetModifier(EBlendState State, float Alpha) const
-{
-	if (CameraManager == nullptr)
+	// Fov
+	if (Layer.bNeedModifyFov)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateCameraOffsetModifier: PCM is null"));
-		return;
+		Program.ActiveChannels |= EJoyCameraChannel::Fov;
+		Program.TargetFov = Modifiers.CameraFovSettings.CameraFov;
+		if (Modifiers.CameraFovSettings.bCameraFovCurveControl)
+		{
+			Program.FovCurve = Modifiers.CameraFovSettings.CameraFovCurve;
+			Program.FovBakedCurve = FJoyCameraCurveCache::GetBakedCurve(Program.FovCurve);
+		}
 	}
+}
 
-	if (ModifiedViewTarget.Get() == nullptr)
-	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateCameraOffsetModifier: ModifiedViewTarget is null"));
-		return;
-	}
+void UJoyCameraModifierController::UpdateFovModifier(FViewTargetCameraInfo& TargetCameraInfo,
+	const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const
+{
+	const EBlendState State = Layer.BlendState;
+	Alpha = JoyCameraModifier::ApplyBlendCurve(
+		Layer.Program.FovCurve, Layer.Program.FovBakedCurve.Get(), State, Alpha, Layer.RawBlendAlpha);
 
-	if ((!CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.bModified &&
-			!bNeedModifyAdditionalLocalCameraOffset))
+	const bool bWritten = EnumHasAnyFlags(StackState.WrittenChannels, EJoyCameraChannel::Fov);
+	const float LastFov = TargetCameraInfo.LastCamera.GetFov();
+	const float FromFov = bWritten ? TargetCameraInfo.DesiredCamera.GetFov() : LastFov;
+	const float TargetFov = Layer.Program.TargetFov;
+	if (Layer.BlendMode == EJoyCameraModifyBlendMode::Additive)
 	{
-		return;
+		TargetCameraInfo.DesiredCamera.SetFov(
+			FromFov + (TargetFov - LastFov) * JoyCameraModifier::GetAdditiveWeight(State, Alpha));
 	}
-
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	FVector TargetCameraOffset = FVector::ZeroVector;
-	if (CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.bModified)
+	else if (State == EBlendState::BlendOut)
 	{
-		// 如果用户修改了 CameraOffset，则忽略当前的 CameraOffset 值，使用用户的 CameraOffset
-		TargetCameraOffset = CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.LocalArmOffset;
+		// 低优先级层仍在修改时淡出到其结果，否则淡出到修改结束后的值
+		TargetCameraInfo.DesiredCamera.SetFov(FMath::Lerp(TargetFov, bWritten ? FromFov : GetFinalFov(Layer), Alpha));
 	}
 	else
 	{
-		TargetCameraOffset = FVector(CameraManager->ArmCenterOffsetX, CameraManager->ArmCenterOffsetY, CameraManager->ArmCenterOffsetZ);
+		TargetCameraInfo.DesiredCamera.SetFov(JoyCameraModifier::BlendOverride(State, Alpha, FromFov, TargetFov));
 	}
 
-	// 额外 CameraOffset
-	if (bNeedModifyAdditionalLocalCameraOffset)
+	StackState.WrittenChannels |= EJoyCameraChannel::Fov;
+}
+
+void UJoyCameraModifierController::UpdateArmRotationModifier(FViewTargetCameraInfo& TargetCameraInfo,
+	FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState)
+{
+	if (StackState.bRotationInterrupted)
 	{
-		TargetCameraOffset += CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.LocalArmOffsetAdditional;
+		Layer.Spec.bArmRotationModifyInterrupted = true;
 	}
 
-	switch (State)
+	if (Layer.Spec.bArmRotationModifyInterrupted)
 	{
-		case EBlendState::BlendIn:
-			// 从 LastCamera 状态开始 Blend
-			TargetCameraInfo.DesiredCamera.LocalArmCenterOffset =
-				FMath::Lerp(TargetCameraInfo.LastCamera.LocalArmCenterOffset, TargetCameraOffset, Alpha);
-			break;
-		case EBlendState::Loop:
-			TargetCameraInfo.DesiredCamera.LocalArmCenterOffset = TargetCameraOffset;
+		return;
+	}
+
+	const EBlendState State = Layer.BlendState;
+	const FJoyCameraModifyProgram& Program = Layer.Program;
+	const bool bWritten = EnumHasAnyFlags(StackState.WrittenChannels, EJoyCameraChannel::Rotation);
+	const FRotator LastArmRotator = TargetCameraInfo.LastCamera.GetArmCenterRotation();
+	const FRotator FromArmRotator = bWritten ? TargetCameraInfo.DesiredCamera.GetArmCenterRotation() : LastArmRotator;
+
+	// 叠加层以修改前的相机计算目标值，覆盖层以低优先级层的结果计算目标值
+	const FRotator BaseArmRotator =
+		Layer.BlendMode == EJoyCameraModifyBlendMode::Additive ? LastArmRotator : FromArmRotator;
+
+	FRotator TargetArmRotator = FRotator::ZeroRotator;
+	switch (Program.RotationSource)
+	{
+		case FJoyCameraModifyProgram::ERotationSource::World:
+		{
+			// 修改相机臂旋转（世界坐标系）
+			TargetArmRotator = Program.TargetArmRotation;
+			Alpha = JoyCameraModifier::ApplyBlendCurve(
+				Program.ArmRotationCurve, Program.ArmRotationBakedCurve.Get(), State, Alpha, Layer.RawBlendAlpha);
 			break;
-		case EBlendState::BlendOut:
-			/** CameraOffset 默认还原到基础 Offset */
-			TargetCameraInfo.DesiredCamera.LocalArmCenterOffset =
-				FMath::Lerp(TargetCameraOffset, GetFinalLocalArmOffset(), Alpha);
+		}
+		case FJoyCameraModifyProgram::ERotationSource::Local:
+		{
+			/** 修改相机臂旋转（角色局部坐标系） */
+			if (State == EBlendState::BlendOut || CameraManager->bMoveInput)
+			{
+				// 进入 Blend Out 状态时，锁定依赖的角色朝向数据
+				ExternalDependencyCameraData.LockPawnFaceViewQuat();
+			}
+
+			const FQuat PawnFaceQuat = ExternalDependencyCameraData.IsValid()
+										   ? ExternalDependencyCameraData.GetPawnFaceViewQuat()
+										   : ModifiedViewTarget->GetActorRotation().Quaternion();
+			TargetArmRotator = (PawnFaceQuat * Program.LocalRotationAdder).Rotator();
+
+			if (!EnumHasAnyFlags(Program.LocalRotationChannels, EJoyCameraChannel::Pitch))
+			{
+				TargetArmRotator.Pitch = BaseArmRotator.Pitch;
+			}
+
+			if (!EnumHasAnyFlags(Program.LocalRotationChannels, EJoyCameraChannel::Yaw))
+			{
+				TargetArmRotator.Yaw = BaseArmRotator.Yaw;
+			}
+
+			if (!EnumHasAnyFlags(Program.LocalRotationChannels, EJoyCameraChannel::Roll))
+			{
+				TargetArmRotator.Roll = BaseArmRotator.Roll;
+			}
 			break;
+		}
 		default:
+			// 不做改变
+			TargetArmRotator = BaseArmRotator;
 			break;
 	}
 
-	TargetCameraInfo.bCameraOffset_HasModified = true;
-}
-
-void UJoyCameraModifierController::UpdateWorldArmCenterOffsetModifier(EBlendState State, float Alpha) const
-{
-	if (CameraManager == nullptr)
+	// 额外 Rotation，在当前相机臂旋转的基础上，做旋转递增修改
+	if (Program.bArmRotationAdditional)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateWorldArmCenterOffsetModifier: PCM is null"));
-		return;
+		TargetArmRotator += Program.ArmRotationAdditional;
 	}
 
-	if (ModifiedViewTarget.Get() == nullptr)
-	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateWorldArmCenterOffsetModifier: ModifiedViewTarget is null"));
-		return;
-	}
+	StackState.WrittenChannels |= Program.ActiveChannels & EJoyCameraChannel::Rotation;
 
-	if (!CurrentCameraModifySpec.CameraModifiers.WorldOffsetAdditionalSettings.bModified)
+	if (Layer.BlendMode == EJoyCameraModifyBlendMode::Additive)
 	{
+		const FRotator DeltaArmRotator = (TargetArmRotator - LastArmRotator).GetNormalized();
+		TargetCameraInfo.DesiredCamera.SetArmCenterRotation(
+			FromArmRotator + DeltaArmRotator * JoyCameraModifier::GetAdditiveWeight(State, Alpha));
 		return;
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	const FVector TargetWorldArmOffsetAdditional =
-		CurrentCameraModifySpec.CameraModifiers.WorldOffsetAdditionalSettings.WorldArmOffsetAdditional;
+	// 初始化为目标位置
+	TargetCameraInfo.DesiredCamera.SetArmCenterRotation(TargetArmRotator);
 	switch (State)
 	{
 		case EBlendState::BlendIn:
-			// 从 LastCamera 状态开始 Blend
-			TargetCameraInfo.DesiredCamera.WorldArmOffsetAdditional = FMath::Lerp(
-				TargetCameraInfo.LastCamera.WorldArmOffsetAdditional, TargetWorldArmOffsetAdditional, Alpha);
+			TargetCameraInfo.DesiredCamera.SetArmCenterRotation(
+				FQuat::Slerp(FromArmRotator.Quaternion(), TargetArmRotator.Quaternion(), Alpha).Rotator());
 			break;
 		case EBlendState::Loop:
-			TargetCameraInfo.DesiredCamera.WorldArmOffsetAdditional = TargetWorldArmOffsetAdditional;
+			TargetCameraInfo.DesiredCamera.SetArmCenterRotation(TargetArmRotator);
 			break;
 		case EBlendState::BlendOut:
-			/** World Camera Offset 默认还原到 0 */
-			TargetCameraInfo.DesiredCamera.WorldArmOffsetAdditional =
-				FMath::Lerp(TargetWorldArmOffsetAdditional, GetFinalWorldArmOffset(), Alpha);
+		{
+			// 低优先级层仍在修改时淡出到其结果，否则淡出到修改结束后的值
+			const FRotator ToArmRotator = bWritten ? FromArmRotator : GetFinalArmRotation(Layer);
+			TargetCameraInfo.DesiredCamera.SetArmCenterRotation(
+				FQuat::Slerp(TargetArmRotator.Quaternion(), ToArmRotator.Quaternion(), Alpha).Rotator());
 			break;
+		}
 		default:
 			break;
 	}
-
-	TargetCameraInfo.bCameraOffset_HasModified = true;
 }
 
-void UJoyCameraModifierController::UpdateArmLengthModifier(EBlendState State, float Alpha)
+void UJoyCameraModifierController::UpdateLocalArmCenterOffsetModifier(FViewTargetCameraInfo& TargetCameraInfo,
+	const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const
 {
-	if (CameraManager == nullptr)
+	const EBlendState State = Layer.BlendState;
+	FVector TargetCameraOffset = Layer.Program.TargetLocalArmOffset;
+	if (Layer.Program.bLocalOffsetFromCameraManager)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateArmLengthModifier: PCM is null"));
-		return;
+		// 没有设置 CameraOffset 时在当前基础 CameraOffset 上叠加额外偏移
+		TargetCameraOffset += FVector(
+			CameraManager->ArmCenterOffsetX, CameraManager->ArmCenterOffsetY, CameraManager->ArmCenterOffsetZ);
 	}
 
-	if (ModifiedViewTarget.Get() == nullptr)
+	const FVector LastCameraOffset = TargetCameraInfo.LastCamera.GetLocalArmCenterOffset();
+	const FVector FromCameraOffset =
+		StackState.bLocalOffsetWritten ? TargetCameraInfo.DesiredCamera.GetLocalArmCenterOffset() : LastCameraOffset;
+	if (Layer.BlendMode == EJoyCameraModifyBlendMode::Additive)
 	{
-		UE_LOG(LogJoyCamera, Error, TEXT("UpdateArmLengthModifier: ModifiedViewTarget is null"));
-		return;
+		TargetCameraInfo.DesiredCamera.SetLocalArmCenterOffset(FromCameraOffset +
+			(TargetCameraOffset - LastCameraOffset) * JoyCameraModifier::GetAdditiveWeight(State, Alpha));
 	}
-
-	if ((!CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bModified && !bNeedModifyAdditionalArmLength))
+	else if (State == EBlendState::BlendOut)
 	{
-		return;
+		/** CameraOffset 默认还原到基础 Offset */
+		TargetCameraInfo.DesiredCamera.SetLocalArmCenterOffset(FMath::Lerp(TargetCameraOffset,
+			StackState.bLocalOffsetWritten ? FromCameraOffset : GetFinalLocalArmOffset(Layer), Alpha));
+	}
+	else
+	{
+		// 从 LastCamera 或低优先级层的结果开始 Blend
+		TargetCameraInfo.DesiredCamera.SetLocalArmCenterOffset(
+			JoyCameraModifier::BlendOverride(State, Alpha, FromCameraOffset, TargetCameraOffset));
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	float TargetArmLength = 0;
-	if (CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bModified)
+	StackState.bLocalOffsetWritten = true;
+	StackState.WrittenChannels |= EJoyCameraChannel::Offset;
+}
+
+void UJoyCameraModifierController::UpdateWorldArmCenterOffsetModifier(FViewTargetCameraInfo& TargetCameraInfo,
+	const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const
+{
+	const EBlendState State = Layer.BlendState;
+	const FVector& TargetWorldArmOffsetAdditional = Layer.Program.TargetWorldArmOffset;
+	const FVector LastWorldArmOffsetAdditional = TargetCameraInfo.LastCamera.GetWorldArmOffsetAdditional();
+	const FVector FromWorldArmOffsetAdditional = StackState.bWorldOffsetWritten
+													 ? TargetCameraInfo.DesiredCamera.GetWorldArmOffsetAdditional()
+													 : LastWorldArmOffsetAdditional;
+	if (Layer.BlendMode == EJoyCameraModifyBlendMode::Additive)
 	{
-		// 改动 ArmLength 的基础长度
-		TargetArmLength = CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLength;
+		TargetCameraInfo.DesiredCamera.SetWorldArmOffsetAdditional(FromWorldArmOffsetAdditional +
+			(TargetWorldArmOffsetAdditional - LastWorldArmOffsetAdditional) *
+				JoyCameraModifier::GetAdditiveWeight(State, Alpha));
 	}
-	else
+	else if (State == EBlendState::BlendOut)
 	{
-		// 目标基础臂长设置为 Blend 启动之前的基础臂长
-		TargetArmLength = TargetCameraInfo.LastCamera.ArmLength;
+		/** World Camera Offset 默认还原到 0 */
+		TargetCameraInfo.DesiredCamera.SetWorldArmOffsetAdditional(FMath::Lerp(TargetWorldArmOffsetAdditional,
+			StackState.bWorldOffsetWritten ? FromWorldArmOffsetAdditional : GetFinalWorldArmOffset(Layer), Alpha));
 	}
-
-	if (bNeedModifyAdditionalArmLength)
+	else
 	{
-		// 检查是否要在基础比场上递增/递减
-		TargetArmLength += CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLengthAdditional;
+		// 从 LastCamera 或低优先级层的结果开始 Blend
+		TargetCameraInfo.DesiredCamera.SetWorldArmOffsetAdditional(JoyCameraModifier::BlendOverride(
+			State, Alpha, FromWorldArmOffsetAdditional, TargetWorldArmOffsetAdditional));
 	}
 
-	if (CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bArmLengthCurveControl &&
-		CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLengthCurve != nullptr)
+	StackState.bWorldOffsetWritten = true;
+	StackState.WrittenChannels |= EJoyCameraChannel::Offset;
+}
+
+void UJoyCameraModifierController::UpdateArmLengthModifier(FViewTargetCameraInfo& TargetCameraInfo,
+	const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const
+{
+	const EBlendState State = Layer.BlendState;
+	Alpha = JoyCameraModifier::ApplyBlendCurve(
+		Layer.Program.ArmLengthCurve, Layer.Program.ArmLengthBakedCurve.Get(), State, Alpha, Layer.RawBlendAlpha);
+
+	const bool bWritten = EnumHasAnyFlags(StackState.WrittenChannels, EJoyCameraChannel::ArmLength);
+	const float LastArmLength = TargetCameraInfo.LastCamera.GetArmLength();
+	const float FromArmLength = bWritten ? TargetCameraInfo.DesiredCamera.GetArmLength() : LastArmLength;
+	if (Layer.BlendMode == EJoyCameraModifyBlendMode::Additive)
+	{
+		// 叠加层以修改前的相机计算变化量
+		const float TargetArmLength =
+			Layer.Program.TargetArmLength + (Layer.Program.bArmLengthFromBase ? LastArmLength : 0.f);
+		TargetCameraInfo.DesiredCamera.SetArmLength(FMath::Clamp(
+			FromArmLength + (TargetArmLength - LastArmLength) * JoyCameraModifier::GetAdditiveWeight(State, Alpha),
+			CameraManager->MinArmLength, CameraManager->MaxArmLength));
+	}
+	else
 	{
-		if (State == EBlendState::BlendIn)
+		// 目标基础臂长设置为 Blend 启动之前的基础臂长
+		float TargetArmLength =
+			Layer.Program.TargetArmLength + (Layer.Program.bArmLengthFromBase ? FromArmLength : 0.f);
+		TargetArmLength = FMath::Clamp(TargetArmLength, CameraManager->MinArmLength, CameraManager->MaxArmLength);
+		if (State == EBlendState::BlendOut)
 		{
-			Alpha = UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-				CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLengthCurve, CurrentRawBlendAlpha);
+			// 在目标臂长和 Blend 完毕之后的相机基础臂长之间进行插值
+			TargetCameraInfo.DesiredCamera.SetArmLength(
+				FMath::Lerp(TargetArmLength, bWritten ? FromArmLength : GetFinalArmLength(Layer), Alpha));
 		}
-		else if (State == EBlendState::BlendOut)
+		else
 		{
-			Alpha = 1.0 - UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(
-							  CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.ArmLengthCurve,
-							  1.0 - CurrentRawBlendAlpha);
-		}
-	}
-
-	TargetArmLength = FMath::Clamp(TargetArmLength, CameraManager->MinArmLength, CameraManager->MaxArmLength);
-	switch (State)
-	{
-		case EBlendState::BlendIn:
 			// 在 Blend 开始之前的相机基础臂长上进行插值
-			TargetCameraInfo.DesiredCamera.ArmLength =
-				FMath::Lerp(TargetCameraInfo.LastCamera.ArmLength, TargetArmLength, Alpha);
-			break;
-		case EBlendState::Loop:
-			// 位于 Duration 期间，无需插值
-			TargetCameraInfo.DesiredCamera.ArmLength = TargetArmLength;
-			break;
-		case EBlendState::BlendOut:
-			// 在目标臂长和 Blend 完毕之后的相机基础臂长之间进行插值
-			TargetCameraInfo.DesiredCamera.ArmLength = FMath::Lerp(TargetArmLength, GetFinalArmLength(), Alpha);
-			break;
-		default:
-			break;
+			TargetCameraInfo.DesiredCamera.SetArmLength(
+				JoyCameraModifier::BlendOverride(State, Alpha, FromArmLength, TargetArmLength));
+		}
 	}
 
-	TargetCameraInfo.bCameraArmLength_HasModified = true;
+	StackState.WrittenChannels |= EJoyCameraChannel::ArmLength;
 }
 
-float UJoyCameraModifierController::GetFinalFov() const
+float UJoyCameraModifierController::GetFinalFov(const FJoyCameraModifyLayer& Layer) const
 {
 	if (CameraManager == nullptr)
 	{
@@ -1041,18 +1356,18 @@ float UJoyCameraModifierController::GetFinalFov() const
 		return 90;
 	}
 
-	if (CurrentCameraModifySpec.CameraModifiers.CameraFovSettings.bReset)
+	if (Layer.GetModifiers().CameraFovSettings.bReset)
 	{
 		return CameraManager->GetBaseCameraFov();
 	}
 	else
 	{
-		const FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-		return TargetCameraInfo.CurrentCamera.Fov;
+		const FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+		return TargetCameraInfo.CurrentCamera.GetFov();
 	}
 }
 
-FRotator UJoyCameraModifierController::GetFinalArmRotation()
+FRotator UJoyCameraModifierController::GetFinalArmRotation(const FJoyCameraModifyLayer& Layer) const
 {
 	if (CameraManager == nullptr)
 	{
@@ -1066,49 +1381,49 @@ FRotator UJoyCameraModifierController::GetFinalArmRotation()
 		return FRotator::ZeroRotator;
 	}
 
-	FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	if (CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bModified)
+	const FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	if (Layer.GetModifiers().WorldRotationSettings.bModified)
 	{
 		// 修改了世界坐标系旋转，检查是否需要复位
-		if (CurrentCameraModifySpec.CameraModifiers.WorldRotationSettings.bReset)
+		if (Layer.GetModifiers().WorldRotationSettings.bReset)
 		{
 			// 是否要还原相机弹簧臂方向
-			return TargetCameraInfo.RestoreCamera.ArmCenterRotation;
+			return FRotator(TargetCameraInfo.RestoreArmCenterRotation);
 		}
 	}
-	else if (CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyPitch ||
-			 CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyYaw ||
-			 CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bModifyRoll)
+	else if (Layer.GetModifiers().LocalRotationSettings.bModifyPitch ||
+			 Layer.GetModifiers().LocalRotationSettings.bModifyYaw ||
+			 Layer.GetModifiers().LocalRotationSettings.bModifyRoll)
 	{
 		// 修改了角色坐标系旋转，检查要复位哪一项 (Pitch, Yaw, Roll ?)
-		FRotator FinalRotator = TargetCameraInfo.DesiredCamera.ArmCenterRotation;
-		if (CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bResetPitch)
+		FRotator FinalRotator = TargetCameraInfo.DesiredCamera.GetArmCenterRotation();
+		if (Layer.GetModifiers().LocalRotationSettings.bResetPitch)
 		{
 			// 复位 Pitch
-			FinalRotator.Pitch = TargetCameraInfo.RestoreCamera.ArmCenterRotation.Pitch;
+			FinalRotator.Pitch = TargetCameraInfo.RestoreArmCenterRotation.Pitch;
 		}
 
-		if (CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bResetYaw)
+		if (Layer.GetModifiers().LocalRotationSettings.bResetYaw)
 		{
 			// 复位 Yaw
-			FinalRotator.Yaw = TargetCameraInfo.RestoreCamera.ArmCenterRotation.Yaw;
+			FinalRotator.Yaw = TargetCameraInfo.RestoreArmCenterRotation.Yaw;
 		}
 
-		if (CurrentCameraModifySpec.CameraModifiers.LocalRotationSettings.bResetRoll)
+		if (Layer.GetModifiers().LocalRotationSettings.bResetRoll)
 		{
 			// 复位 Roll，且要复位到 0
 			// FinalRotator.Roll = 0;
-			FinalRotator.Roll = TargetCameraInfo.RestoreCamera.ArmCenterRotation.Roll;
+			FinalRotator.Roll = TargetCameraInfo.RestoreArmCenterRotation.Roll;
 		}
 
 		return FinalRotator;
 	}
 
 	// 不还原相机臂，直接采用当前相机臂方向
-	return TargetCameraInfo.DesiredCamera.ArmCenterRotation;
+	return TargetCameraInfo.DesiredCamera.GetArmCenterRotation();
 }
 
-FVector UJoyCameraModifierController::GetFinalWorldArmOffset() const
+FVector UJoyCameraModifierController::GetFinalWorldArmOffset(const FJoyCameraModifyLayer& Layer) const
 {
 	if (CameraManager == nullptr)
 	{
@@ -1122,17 +1437,17 @@ FVector UJoyCameraModifierController::GetFinalWorldArmOffset() const
 		return FVector::ZeroVector;
 	}
 
-	if (CurrentCameraModifySpec.CameraModifiers.WorldOffsetAdditionalSettings.bReset)
+	if (Layer.GetModifiers().WorldOffsetAdditionalSettings.bReset)
 	{
 		return FVector::ZeroVector;
 	}
 
 	// 不还原相机臂中心偏移
-	const FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	return TargetCameraInfo.CurrentCamera.WorldArmOffsetAdditional;
+	const FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	return TargetCameraInfo.CurrentCamera.GetWorldArmOffsetAdditional();
 }
 
-FVector UJoyCameraModifierController::GetFinalLocalArmOffset() const
+FVector UJoyCameraModifierController::GetFinalLocalArmOffset(const FJoyCameraModifyLayer& Layer) const
 {
 	if (CameraManager == nullptr)
 	{
@@ -1146,17 +1461,17 @@ FVector UJoyCameraModifierController::GetFinalLocalArmOffset() const
 		return FVector::ZeroVector;
 	}
 
-	if (CurrentCameraModifySpec.CameraModifiers.LocalOffsetSettings.bReset)
+	if (Layer.GetModifiers().LocalOffsetSettings.bReset)
 	{
 		return CameraManager->GetBaseLocalArmOffset();
 	}
 
 	// 不还原相机偏移
-	const FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	return TargetCameraInfo.CurrentCamera.LocalArmCenterOffset;
+	const FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	return TargetCameraInfo.CurrentCamera.GetLocalArmCenterOffset();
 }
 
-float UJoyCameraModifierController::GetFinalArmLength() const
+float UJoyCameraModifierController::GetFinalArmLength(const FJoyCameraModifyLayer& Layer) const
 {
 	if (CameraManager == nullptr)
 	{
@@ -1170,15 +1485,15 @@ float UJoyCameraModifierController::GetFinalArmLength() const
 		return 0;
 	}
 
-	if (CurrentCameraModifySpec.CameraModifiers.ArmLengthSettings.bReset)
+	if (Layer.GetModifiers().ArmLengthSettings.bReset)
 	{
 		// 如果要还原 ArmLength，则还原到基础臂长
 		return CameraManager->GetBaseArmLength();
 	}
 
 	// 不还原相机臂长
-	const FViewTargetCameraInfo& TargetCameraInfo = CameraManager->MultiViewTargetCameraManager[ModifiedViewTarget.Get()];
-	return TargetCameraInfo.CurrentCamera.ArmLength;
+	const FViewTargetCameraInfo& TargetCameraInfo = GetModifyTargetCameraInfo();
+	return TargetCameraInfo.CurrentCamera.GetArmLength();
 }
 
 void UJoyCameraModifierController::ResetViewTarget()
@@ -1193,7 +1508,7 @@ void UJoyCameraModifierController::ResetViewTarget()
 			{
 				// 需要复原 ViewTarget，为了保证复原过程中方向不变，需要重置 Controller 方向
 				auto* JoyPlayerController = UJoyGameBlueprintLibrary::GetJoyPlayerController(GetWorld());
-				auto* JoyCamera = UJoyCameraComponent::FindCameraComponent(CurrentViewTarget);
+				auto* JoyCamera = CameraManager->FindViewTargetCamera(CurrentViewTarget);
 				if (JoyPlayerController && JoyCamera)
 				{
 					// 在进行 SetViewTarget 之前冻结相机，不允许修改镜头，避免切换过程中出现抖动
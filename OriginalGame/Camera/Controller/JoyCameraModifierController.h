@@ -1,9 +1,14 @@
 ﻿#pragma once
 #include "JoyCameraControllerBase.h"
+#include "Camera/Controller/JoyCameraMeta.h"
+#include "Camera/JoyViewTargetCameraHandle.h"
 
 #include "JoyCameraModifierController.generated.h"
 
-struct FVirtualCamera;
+struct FViewTargetCameraInfo;
+struct FJoyCameraModifierPresetOverrides;
+struct FJoyBakedCurve;
+class UJoyCameraModifierPreset;
 
 USTRUCT(BlueprintType)
 struct FCameraAdaptiveOption
@@ -351,6 +356,10 @@ struct FCameraModifyHandle
 
 	UPROPERTY()
 	int64 SequenceID{};
+
+	// 压入修改层时 Modifier 的所有者代数，0 表示不校验
+	UPROPERTY()
+	uint32 OwnerGeneration{0};
 };
 
 USTRUCT()
@@ -368,6 +377,178 @@ struct FCameraModifySpec
 	}
 };
 
+/**
+ * 由 FCameraModifiers 编译得到的扁平修改程序
+ *
+ * ApplyCameraModify 时根据修改设置编译一次：记录需要执行的通道，预先算好目标值与曲线，
+ * 每帧只执行 ActiveChannels 中的通道，不再逐项判断嵌套的设置结构。
+ * 修改前的值取自低优先级层的结果或 LastCamera，在修改期间会变化，仍在每帧读取。
+ */
+struct FJoyCameraModifyProgram
+{
+	enum class ERotationSource : uint8
+	{
+		// 不修改基础旋转，只叠加额外旋转
+		None,
+		// 世界坐标系旋转
+		World,
+		// 角色局部坐标系旋转
+		Local,
+	};
+
+	// 本次修改需要执行的通道
+	EJoyCameraChannel ActiveChannels = EJoyCameraChannel::None;
+
+	// 局部偏移与世界偏移共用 Offset 通道，分别记录
+	bool bModifyLocalOffset = false;
+
+	bool bModifyWorldOffset = false;
+
+	// 目标臂长是否以修改前的臂长为基础
+	bool bArmLengthFromBase = false;
+
+	// 目标臂长（以修改前的臂长为基础时只记录增量）
+	float TargetArmLength = 0.f;
+
+	UCurveFloat* ArmLengthCurve = nullptr;
+
+	// 曲线的烘焙结果在编译时取得，每帧直接求值
+	TSharedPtr<const FJoyBakedCurve> ArmLengthBakedCurve;
+
+	// 目标局部偏移是否以 PlayerCameraManager 的基础偏移为基础
+	bool bLocalOffsetFromCameraManager = false;
+
+	// 目标局部偏移（以基础偏移为基础时只记录增量）
+	FVector TargetLocalArmOffset = FVector::ZeroVector;
+
+	FVector TargetWorldArmOffset = FVector::ZeroVector;
+
+	float TargetFov = 0.f;
+
+	UCurveFloat* FovCurve = nullptr;
+
+	TSharedPtr<const FJoyBakedCurve> FovBakedCurve;
+
+	ERotationSource RotationSource = ERotationSource::None;
+
+	// 世界坐标系下的目标旋转
+	FRotator TargetArmRotation = FRotator::ZeroRotator;
+
+	// 角色局部坐标系下叠加的旋转
+	FQuat LocalRotationAdder = FQuat::Identity;
+
+	// 角色局部坐标系下修改的轴，其余轴保持修改前的值
+	EJoyCameraChannel LocalRotationChannels = EJoyCameraChannel::None;
+
+	bool bArmRotationAdditional = false;
+
+	FRotator ArmRotationAdditional = FRotator::ZeroRotator;
+
+	UCurveFloat* ArmRotationCurve = nullptr;
+
+	TSharedPtr<const FJoyBakedCurve> ArmRotationBakedCurve;
+
+	void Reset()
+	{
+		*this = FJoyCameraModifyProgram();
+	}
+};
+
+UENUM(BlueprintType)
+enum class EJoyCameraModifyBlendMode : uint8
+{
+	// 在低优先级层的结果与自身目标值之间混合
+	Override UMETA(DisplayName = "覆盖"),
+	// 将自身相对修改前相机的变化量按混合权重叠加到低优先级层的结果上
+	Additive UMETA(DisplayName = "叠加"),
+};
+
+/**
+ * 修改层，每次 ApplyCameraModify 生成一层，拥有独立的句柄、时间轴与修改程序
+ */
+struct FJoyCameraModifyLayer
+{
+	FCameraModifyHandle Handle{0};
+
+	// 优先级高的层后求值，覆盖低优先级层的结果
+	int32 Priority = 0;
+
+	EJoyCameraModifyBlendMode BlendMode = EJoyCameraModifyBlendMode::Override;
+
+	// 从更改开始到现在经过的时间
+	float ElapsedTime = 0;
+
+	// 从淡出开始到现在经过的时间
+	float BlendOutElapsedTime = 0;
+
+	// 修改起作用的淡入时间
+	float BlendInTime = 0;
+
+	// 修改起作用的淡出时间
+	float BlendOutTime = 0;
+
+	// 修改值持续时间
+	float Duration = 0;
+
+	// 是否需要手动中断 Duration
+	bool bNeedManualBreak = false;
+
+	// 是否需要已经手动中断 Duration
+	bool bHasManualBreak = false;
+
+	// 由 CameraParaModifier 自己判断是否要修改弹簧臂长的值
+	bool bNeedModifyAdditionalArmLength = false;
+
+	// 由 CameraParaModifier 自己判断是否要修改相机 Offset 值
+	bool bNeedModifyAdditionalLocalCameraOffset = false;
+
+	// 由 CameraParaModifier 自己判断是否要修改相机 Rotation 的值
+	bool bNeedModifyAdditionalCameraRotation = false;
+
+	// 是否需要修改相机 Fov
+	bool bNeedModifyFov = false;
+
+	// 计算阶段发现本层已结束，等待 PostUpdate 在游戏线程移除
+	bool bPendingEnd = false;
+
+	EBlendState BlendState = EBlendState::None;
+
+	float RawBlendAlpha = 0.f;
+
+	FCameraModifySpec Spec{};
+
+	// 引用共享预设时不拷贝修改设置，Spec.CameraModifiers 不使用
+	const UJoyCameraModifierPreset* Preset = nullptr;
+
+	FJoyCameraModifyProgram Program{};
+
+	// 本层生效的修改设置，来自共享预设或自身拷贝
+	const FCameraModifiers& GetModifiers() const;
+
+	bool IsCameraRotationModified() const;
+
+	bool IsArmLengthModified() const
+	{
+		return bNeedModifyAdditionalArmLength || GetModifiers().ArmLengthSettings.bModified;
+	}
+};
+
+/**
+ * 一次层栈求值过程中已被低优先级层写入的通道，高优先级层以这些通道的结果为混合起点
+ */
+struct FJoyCameraModifyStackState
+{
+	EJoyCameraChannel WrittenChannels = EJoyCameraChannel::None;
+
+	// 局部偏移与世界偏移共用 Offset 通道，分别记录
+	bool bLocalOffsetWritten = false;
+
+	bool bWorldOffsetWritten = false;
+
+	// 本帧求值前旋转已被其他逻辑修改
+	bool bRotationInterrupted = false;
+};
+
 UCLASS()
 class ORIGINALGAME_API UJoyCameraModifierController : public UJoyCameraControllerBase
 {
@@ -376,18 +557,50 @@ class ORIGINALGAME_API UJoyCameraModifierController : public UJoyCameraControlle
 	friend class AJoyPlayerCameraManager;
 
 public:
+	// 每个 ViewTarget 同时存在的修改层上限
+	static constexpr int32 MaxModifyLayers = 8;
+
 	UJoyCameraModifierController();
 
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/**
+	 * 压入一个修改层
+	 * 同优先级的覆盖层会打断已有的层，与单层修改时的行为一致；
+	 * 层数达到上限时移除优先级最低的层，新层优先级低于所有已有层时不压入并返回无效句柄
+	 */
 	FCameraModifyHandle ApplyCameraModify(float Duration, float BlendInTime, float BlendOutTime,
-		FCameraModifiers const& CameraModifiers, bool bNeedManualBreak = false);
+		FCameraModifiers const& CameraModifiers, bool bNeedManualBreak = false, int32 Priority = 0,
+		EJoyCameraModifyBlendMode BlendMode = EJoyCameraModifyBlendMode::Override);
+
+	/**
+	 * 以共享预设压入一个修改层，优先级与混合方式取自预设
+	 * 预设不含自适应选项且没有覆盖值时层只引用预设，不拷贝修改设置
+	 */
+	FCameraModifyHandle ApplyCameraPreset(const UJoyCameraModifierPreset* Preset, float Duration, float BlendInTime,
+		float BlendOutTime, bool bNeedManualBreak = false, const FJoyCameraModifierPresetOverrides* Overrides = nullptr);
 
 	FCameraModifyHandle GetLastModifierHandle() const;
 
 	void ApplyCameraModify_Immediately(const FCameraModifiers& InCameraModifiers);
 
+	// 让等待手动中断的层进入淡出，无效句柄表示所有层，所有者代数与当前不同的句柄被忽略
 	void BreakModifier(FCameraModifyHandle ModifyHandler = FCameraModifyHandle(0));
 
-	void EndModify();
+	// 立即结束修改层，无效句柄表示所有层，所有者代数与当前不同的句柄被忽略
+	void EndModify(FCameraModifyHandle ModifyHandler = FCameraModifyHandle(0));
+
+	/**
+	 * 表示当前所有者所有层的句柄
+	 * Modifier 会被回收给其他 ViewTarget 复用，跨帧持有 Modifier 的一方应使用此句柄结束所有层，
+	 * 复用后旧句柄不会影响新的所有者；每次从 ViewTarget 取得 Modifier 的调用方可直接使用无效句柄
+	 */
+	FCameraModifyHandle GetAllLayersHandle() const;
+
+	uint32 GetOwnerGeneration() const
+	{
+		return OwnerGeneration;
+	}
 
 	// 修改完毕后尝试重置 ViewTarget 到原始值
 	void ResetViewTarget();
@@ -396,7 +609,15 @@ public:
 
 	bool IsModifiedAndNeedUpdate() const;
 
-	void SetModifyTarget(AActor* ModifyTarget);
+	bool IsModified() const
+	{
+		return ModifyLayers.Num() > 0;
+	}
+
+	void SetModifyTarget(AActor* ModifyTarget, const FViewTargetCameraHandle& InViewTargetHandle);
+
+	/** 回收到对象池前清空修改状态，SequenceNumber 保持递增，所有者代数递增，旧句柄不会作用于新的所有者 */
+	void ResetForReuse();
 
 	AActor* GetModifyTarget() const
 	{
@@ -404,82 +625,104 @@ public:
 	}
 
 private:
-	void StartModifyFadeOut();
+	/**
+	 * 分阶段更新，三个阶段依次调用等价于 UpdateInternal：
+	 * PreUpdate 在游戏线程读取外部状态，返回是否需要继续更新；
+	 * ComputeUpdate 只读写自身与所修改 ViewTarget 的相机数据，不同 Modifier 之间可以并行；
+	 * PostUpdate 在游戏线程处理修改结束带来的副作用（恢复输入、广播、重置 ViewTarget）
+	 */
+	bool PreUpdate(float InDeltaSeconds);
 
-	void MakeRestoreCameraData(FVirtualCamera& RestoreCamera) const;
+	void ComputeUpdate();
 
-	void UpdateModifyFadeOut(float DeltaSeconds);
+	void PostUpdate();
 
-	void UpdateModifiers(float DeltaSeconds);
+	FViewTargetCameraInfo& GetModifyTargetCameraInfo() const;
 
-	void UpdateArmLengthModifier(EBlendState State, float Alpha);
+	int32 FindLayerIndex(FCameraModifyHandle ModifyHandler) const;
 
-	void UpdateLocalArmCenterOffsetModifier(EBlendState State, float Alpha) const;
+	bool IsCurrentOwnerHandle(FCameraModifyHandle ModifyHandler) const
+	{
+		return ModifyHandler.OwnerGeneration == 0 || ModifyHandler.OwnerGeneration == OwnerGeneration;
+	}
 
-	void UpdateWorldArmCenterOffsetModifier(EBlendState State, float Alpha) const;
+	// ApplyCameraModify 与 ApplyCameraPreset 共用的压栈逻辑，Layer 的修改设置需已准备好
+	FCameraModifyHandle PushModifyLayer(FJoyCameraModifyLayer&& Layer, float Duration, float BlendInTime,
+		float BlendOutTime, bool bNeedManualBreak, int32 Priority, EJoyCameraModifyBlendMode BlendMode);
 
-	void UpdateArmRotationModifier(EBlendState State, float Alpha);
+	using FEndedModifyHandles = TArray<FCameraModifyHandle, TInlineAllocator<MaxModifyLayers>>;
 
-	void UpdateFovModifier(EBlendState State, float Alpha);
+	// 移除一层并处理其结束带来的副作用，只能在游戏线程调用；结束事件不在此处广播，句柄追加到 OutEndedHandles
+	void EndLayer(int32 LayerIndex, FEndedModifyHandles& OutEndedHandles);
 
-	bool IsCameraRotationModified() const;
+	// 广播修改层结束事件，回调中可能压入或结束修改层，只能在不再遍历层栈时调用
+	void BroadcastModifyEnd(const FEndedModifyHandles& EndedHandles) const;
 
-	bool IsCameraOffsetModified() const;
+	// 根据所有层的设置刷新输入与角色切换的屏蔽状态
+	void RefreshInputOverride();
 
-private:
-	// 从更改开始到现在经过的时间
-	float ModifyElapsedTime = 0;
+	void StartModifyFadeOut(const FJoyCameraModifyLayer& Layer);
 
-	// 从淡出开始到现在经过的时间
-	float ModifyBlendOutElapsedTime = 0;
+	void MakeRestoreCameraData(FViewTargetCameraInfo& TargetCameraInfo) const;
 
-	// 修改起作用的淡入时间
-	float ModifyBlendInTime = 0;
+	void UpdateModifyFadeOut(float DeltaSeconds);
 
-	// 修改起作用的淡出时间
-	float ModifyBlendOutTime = 0;
+	// 按优先级从低到高对所有层求值一遍
+	void UpdateModifiers();
 
-	// 修改值持续时间
-	float ModifyDuration = 0;
+	// 推进一层的时间轴，返回本帧的混合 Alpha
+	float UpdateLayerBlend(FJoyCameraModifyLayer& Layer, float DeltaSeconds) const;
 
-	// 是否需要手动中断 Duration
-	bool bNeedManualBreakModify = false;
+	// 根据层的修改设置编译其修改程序
+	void CompileModifyProgram(FJoyCameraModifyLayer& Layer) const;
 
-	// 是否需要已经手动中断 Duration
-	bool bHasManualBreakModify = false;
+	void UpdateArmLengthModifier(FViewTargetCameraInfo& TargetCameraInfo, const FJoyCameraModifyLayer& Layer,
+		float Alpha, FJoyCameraModifyStackState& StackState) const;
 
-	// 是否进入了淡出状态
-	bool bIsModifyBlendOut = false;
+	void UpdateLocalArmCenterOffsetModifier(FViewTargetCameraInfo& TargetCameraInfo,
+		const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const;
 
-	// 由 CameraParaModifier 自己判断是否要修改弹簧臂长的值
-	bool bNeedModifyAdditionalArmLength = false;
+	void UpdateWorldArmCenterOffsetModifier(FViewTargetCameraInfo& TargetCameraInfo,
+		const FJoyCameraModifyLayer& Layer, float Alpha, FJoyCameraModifyStackState& StackState) const;
 
-	// 由 CameraParaModifier 自己判断是否要修改相机 Offset 值
-	bool bNeedModifyAdditionalLocalCameraOffset = false;
+	void UpdateArmRotationModifier(FViewTargetCameraInfo& TargetCameraInfo, FJoyCameraModifyLayer& Layer,
+		float Alpha, FJoyCameraModifyStackState& StackState);
 
-	// 由 CameraParaModifier 自己判断是否要修改相机 Rotation 的值
-	bool bNeedModifyAdditionalCameraRotation = false;
+	void UpdateFovModifier(FViewTargetCameraInfo& TargetCameraInfo, const FJoyCameraModifyLayer& Layer,
+		float Alpha, FJoyCameraModifyStackState& StackState) const;
 
-	// 是否需要修改相机 Fov
-	bool bNeedModifyFov{false};
+	float GetFinalArmLength(const FJoyCameraModifyLayer& Layer) const;
+
+	FVector GetFinalLocalArmOffset(const FJoyCameraModifyLayer& Layer) const;
+
+	FVector GetFinalWorldArmOffset(const FJoyCameraModifyLayer& Layer) const;
+
+	// 获取相机弹簧臂最终方向
+	FRotator GetFinalArmRotation(const FJoyCameraModifyLayer& Layer) const;
+
+	float GetFinalFov(const FJoyCameraModifyLayer& Layer) const;
+
+private:
+	// 按优先级从低到高排列的修改层，同优先级按压入顺序排列
+	// 层内引用的预设与曲线由 AddReferencedObjects 上报给 GC
+	TArray<FJoyCameraModifyLayer, TFixedAllocator<MaxModifyLayers>> ModifyLayers;
 
 	bool bNeedModifyFadeOut{false};
 
 	bool bIgnoreTimeDilation{false};
 
-	float GetFinalArmLength() const;
-
-	FVector GetFinalLocalArmOffset() const;
+	// 当前被屏蔽的输入
+	bool bArmRotationInputOverridden = false;
 
-	FVector GetFinalWorldArmOffset() const;
+	bool bArmLengthInputOverridden = false;
 
-	// 获取相机弹簧臂最终方向
-	FRotator GetFinalArmRotation();
+	bool bCharacterSwitchOverridden = false;
 
-	float GetFinalFov() const;
+	// PreUpdate 中根据时间膨胀设置选取的本帧 DeltaTime
+	float PendingDeltaTime = 0.f;
 
-	// 当前值是否处于修改状态
-	bool bIsModified = false;
+	// 计算阶段发现有层已结束，等待 PostUpdate 在游戏线程移除
+	bool bPendingEndModify = false;
 
 	// 是否会附加到新 View Target
 	bool bResetViewTarget = false;
@@ -490,9 +733,6 @@ private:
 	UPROPERTY()
 	FCameraFadeOutData ModifyFadeOutData;
 
-	UPROPERTY()
-	EBlendState CurrentBlendState = EBlendState::None;
-
 	// 相机臂旋转恢复速度
 	float ModifyArmRotationLagSpeed = 1.;
 
@@ -505,14 +745,15 @@ private:
 	UPROPERTY()
 	TObjectPtr<AActor> ModifiedViewTarget = nullptr;
 
+	// ModifiedViewTarget 在 PlayerCameraManager 中对应的相机数据句柄
+	FViewTargetCameraHandle ViewTargetHandle{};
+
 	UPROPERTY()
 	mutable int64 SequenceNumber{0};
 
-	UPROPERTY()
-	FCameraModifyHandle LastModifierHandle{0};
+	// 每次回收复用时递增，从 1 开始，句柄中的 0 表示不校验
+	uint32 OwnerGeneration{1};
 
 	UPROPERTY()
-	FCameraModifySpec CurrentCameraModifySpec{};
-
-	float CurrentRawBlendAlpha{0.f};
+	FCameraModifyHandle LastModifierHandle{0};
 };
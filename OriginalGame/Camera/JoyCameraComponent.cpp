@@ -2,6 +2,10 @@
 
 #include "CameraMode/JoyCameraMode.h"
 #include "CameraMode/JoyCameraModeStack.h"
+#include "JoyCameraStats.h"
+#include "JoyPlayerCameraManager.h"
+#include "Replay/JoyCameraReplay.h"
+#include "Utils/JoyCameraBlueprintLibrary.h"
 
 FJoyCameraIDHandle::FJoyCameraIDHandle(int64 Seq) : SequenceID(Seq)
 {
@@ -31,6 +35,22 @@ void UJoyCameraComponent::OnRegister()
 		CameraModeStack = NewObject<UJoyCameraModeStack>(this);
 		check(CameraModeStack);
 	}
+
+	// 通知镜头管理更新该 Actor 绑定的相机组件
+	if (auto* CameraManager = UJoyCameraBlueprintLibrary::GetJoyPlayerCameraManager(this))
+	{
+		CameraManager->OnCameraComponentRegistered(this);
+	}
+}
+
+void UJoyCameraComponent::OnUnregister()
+{
+	if (auto* CameraManager = UJoyCameraBlueprintLibrary::GetJoyPlayerCameraManager(this))
+	{
+		CameraManager->OnCameraComponentUnregistered(this);
+	}
+
+	Super::OnUnregister();
 }
 
 void UJoyCameraComponent::GetCameraView(float DeltaTime, FMinimalViewInfo& DesiredView)
@@ -41,29 +61,38 @@ void UJoyCameraComponent::GetCameraView(float DeltaTime, FMinimalViewInfo& Desir
 	{
 		FJoyCameraModeView CameraModeView;
 		CameraModeStack->EvaluateStack(DeltaTime, CameraModeView);
-		SetWorldLocationAndRotation(CameraModeView.Location, CameraModeView.Rotation);
-		FieldOfView = CameraModeView.FieldOfView;
-
-		// Fill in desired view.
-		DesiredView.Location = CameraModeView.Location;
-		DesiredView.Rotation = CameraModeView.Rotation;
-		DesiredView.FOV = CameraModeView.FieldOfView;
-		DesiredView.OrthoWidth = OrthoWidth;
-		DesiredView.OrthoNearClipPlane = OrthoNearClipPlane;
-		DesiredView.OrthoFarClipPlane = OrthoFarClipPlane;
-		DesiredView.AspectRatio = AspectRatio;
-		DesiredView.bConstrainAspectRatio = bConstrainAspectRatio;
-		DesiredView.bUseFieldOfViewForLOD = bUseFieldOfViewForLOD;
-		DesiredView.ProjectionMode = ProjectionMode;
-
-		// See if the CameraActor wants to override the PostProcess settings used.
-		DesiredView.PostProcessBlendWeight = PostProcessBlendWeight;
-		if (PostProcessBlendWeight > 0.0f)
+		if (CameraModeStack->IsViewReused())
 		{
-			DesiredView.PostProcessSettings = PostProcessSettings;
+			// 相机模式复用了上一帧的结果，组件位姿与视图信息都无需更新
+			DesiredView = FrozenCameraView;
+			INC_DWORD_STAT(STAT_JoyCamera_ReusedViews);
 		}
+		else
+		{
+			SetWorldLocationAndRotation(CameraModeView.Location, CameraModeView.Rotation);
+			FieldOfView = CameraModeView.FieldOfView;
+
+			// Fill in desired view.
+			DesiredView.Location = CameraModeView.Location;
+			DesiredView.Rotation = CameraModeView.Rotation;
+			DesiredView.FOV = CameraModeView.FieldOfView;
+			DesiredView.OrthoWidth = OrthoWidth;
+			DesiredView.OrthoNearClipPlane = OrthoNearClipPlane;
+			DesiredView.OrthoFarClipPlane = OrthoFarClipPlane;
+			DesiredView.AspectRatio = AspectRatio;
+			DesiredView.bConstrainAspectRatio = bConstrainAspectRatio;
+			DesiredView.bUseFieldOfViewForLOD = bUseFieldOfViewForLOD;
+			DesiredView.ProjectionMode = ProjectionMode;
+
+			// See if the CameraActor wants to override the PostProcess settings used.
+			DesiredView.PostProcessBlendWeight = PostProcessBlendWeight;
+			if (PostProcessBlendWeight > 0.0f)
+			{
+				DesiredView.PostProcessSettings = PostProcessSettings;
+			}
 
-		FrozenCameraView = DesiredView;
+			FrozenCameraView = DesiredView;
+		}
 	}
 	else
 	{
@@ -130,13 +159,22 @@ FJoyCameraIDHandle UJoyCameraComponent::PushCameraConfig(FName CameraID)
 {
 	if (!CameraIDs.Contains(CameraID))
 	{
-		bIsCameraConfigDirty = true;
 		CameraIDs.Add(CameraID);
+		CameraIDStack.Add(CameraID);
+		CameraIDStackVersion++;
 
 		SequenceNumber++;
 		FJoyAddCameraIDRequestCache& NewRequest = CameraIDRequestQueue.Emplace_GetRef();
 		NewRequest.Handle = FJoyCameraIDHandle(SequenceNumber);
 		NewRequest.CameraID = CameraID;
+
+#if JOY_CAMERA_WITH_REPLAY
+		if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+		{
+			Recorder->RecordPushCameraConfig(GetOwner(), CameraID, SequenceNumber);
+		}
+#endif
+
 		return NewRequest.Handle;
 	}
 
@@ -156,11 +194,19 @@ bool UJoyCameraComponent::RemoveCameraConfig(FJoyCameraIDHandle Handler)
 		return false;
 	}
 
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+	{
+		Recorder->RecordRemoveCameraConfig(GetOwner(), Handler.SequenceID);
+	}
+#endif
+
 	const FName CameraID = CameraIDRequestQueue[Index].CameraID;
-	bIsCameraConfigDirty = true;
 	CameraIDs.Remove(CameraID);
 
 	CameraIDRequestQueue.RemoveAt(Index);
+	CameraIDStack.RemoveAt(Index);
+	CameraIDStackVersion++;
 	return true;
 }
 
@@ -184,33 +230,20 @@ bool UJoyCameraComponent::RemoveCameraConfigByID(FName CameraID)
 			return false;
 		}
 
-		bIsCameraConfigDirty = true;
+#if JOY_CAMERA_WITH_REPLAY
+		if (auto* Recorder = FJoyCameraReplayRecorder::Get())
+		{
+			Recorder->RecordRemoveCameraConfigByID(GetOwner(), CameraID);
+		}
+#endif
+
 		CameraIDRequestQueue.RemoveAt(Index);
+		CameraIDStack.RemoveAt(Index);
 		CameraIDs.Remove(CameraID);
+		CameraIDStackVersion++;
 
 		return true;
 	}
 
 	return false;
 }
-
-TArray<FName> UJoyCameraComponent::GetCameraIDs() const
-{
-	TArray<FName> OutResult{};
-	for (const auto& CacheRequest : CameraIDRequestQueue)
-	{
-		OutResult.Add(CacheRequest.CameraID);
-	}
-
-	return OutResult;
-}
-
-bool UJoyCameraComponent::IsCameraConfigDirty() const
-{
-	return bIsCameraConfigDirty;
-}
-
-void UJoyCameraComponent::RefreshCameraConfig()
-{
-	bIsCameraConfigDirty = false;
-}
\ No newline at end of file
@@ -159,19 +159,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Joy|Camera")
 	bool RemoveCameraConfigByID(FName CameraID);
 
-private:
-	bool bIsCameraConfigDirty{false};
-
-public:
-	TArray<FName> GetCameraIDs() const;
-
-	bool IsCameraConfigDirty() const;
+	// 按压入顺序排列的镜头 ID，视图在下次修改前有效
+	TConstArrayView<FName> GetCameraIDs() const
+	{
+		return CameraIDStack;
+	}
 
-	void RefreshCameraConfig();
+	// 镜头 ID 栈每次变化时递增，读取方记录看到的版本即可判断是否需要更新
+	uint32 GetCameraIDStackVersion() const
+	{
+		return CameraIDStackVersion;
+	}
 	/** ========================= END ============================ */
 
 protected:
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void GetCameraView(float DeltaTime, FMinimalViewInfo& DesiredView) override;
 
 	virtual void UpdateCameraModes();
@@ -189,6 +192,11 @@ private:
 	UPROPERTY()
 	TSet<FName> CameraIDs;
 
+	// 与 CameraIDRequestQueue 一一对应的镜头 ID
+	TArray<FName> CameraIDStack;
+
+	uint32 CameraIDStackVersion{0};
+
 	UPROPERTY()
 	bool bCameraFrozen = false;
 
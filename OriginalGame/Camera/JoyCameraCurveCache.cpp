@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraCurveCache.h"
+
+#include "Curves/CurveFloat.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace JoyCameraCurveCache
+{
+	// 初始采样段数，误差不满足时逐级加倍
+	static constexpr int32 MinSegments = 64;
+
+	static constexpr int32 MaxSegments = 4096;
+
+	// 允许误差相对曲线值域的比例
+	static constexpr float RelativeTolerance = 1e-4f;
+
+	static void RegisterCallbacks()
+	{
+		static bool bRegistered = false;
+		if (bRegistered)
+		{
+			return;
+		}
+
+		bRegistered = true;
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FJoyCameraCurveCache::RemoveStaleCurves);
+
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectModified.AddLambda(
+			[](UObject* Object)
+			{
+				if (Object != nullptr && Object->IsA<UCurveFloat>())
+				{
+					FJoyCameraCurveCache::Invalidate(Object);
+				}
+			});
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda(
+			[](UObject* Object, FPropertyChangedEvent&)
+			{
+				if (Object != nullptr && Object->IsA<UCurveFloat>())
+				{
+					FJoyCameraCurveCache::Invalidate(Object);
+				}
+			});
+#endif
+	}
+}
+
+float FJoyBakedCurve::GetFloatValue(const UCurveFloat* SourceCurve, float Time) const
+{
+	if (bUseSourceCurve || !IsInRange(Time))
+	{
+		return SourceCurve->GetFloatValue(Time);
+	}
+
+	return Evaluate(Time);
+}
+
+float FJoyBakedCurve::GetNormalizedValue(const UCurveFloat* SourceCurve, float Alpha) const
+{
+	if (FMath::IsNearlyEqual(NormalizeStartValue, NormalizeEndValue))
+	{
+		return NormalizeStartValue;
+	}
+
+	const float Value = GetFloatValue(SourceCurve, FMath::Clamp(Alpha, 0.f, 1.f));
+	return (Value - NormalizeStartValue) / (NormalizeEndValue - NormalizeStartValue);
+}
+
+TMap<FObjectKey, TSharedPtr<const FJoyBakedCurve>> FJoyCameraCurveCache::BakedCurves;
+
+FRWLock FJoyCameraCurveCache::BakedCurvesLock;
+
+TSharedPtr<const FJoyBakedCurve> FJoyCameraCurveCache::GetBakedCurve(const UCurveFloat* Curve)
+{
+	if (Curve == nullptr)
+	{
+		return nullptr;
+	}
+
+	{
+		FReadScopeLock ReadLock(BakedCurvesLock);
+		if (const TSharedPtr<const FJoyBakedCurve>* BakedCurve = BakedCurves.Find(FObjectKey(Curve)))
+		{
+			return *BakedCurve;
+		}
+	}
+
+	TSharedRef<FJoyBakedCurve> NewBakedCurve = MakeShared<FJoyBakedCurve>();
+	Bake(Curve, *NewBakedCurve);
+
+	FWriteScopeLock WriteLock(BakedCurvesLock);
+	BakedCurves.Add(FObjectKey(Curve), NewBakedCurve);
+	return NewBakedCurve;
+}
+
+void FJoyCameraCurveCache::Invalidate(const UObject* Curve)
+{
+	FWriteScopeLock WriteLock(BakedCurvesLock);
+	BakedCurves.Remove(FObjectKey(Curve));
+}
+
+void FJoyCameraCurveCache::Reset()
+{
+	FWriteScopeLock WriteLock(BakedCurvesLock);
+	BakedCurves.Reset();
+}
+
+void FJoyCameraCurveCache::RemoveStaleCurves()
+{
+	FWriteScopeLock WriteLock(BakedCurvesLock);
+	for (auto It = BakedCurves.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FJoyCameraCurveCache::Bake(const UCurveFloat* Curve, FJoyBakedCurve& OutBakedCurve)
+{
+	JoyCameraCurveCache::RegisterCallbacks();
+
+	OutBakedCurve = FJoyBakedCurve();
+	OutBakedCurve.NormalizeStartValue = Curve->GetFloatValue(0.f);
+	OutBakedCurve.NormalizeEndValue = Curve->GetFloatValue(1.f);
+
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	Curve->GetTimeRange(MinTime, MaxTime);
+	if (MaxTime - MinTime <= UE_KINDA_SMALL_NUMBER)
+	{
+		// 没有或只有一个关键帧，原曲线求值本身很廉价
+		OutBakedCurve.bUseSourceCurve = true;
+		return;
+	}
+
+	float MinValue = 0.f;
+	float MaxValue = 0.f;
+	Curve->GetValueRange(MinValue, MaxValue);
+	const float Tolerance = JoyCameraCurveCache::RelativeTolerance * FMath::Max(1.f, MaxValue - MinValue);
+
+	OutBakedCurve.MinTime = MinTime;
+	OutBakedCurve.MaxTime = MaxTime;
+
+	for (int32 NumSegments = JoyCameraCurveCache::MinSegments; NumSegments <= JoyCameraCurveCache::MaxSegments;
+		 NumSegments *= 2)
+	{
+		const float Step = (MaxTime - MinTime) / NumSegments;
+		OutBakedCurve.InvStep = 1.f / Step;
+		OutBakedCurve.Samples.SetNumUninitialized(NumSegments + 1);
+		for (int32 Index = 0; Index <= NumSegments; ++Index)
+		{
+			OutBakedCurve.Samples[Index] = Curve->GetFloatValue(Index < NumSegments ? MinTime + Index * Step : MaxTime);
+		}
+
+		// 在每段的 1/4、1/2、3/4 处检查插值误差
+		OutBakedCurve.MaxError = 0.f;
+		for (int32 Index = 0; Index < NumSegments; ++Index)
+		{
+			for (const float Fraction : {0.25f, 0.5f, 0.75f})
+			{
+				const float Time = MinTime + (Index + Fraction) * Step;
+				const float Error = FMath::Abs(Curve->GetFloatValue(Time) - OutBakedCurve.Evaluate(Time));
+				OutBakedCurve.MaxError = FMath::Max(OutBakedCurve.MaxError, Error);
+			}
+		}
+
+		if (OutBakedCurve.MaxError <= Tolerance)
+		{
+			return;
+		}
+	}
+
+	// 最高密度仍不满足误差要求，放弃采样表
+	OutBakedCurve.bUseSourceCurve = true;
+	OutBakedCurve.Samples.Empty();
+}
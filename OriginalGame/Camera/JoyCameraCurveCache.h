@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UCurveFloat;
+
+/**
+ * 烘焙为等距采样表的曲线，在关键帧时间范围内用一次线性插值求值
+ */
+struct FJoyBakedCurve
+{
+	float MinTime = 0.f;
+
+	float MaxTime = 0.f;
+
+	// 1 / 采样间隔
+	float InvStep = 0.f;
+
+	// 采样点之间相对原曲线的最大误差
+	float MaxError = 0.f;
+
+	// 采样表无法满足误差要求（例如常量插值的阶跃），直接求值原曲线
+	bool bUseSourceCurve = false;
+
+	// 曲线在 0 与 1 处的值，用于归一化求值
+	float NormalizeStartValue = 0.f;
+
+	float NormalizeEndValue = 0.f;
+
+	TArray<float> Samples;
+
+	/** 与 UCurveFloat::GetFloatValue 等价的求值，SourceCurve 为烘焙时使用的曲线 */
+	float GetFloatValue(const UCurveFloat* SourceCurve, float Time) const;
+
+	/** 与 UJoyMathBlueprintLibrary::GetNormalizeCurveFloat(SourceCurve, Alpha) 等价的求值 */
+	float GetNormalizedValue(const UCurveFloat* SourceCurve, float Alpha) const;
+
+	bool IsInRange(float Time) const
+	{
+		return Time >= MinTime && Time <= MaxTime;
+	}
+
+	float Evaluate(float Time) const
+	{
+		const float SamplePosition = (Time - MinTime) * InvStep;
+		const int32 Index = FMath::Clamp(FMath::FloorToInt32(SamplePosition), 0, Samples.Num() - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], SamplePosition - Index);
+	}
+};
+
+/**
+ * 相机曲线烘焙缓存
+ *
+ * 相机混合与 Modifier 每帧都会对 UCurveFloat 求值，每次求值需要二分查找关键帧并计算三次插值。
+ * 这里把每个曲线资源按需烘焙一次为采样表，采样密度逐级加倍直至误差满足要求，之后只做一次线性插值。
+ * 关键帧时间范围之外的求值仍交给原曲线处理外插。
+ *
+ * 使用方在设置曲线时（编译修改层、开始混合 ViewTarget）取得烘焙结果并持有，每帧直接求值，不再查找缓存。
+ * 曲线被回收后对应的缓存项在 GC 后移除；编辑器中曲线被修改后缓存项被丢弃，之后取得的是重新烘焙的结果。
+ */
+class ORIGINALGAME_API FJoyCameraCurveCache
+{
+public:
+	/** 取得曲线的烘焙结果，首次取得时烘焙，Curve 为空时返回空 */
+	static TSharedPtr<const FJoyBakedCurve> GetBakedCurve(const UCurveFloat* Curve);
+
+	/** 丢弃某条曲线的烘焙结果，下次取得时重新烘焙 */
+	static void Invalidate(const UObject* Curve);
+
+	static void Reset();
+
+	/** 移除已被回收的曲线的缓存项，每次 GC 后调用 */
+	static void RemoveStaleCurves();
+
+private:
+	static void Bake(const UCurveFloat* Curve, FJoyBakedCurve& OutBakedCurve);
+
+	static TMap<FObjectKey, TSharedPtr<const FJoyBakedCurve>> BakedCurves;
+
+	static FRWLock BakedCurvesLock;
+};
@@ -2,26 +2,236 @@
 
 #include "JoyCameraData.h"
 
+#include "Engine/DataTable.h"
+#include "JoyLogChannels.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+
 #define LOCTEXT_NAMESPACE "UFGCameraData"
 
+namespace JoyCameraData
+{
+	// "JCCF"
+	static constexpr uint32 CookedMagic = 0x4A434346;
+
+	// 只写入配置了的参数，以枚举值为键，枚举追加新值后旧数据仍可读取
+	template <typename EnumType>
+	static void SerializeValues(FArchive& Ar, TJoyCameraConfigValues<EnumType>& Values)
+	{
+		int32 NumPresent = FMath::CountBits(Values.PresentMask);
+		Ar << NumPresent;
+		if (Ar.IsLoading())
+		{
+			Values = TJoyCameraConfigValues<EnumType>();
+			for (int32 Index = 0; Index < NumPresent && !Ar.IsError(); ++Index)
+			{
+				uint8 Key = 0;
+				float Value = 0.f;
+				Ar << Key << Value;
+				Values.Set(static_cast<EnumType>(Key), Value);
+			}
+			return;
+		}
+
+		for (uint32 Mask = Values.PresentMask; Mask != 0; Mask &= Mask - 1)
+		{
+			uint8 Key = static_cast<uint8>(FMath::CountTrailingZeros(Mask));
+			float Value = Values.Values[Key];
+			Ar << Key << Value;
+		}
+	}
+
+	template <typename EnumType>
+	static void ToMap(const TJoyCameraConfigValues<EnumType>& Values, TMap<EnumType, float>& OutMap)
+	{
+		for (uint32 Mask = Values.PresentMask; Mask != 0; Mask &= Mask - 1)
+		{
+			const EnumType Key = static_cast<EnumType>(FMath::CountTrailingZeros(Mask));
+			OutMap.Add(Key, Values[Key]);
+		}
+	}
+}
+
+void FJoyCameraConfig::LoadTable(const FJoyCameraConfigTable& Table)
+{
+	Type = Table.Type;
+	FadeInTime = Table.FadeInTime;
+	FadeOutTime = Table.FadeOutTime;
+	bIgnoreTimeDilation = Table.bIgnoreTimeDilation;
+	bOverrideCameraInput = Table.bOverrideCameraInput;
+	bArmCenterLagEnable = Table.bArmCenterLagEnable;
+	Priority = Table.Priority;
+	bFadeArmPitch = false;
+	FadeTargetArmPitch = 0.f;
+	BasicConfig = FJoyCameraBasicConfig(Table.Basic);
+	InputConfig = FJoyCameraInputConfig(Table.Input);
+}
+
+FArchive& operator<<(FArchive& Ar, FJoyCameraConfig& Config)
+{
+	uint8 Type = static_cast<uint8>(Config.Type);
+	Ar << Config.FadeInTime;
+	Ar << Config.FadeOutTime;
+	Ar << Config.bIgnoreTimeDilation;
+	Ar << Config.bFadeArmPitch;
+	Ar << Config.FadeTargetArmPitch;
+	Ar << Config.bOverrideCameraInput;
+	Ar << Config.bArmCenterLagEnable;
+	Ar << Config.Priority;
+	Ar << Type;
+	Config.Type = static_cast<EJoyCameraType>(Type);
+	JoyCameraData::SerializeValues(Ar, Config.BasicConfig);
+	JoyCameraData::SerializeValues(Ar, Config.InputConfig);
+	return Ar;
+}
+
+bool FJoyCameraConfigRegistry::Add(FName CameraID, const FJoyCameraConfigTable& Table)
+{
+	if (ConfigIndices.Contains(CameraID))
+	{
+		return false;
+	}
+
+	ConfigIndices.Add(CameraID, Configs.Num());
+	CameraIDs.Add(CameraID);
+
+	Configs.AddDefaulted_GetRef().LoadTable(Table);
+
+#if WITH_EDITORONLY_DATA
+	Descriptions.Add(Table.Description);
+#endif
+	return true;
+}
+
+void FJoyCameraConfigRegistry::WriteCooked(TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+
+	uint32 Magic = JoyCameraData::CookedMagic;
+	uint32 Version = CookedVersion;
+	int32 NumConfigs = Configs.Num();
+	Writer << Magic << Version << NumConfigs;
+
+	for (const FJoyCameraConfig& Config : Configs)
+	{
+		Writer << const_cast<FJoyCameraConfig&>(Config);
+	}
+}
+
+bool FJoyCameraConfigRegistry::ReadCooked(TConstArrayView<uint8> Data, TConstArrayView<FName> InCameraIDs)
+{
+	FMemoryReaderView Reader(Data);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumConfigs = 0;
+	Reader << Magic << Version << NumConfigs;
+	if (Reader.IsError() || Magic != JoyCameraData::CookedMagic || Version != CookedVersion ||
+		NumConfigs != InCameraIDs.Num())
+	{
+		return false;
+	}
+
+	CameraIDs.Reset(NumConfigs);
+	CameraIDs.Append(InCameraIDs.GetData(), InCameraIDs.Num());
+	ConfigIndices.Reset();
+	ConfigIndices.Reserve(NumConfigs);
+	for (int32 Index = 0; Index < NumConfigs; ++Index)
+	{
+		ConfigIndices.Add(CameraIDs[Index], Index);
+	}
+
+	Configs.SetNum(NumConfigs);
+	for (FJoyCameraConfig& Config : Configs)
+	{
+		Reader << Config;
+	}
+
+	return !Reader.IsError() && Reader.AtEnd();
+}
+
+void FJoyCameraConfigRegistry::ToTableMap(TMap<FName, FJoyCameraConfigTable>& OutConfigMap) const
+{
+	OutConfigMap.Reset();
+	for (int32 Index = 0; Index < Configs.Num(); ++Index)
+	{
+		const FJoyCameraConfig& Config = Configs[Index];
+		FJoyCameraConfigTable& Table = OutConfigMap.Add(CameraIDs[Index]);
+#if WITH_EDITORONLY_DATA
+		Table.Description = Descriptions.IsValidIndex(Index) ? Descriptions[Index] : FString();
+#endif
+		Table.Priority = Config.Priority;
+		Table.FadeInTime = Config.FadeInTime;
+		Table.FadeOutTime = Config.FadeOutTime;
+		Table.bIgnoreTimeDilation = Config.bIgnoreTimeDilation;
+		Table.bOverrideCameraInput = Config.bOverrideCameraInput;
+		Table.bArmCenterLagEnable = Config.bArmCenterLagEnable;
+		Table.Type = Config.Type;
+		JoyCameraData::ToMap(Config.BasicConfig, Table.Basic);
+		JoyCameraData::ToMap(Config.InputConfig, Table.Input);
+	}
+}
+
 UJoyCameraData::UJoyCameraData(const FObjectInitializer& ObjectInitializer)
 {
 }
 
 void UJoyCameraData::CacheCameraData()
 {
-	CacheCameraConfigs.Reset();
+	TSharedRef<FJoyCameraConfigRegistry, ESPMode::ThreadSafe> NewRegistry =
+		MakeShared<FJoyCameraConfigRegistry, ESPMode::ThreadSafe>();
 
+#if WITH_EDITOR
+	BuildRegistryFromTables(*NewRegistry);
+#else
+	if (!NewRegistry->ReadCooked(CookedConfigData, CookedCameraIDs))
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("UJoyCameraData: %s 的烘焙镜头配置无效或版本不匹配，需要重新烘焙"),
+			*GetPathName());
+		NewRegistry = MakeShared<FJoyCameraConfigRegistry, ESPMode::ThreadSafe>();
+	}
+#endif
+
+	bool bReplaced = false;
+	{
+		FWriteScopeLock WriteLock(ConfigRegistryLock);
+		bReplaced = ConfigRegistry.IsValid();
+		ConfigRegistry = NewRegistry;
+	}
+
+	if (bReplaced)
+	{
+		OnConfigRegistryChanged.Broadcast();
+	}
+}
+
+FJoyCameraConfigRegistryPtr UJoyCameraData::GetConfigRegistry() const
+{
+	FReadScopeLock ReadLock(ConfigRegistryLock);
+	return ConfigRegistry;
+}
+
+#if WITH_EDITOR
+void UJoyCameraData::BuildRegistryFromTables(FJoyCameraConfigRegistry& OutRegistry)
+{
 	for (const auto& CameraTable : CameraTables)
 	{
+		if (CameraTable == nullptr)
+		{
+			continue;
+		}
+
+		// 编辑器中修改镜头配置表后重新构建注册表
+		CameraTable->OnDataTableChanged().RemoveAll(this);
+		CameraTable->OnDataTableChanged().AddUObject(this, &UJoyCameraData::CacheCameraData);
+
 		CameraTable->ForeachRow<FJoyCameraConfigTable>(TEXT("FJoyCameraConfigTable::ForeachRow"),
-			[this, &CameraTable](const FName& Key, const FJoyCameraConfigTable& Value) mutable
+			[&OutRegistry, &CameraTable](const FName& Key, const FJoyCameraConfigTable& Value) mutable
 			{
-				if (!CacheCameraConfigs.Contains(Key))
-				{
-					CacheCameraConfigs.Add(Key, Value);
-				}
-				else
+				if (!OutRegistry.Add(Key, Value))
 				{
 					FFormatOrderedArguments Args;
 					Args.Add(FText::FromString(Key.ToString()));
@@ -33,4 +243,45 @@ void UJoyCameraData::CacheCameraData()
 	}
 }
 
+void UJoyCameraData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UJoyCameraData, CameraTables))
+	{
+		CacheCameraData();
+	}
+}
+
+void UJoyCameraData::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// 源资源不保存烘焙数据，烘焙时把所有配置表展开为一段连续数据，描述字符串被剔除
+	CookedConfigData.Reset();
+	CookedCameraIDs.Reset();
+	if (ObjectSaveContext.IsCooking())
+	{
+		FJoyCameraConfigRegistry Registry;
+		BuildRegistryFromTables(Registry);
+		Registry.WriteCooked(CookedConfigData);
+		CookedCameraIDs = Registry.CameraIDs;
+
+		// 读回烘焙数据并再次写出，结果必须一致，否则运行时读到的配置与配置表不同
+		FJoyCameraConfigRegistry CookedRegistry;
+		TArray<uint8> RoundTripData;
+		const bool bRead = CookedRegistry.ReadCooked(CookedConfigData, CookedCameraIDs);
+		if (bRead)
+		{
+			CookedRegistry.WriteCooked(RoundTripData);
+		}
+
+		if (!bRead || RoundTripData != CookedConfigData)
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("UJoyCameraData: %s 的镜头配置烘焙后无法原样读回"), *GetPathName());
+		}
+	}
+}
+#endif
+
 #undef LOCTEXT_NAMESPACE
@@ -8,6 +8,91 @@
 
 #include "JoyCameraData.generated.h"
 
+/**
+ * 运行时使用的单个镜头配置
+ * 只包含定长数据，可以整体拷贝，烘焙格式中逐个字段序列化
+ */
+struct FJoyCameraConfig
+{
+	// 更新至此配置需要的时间
+	float FadeInTime{0.f};
+
+	// 离开此配置需要的时间
+	float FadeOutTime{0.f};
+
+	bool bIgnoreTimeDilation{false};
+
+	bool bFadeArmPitch{false};
+
+	float FadeTargetArmPitch{0.f};
+
+	bool bOverrideCameraInput{true};
+
+	bool bArmCenterLagEnable{false};
+
+	// 镜头优先级
+	int32 Priority{0};
+
+	// 相机类型
+	EJoyCameraType Type{EJoyCameraType::Basic};
+
+	// 默认相机参数
+	FJoyCameraBasicConfig BasicConfig{};
+
+	FJoyCameraInputConfig InputConfig{};
+
+	void LoadTable(const FJoyCameraConfigTable& Table);
+
+	friend FArchive& operator<<(FArchive& Ar, FJoyCameraConfig& Config);
+};
+
+/**
+ * 所有镜头配置表合并后的只读注册表
+ * 构建后不再修改，以共享指针的形式交给各个读取方；热重载时构建新的注册表整体替换，
+ * 仍持有旧注册表的读取方不受影响
+ */
+struct ORIGINALGAME_API FJoyCameraConfigRegistry
+{
+	// 烘焙格式版本，修改 FJoyCameraConfig 的序列化字段后需要递增
+	static constexpr uint32 CookedVersion = 2;
+
+	// 与 Configs 一一对应
+	TArray<FName> CameraIDs;
+
+	TArray<FJoyCameraConfig> Configs;
+
+	TMap<FName, int32> ConfigIndices;
+
+#if WITH_EDITORONLY_DATA
+	// 镜头描述只在编辑器中保留，烘焙时剔除
+	TArray<FString> Descriptions;
+#endif
+
+	const FJoyCameraConfig* Find(FName CameraID) const
+	{
+		const int32* Index = ConfigIndices.Find(CameraID);
+		return Index != nullptr ? &Configs[*Index] : nullptr;
+	}
+
+	// 添加一行配置，ID 重复时返回 false
+	bool Add(FName CameraID, const FJoyCameraConfigTable& Table);
+
+	/**
+	 * 烘焙为一段连续数据：文件头，随后逐个字段写入 Configs
+	 * ID 表不写入这段数据，由资源以 FName 数组保存，加载时经包的名字表直接得到 FName，不再逐个由字符串构造
+	 */
+	void WriteCooked(TArray<uint8>& OutData) const;
+
+	bool ReadCooked(TConstArrayView<uint8> Data, TConstArrayView<FName> InCameraIDs);
+
+	// 转换回配置表的行结构，供工具使用
+	void ToTableMap(TMap<FName, FJoyCameraConfigTable>& OutConfigMap) const;
+};
+
+using FJoyCameraConfigRegistryPtr = TSharedPtr<const FJoyCameraConfigRegistry, ESPMode::ThreadSafe>;
+
+DECLARE_MULTICAST_DELEGATE(FOnJoyCameraConfigRegistryChanged);
+
 UCLASS(BlueprintType, Const,
 	Meta = (DisplayName = "Joy Camera Data", ShortTooltip = "Data asset used to define camera configs."))
 class ORIGINALGAME_API UJoyCameraData : public UPrimaryDataAsset
@@ -17,11 +102,44 @@ class ORIGINALGAME_API UJoyCameraData : public UPrimaryDataAsset
 public:
 	UJoyCameraData(const FObjectInitializer& ObjectInitializer);
 
+#if WITH_EDITORONLY_DATA
+	// 只在编辑器中使用，烘焙后由 CookedConfigData 代替
 	UPROPERTY(EditDefaultsOnly, Category = "Joy|Camera",
 		meta = (RowType = "/Script/OriginalGame.JoyCameraConfigTable",
 			RequiredAssetDataTags = "RowStructure=/Script/OriginalGame.JoyCameraConfigTable"))
 	TArray<TObjectPtr<UDataTable>> CameraTables{};
+#endif
 
+	// 烘焙时由 CameraTables 生成的扁平配置数据
+	UPROPERTY()
+	TArray<uint8> CookedConfigData{};
+
+	// 与 CookedConfigData 中的配置一一对应的镜头 ID
+	UPROPERTY()
+	TArray<FName> CookedCameraIDs{};
+
+	// 重新构建注册表并替换当前的注册表，编辑器中读取 CameraTables，烘焙后读取 CookedConfigData
 	void CacheCameraData();
-	TMap<FName, FJoyCameraConfigTable> CacheCameraConfigs{};
+
+	// 获取当前注册表，读取期间即使发生热重载，持有的注册表也保持不变
+	FJoyCameraConfigRegistryPtr GetConfigRegistry() const;
+
+	// 注册表被替换后广播，已读取配置的一方可以据此重新加载
+	FOnJoyCameraConfigRegistryChanged OnConfigRegistryChanged;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
+private:
+#if WITH_EDITOR
+	void BuildRegistryFromTables(FJoyCameraConfigRegistry& OutRegistry);
+#endif
+
+	FJoyCameraConfigRegistryPtr ConfigRegistry;
+
+	// 只保护指针本身的读取与替换，构建注册表在锁外进行
+	mutable FRWLock ConfigRegistryLock;
 };
@@ -0,0 +1,134 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "JoyCameraModifierPreset.h"
+
+#include "JoyLogChannels.h"
+#include "Settings/JoyGlobalGameSettings.h"
+#include "System/JoyAssetManager.h"
+
+#define LOCTEXT_NAMESPACE "JoyCameraModifierPreset"
+
+void FJoyCameraModifierPresetOverrides::ApplyTo(FCameraModifiers& InCameraModifiers) const
+{
+	if (bOverrideArmLengthAdditional)
+	{
+		InCameraModifiers.ArmLengthSettings.ArmLengthAdditional = ArmLengthAdditional;
+	}
+
+	if (bOverrideLocalArmOffsetAdditional)
+	{
+		InCameraModifiers.LocalOffsetSettings.LocalArmOffsetAdditional = LocalArmOffsetAdditional;
+	}
+
+	if (bOverrideArmRotationAdditional)
+	{
+		InCameraModifiers.WorldRotationSettings.ArmRotationAdditional = ArmRotationAdditional;
+	}
+}
+
+#if WITH_EDITOR
+EDataValidationResult UJoyCameraModifierPreset::IsDataValid(TArray<FText>& ValidationErrors)
+{
+	const EDataValidationResult Result = Validate(ValidationErrors) ? EDataValidationResult::Valid
+																	: EDataValidationResult::Invalid;
+	return CombineDataValidationResults(Super::IsDataValid(ValidationErrors), Result);
+}
+#endif
+
+bool UJoyCameraModifierPreset::Validate(TArray<FText>& OutErrors) const
+{
+	const int32 NumErrors = OutErrors.Num();
+
+	const FCameraArmLengthSettings& ArmLengthSettings = CameraModifiers.ArmLengthSettings;
+	if (ArmLengthSettings.bModified && ArmLengthSettings.ArmLength <= 0.f)
+	{
+		OutErrors.Add(LOCTEXT("InvalidArmLength", "修改臂长时基础臂长必须大于 0"));
+	}
+
+	if (ArmLengthSettings.bModified && ArmLengthSettings.bArmLengthCurveControl &&
+		ArmLengthSettings.ArmLengthCurve == nullptr)
+	{
+		OutErrors.Add(LOCTEXT("MissingArmLengthCurve", "开启了曲线控制臂长但没有配置臂长曲线"));
+	}
+
+	const FCameraFovSettings& FovSettings = CameraModifiers.CameraFovSettings;
+	if (FovSettings.bModified && (FovSettings.CameraFov <= 0.f || FovSettings.CameraFov >= 180.f))
+	{
+		OutErrors.Add(LOCTEXT("InvalidFov", "Fov 必须在 (0, 180) 之间"));
+	}
+
+	if (FovSettings.bModified && FovSettings.bCameraFovCurveControl && FovSettings.CameraFovCurve == nullptr)
+	{
+		OutErrors.Add(LOCTEXT("MissingFovCurve", "开启了曲线控制 Fov 但没有配置 Fov 曲线"));
+	}
+
+	if (CameraModifiers.bArmRotationCurveControl && CameraModifiers.ArmRotationCurve == nullptr)
+	{
+		OutErrors.Add(LOCTEXT("MissingArmRotationCurve", "开启了曲线控制旋转但没有配置旋转曲线"));
+	}
+
+	if (CameraModifiers.bResetViewTarget && CameraModifiers.TimeToResetViewTarget < 0.f)
+	{
+		OutErrors.Add(LOCTEXT("InvalidTimeToResetViewTarget", "重置镜头用时不能小于 0"));
+	}
+
+	return OutErrors.Num() == NumErrors;
+}
+
+FName UJoyCameraModifierPreset::GetPresetId() const
+{
+	return PresetId.IsNone() ? GetFName() : PresetId;
+}
+
+TMap<FName, const UJoyCameraModifierPreset*> FJoyCameraModifierPresetRegistry::Presets;
+
+void FJoyCameraModifierPresetRegistry::Initialize()
+{
+	Presets.Reset();
+
+	const UJoyGlobalGameSettings* Settings = UJoyGlobalGameSettings::Get();
+	if (Settings == nullptr)
+	{
+		return;
+	}
+
+	for (const TSoftObjectPtr<UJoyCameraModifierPreset>& PresetPtr : Settings->CameraModifierPresets)
+	{
+		const UJoyCameraModifierPreset* Preset = UJoyAssetManager::GetAsset(PresetPtr);
+		if (Preset == nullptr)
+		{
+			continue;
+		}
+
+		TArray<FText> Errors;
+		if (!Preset->Validate(Errors))
+		{
+			for (const FText& Error : Errors)
+			{
+				UE_LOG(LogJoyCamera, Error, TEXT("相机修改预设 %s 配置错误: %s"), *Preset->GetPathName(),
+					*Error.ToString());
+			}
+			continue;
+		}
+
+		const FName Id = Preset->GetPresetId();
+		if (const UJoyCameraModifierPreset* const* Existing = Presets.Find(Id))
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("相机修改预设 ID %s 重复: %s, %s"), *Id.ToString(),
+				*(*Existing)->GetPathName(), *Preset->GetPathName());
+			continue;
+		}
+
+		Presets.Add(Id, Preset);
+	}
+
+	UE_LOG(LogJoyCamera, Log, TEXT("已注册 %d 个相机修改预设"), Presets.Num());
+}
+
+const UJoyCameraModifierPreset* FJoyCameraModifierPresetRegistry::Find(FName PresetId)
+{
+	const UJoyCameraModifierPreset* const* Preset = Presets.Find(PresetId);
+	return Preset != nullptr ? *Preset : nullptr;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,100 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Camera/Controller/JoyCameraModifierController.h"
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "JoyCameraModifierPreset.generated.h"
+
+/**
+ * 应用预设时可选的增量覆盖，只覆盖各项设置中的额外增量部分
+ */
+USTRUCT(BlueprintType)
+struct FJoyCameraModifierPresetOverrides
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "覆盖臂长变化增量")
+	bool bOverrideArmLengthAdditional = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "臂长变化增量",
+		meta = (EditCondition = "bOverrideArmLengthAdditional", EditConditionHides))
+	float ArmLengthAdditional = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "覆盖局部额外偏移")
+	bool bOverrideLocalArmOffsetAdditional = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "局部额外偏移",
+		meta = (EditCondition = "bOverrideLocalArmOffsetAdditional", EditConditionHides))
+	FVector LocalArmOffsetAdditional = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "覆盖额外旋转增量")
+	bool bOverrideArmRotationAdditional = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "额外旋转增量",
+		meta = (EditCondition = "bOverrideArmRotationAdditional", EditConditionHides))
+	FRotator ArmRotationAdditional = FRotator::ZeroRotator;
+
+	bool HasAnyOverride() const
+	{
+		return bOverrideArmLengthAdditional || bOverrideLocalArmOffsetAdditional || bOverrideArmRotationAdditional;
+	}
+
+	void ApplyTo(FCameraModifiers& CameraModifiers) const;
+};
+
+/**
+ * 相机修改预设
+ *
+ * 技能、受击等高频触发的相机修改共享同一份只读设置，应用时按 ID 引用，不再逐次拷贝 FCameraModifiers。
+ */
+UCLASS(BlueprintType, Const,
+	Meta = (DisplayName = "Joy Camera Modifier Preset", ShortTooltip = "Data asset used to define shared camera modifiers."))
+class ORIGINALGAME_API UJoyCameraModifierPreset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//~UObject interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(TArray<FText>& ValidationErrors) override;
+#endif
+	//~End of UObject interface
+
+	/** 检查预设配置，返回是否可用 */
+	bool Validate(TArray<FText>& OutErrors) const;
+
+	/** 预设 ID，为空时使用资源名 */
+	FName GetPresetId() const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Joy|Camera", DisplayName = "预设 ID")
+	FName PresetId{};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Joy|Camera", DisplayName = "修改层优先级")
+	int32 Priority = 0;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Joy|Camera", DisplayName = "修改层混合方式")
+	EJoyCameraModifyBlendMode BlendMode = EJoyCameraModifyBlendMode::Override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Joy|Camera", DisplayName = "相机修改设置")
+	FCameraModifiers CameraModifiers{};
+};
+
+/**
+ * 相机修改预设注册表
+ *
+ * 启动时加载 UJoyGlobalGameSettings 中配置的全部预设并校验，校验失败或 ID 重复的预设不会被注册。
+ * 预设由 UJoyAssetManager 常驻内存，注册表只保存只读引用。
+ */
+class ORIGINALGAME_API FJoyCameraModifierPresetRegistry
+{
+public:
+	static void Initialize();
+
+	static const UJoyCameraModifierPreset* Find(FName PresetId);
+
+private:
+	static TMap<FName, const UJoyCameraModifierPreset*> Presets;
+};
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 临界阻尼弹簧
+ *
+ * 一帧内把目标视为从上一帧的位置匀速移动到当前位置，按这段运动下弹簧方程的精确解推进。
+ * 同一段匀速运动拆成任意多帧推进的结果与一次推进相同，因此降低相机更新频率时手感保持一致，
+ * 不会像 VInterpTo 那样随帧率变化。目标匀速移动时弹簧稳定地落后 2 * 速度 / AngularFrequency。
+ */
+struct FJoyCameraSpring
+{
+	/**
+	 * @param AngularFrequency	角频率，越大追得越快，从静止开始约 6.6 / AngularFrequency 秒后误差降到 1% 以内
+	 */
+	static void Update(FVector& InOutValue, FVector& InOutVelocity, const FVector& PrevTarget, const FVector& Target,
+		float AngularFrequency, float DeltaTime)
+	{
+		if (DeltaTime <= 0.f)
+		{
+			return;
+		}
+
+		if (AngularFrequency <= 0.f)
+		{
+			InOutValue = Target;
+			InOutVelocity = FVector::ZeroVector;
+			return;
+		}
+
+		// 匀速目标的特解落后目标 2 * 速度 / 角频率，相对特解的偏差按齐次方程的闭式解衰减
+		const FVector TargetVelocity = (Target - PrevTarget) / DeltaTime;
+		const FVector TrailOffset = TargetVelocity * (2.f / AngularFrequency);
+		const FVector Offset = InOutValue - (PrevTarget - TrailOffset);
+		const FVector OffsetVelocity = InOutVelocity - TargetVelocity;
+		const FVector Temp = (OffsetVelocity + Offset * AngularFrequency) * DeltaTime;
+		const float Decay = FMath::Exp(-AngularFrequency * DeltaTime);
+
+		InOutValue = Target - TrailOffset + (Offset + Temp) * Decay;
+		InOutVelocity = TargetVelocity + (OffsetVelocity - Temp * AngularFrequency) * Decay;
+	}
+};
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraStats.h"
+
+DEFINE_STAT(STAT_JoyCamera_DoUpdateCamera);
+DEFINE_STAT(STAT_JoyCamera_InternalUpdateCamera);
+DEFINE_STAT(STAT_JoyCamera_PrepareViewTargets);
+DEFINE_STAT(STAT_JoyCamera_UpdateCameraControllers);
+DEFINE_STAT(STAT_JoyCamera_UpdateArmLocation);
+DEFINE_STAT(STAT_JoyCamera_UpdateModifiers);
+DEFINE_STAT(STAT_JoyCamera_BlendViewTargetCameras);
+DEFINE_STAT(STAT_JoyCamera_UpdateActorTransform);
+DEFINE_STAT(STAT_JoyCamera_UpdateViewTarget);
+DEFINE_STAT(STAT_JoyCamera_BlendViewInfo);
+DEFINE_STAT(STAT_JoyCamera_ScreenFade);
+DEFINE_STAT(STAT_JoyCamera_ProcessViewRotation);
+DEFINE_STAT(STAT_JoyCamera_UpdateConfig);
+DEFINE_STAT(STAT_JoyCamera_UpdatePreventPenetration);
+
+DEFINE_STAT(STAT_JoyCamera_ActiveViewTargets);
+DEFINE_STAT(STAT_JoyCamera_ActiveModifiers);
+DEFINE_STAT(STAT_JoyCamera_PenetrationSweeps);
+DEFINE_STAT(STAT_JoyCamera_PenetrationCachedBlocks);
+DEFINE_STAT(STAT_JoyCamera_ConfigRecomputes);
+DEFINE_STAT(STAT_JoyCamera_ReusedViews);
+
+#if JOY_CAMERA_WITH_STAGE_PROFILER
+bool FJoyCameraStageProfiler::bEnabled = false;
+
+TMap<const TCHAR*, FJoyCameraStageProfiler::FStageResult> FJoyCameraStageProfiler::Stages;
+
+void FJoyCameraStageProfiler::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+	bEnabled = bInEnabled;
+}
+
+void FJoyCameraStageProfiler::Reset()
+{
+	check(IsInGameThread());
+	Stages.Reset();
+}
+
+void FJoyCameraStageProfiler::AddSample(const TCHAR* StageName, uint64 Cycles)
+{
+	// 阶段只在游戏线程上执行，以字面量地址为键，避免计时期间构造字符串
+	FStageResult& Stage = Stages.FindOrAdd(StageName);
+	Stage.TotalCycles += Cycles;
+	Stage.NumCalls++;
+}
+
+TArray<FJoyCameraStageProfiler::FStageResult> FJoyCameraStageProfiler::GetResults()
+{
+	// 同名阶段在不同编译单元中可能对应不同的字面量地址，这里按名字合并
+	TMap<FString, FStageResult> MergedStages;
+	for (const auto& Pair : Stages)
+	{
+		FStageResult& Merged = MergedStages.FindOrAdd(Pair.Key);
+		Merged.StageName = Pair.Key;
+		Merged.TotalCycles += Pair.Value.TotalCycles;
+		Merged.NumCalls += Pair.Value.NumCalls;
+	}
+
+	TArray<FStageResult> Results;
+	MergedStages.GenerateValueArray(Results);
+	Results.Sort([](const FStageResult& A, const FStageResult& B) { return A.TotalCycles > B.TotalCycles; });
+	return Results;
+}
+#endif
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("JoyCamera"), STATGROUP_JoyCamera, STATCAT_Advanced);
+
+/** ****************** 相机管线各阶段耗时 ****************** */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DoUpdateCamera"), STAT_JoyCamera_DoUpdateCamera, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("InternalUpdateCamera"), STAT_JoyCamera_InternalUpdateCamera, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("PrepareViewTargets"), STAT_JoyCamera_PrepareViewTargets, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("UpdateCameraControllers"), STAT_JoyCamera_UpdateCameraControllers, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("UpdateArmLocation"), STAT_JoyCamera_UpdateArmLocation, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateModifiers"), STAT_JoyCamera_UpdateModifiers, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("BlendViewTargetCameras"), STAT_JoyCamera_BlendViewTargetCameras, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("UpdateActorTransform"), STAT_JoyCamera_UpdateActorTransform, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateViewTarget"), STAT_JoyCamera_UpdateViewTarget, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BlendViewInfo"), STAT_JoyCamera_BlendViewInfo, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ScreenFade"), STAT_JoyCamera_ScreenFade, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("ProcessViewRotation"), STAT_JoyCamera_ProcessViewRotation, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateConfig"), STAT_JoyCamera_UpdateConfig, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("UpdatePreventPenetration"), STAT_JoyCamera_UpdatePreventPenetration, STATGROUP_JoyCamera, ORIGINALGAME_API);
+
+/** ****************** 相机管线每帧计数 ****************** */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Active View Targets"), STAT_JoyCamera_ActiveViewTargets, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Active Modifiers"), STAT_JoyCamera_ActiveModifiers, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Penetration Sweeps"), STAT_JoyCamera_PenetrationSweeps, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Penetration Cached Blocks"), STAT_JoyCamera_PenetrationCachedBlocks, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Config Recomputes"), STAT_JoyCamera_ConfigRecomputes, STATGROUP_JoyCamera, ORIGINALGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Reused Camera Views"), STAT_JoyCamera_ReusedViews, STATGROUP_JoyCamera, ORIGINALGAME_API);
+
+#define JOY_CAMERA_WITH_STAGE_PROFILER !UE_BUILD_SHIPPING
+
+#if JOY_CAMERA_WITH_STAGE_PROFILER
+/**
+ * 相机管线阶段计时，供回放基准测试统计每个阶段的耗时。
+ * 默认关闭，关闭时每个阶段只多一次分支判断。
+ */
+class ORIGINALGAME_API FJoyCameraStageProfiler
+{
+public:
+	struct FStageResult
+	{
+		FString StageName;
+
+		uint64 TotalCycles = 0;
+
+		uint32 NumCalls = 0;
+	};
+
+	static bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	static void SetEnabled(bool bInEnabled);
+
+	static void Reset();
+
+	static void AddSample(const TCHAR* StageName, uint64 Cycles);
+
+	/** 只计次数的阶段，例如每帧的检测次数 */
+	static void AddCount(const TCHAR* StageName)
+	{
+		if (bEnabled)
+		{
+			AddSample(StageName, 0);
+		}
+	}
+
+	/** 按阶段名汇总的结果，按总耗时降序排列 */
+	static TArray<FStageResult> GetResults();
+
+private:
+	static bool bEnabled;
+
+	static TMap<const TCHAR*, FStageResult> Stages;
+};
+
+struct FJoyCameraStageScope
+{
+	explicit FJoyCameraStageScope(const TCHAR* InStageName)
+		: StageName(FJoyCameraStageProfiler::IsEnabled() ? InStageName : nullptr)
+		, StartCycles(StageName != nullptr ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FJoyCameraStageScope()
+	{
+		if (StageName != nullptr)
+		{
+			FJoyCameraStageProfiler::AddSample(StageName, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	const TCHAR* StageName;
+
+	uint64 StartCycles;
+};
+
+#define JOY_CAMERA_STAGE_SCOPE(Stat) FJoyCameraStageScope JoyCameraStageScope_##Stat(TEXT(#Stat))
+#define JOY_CAMERA_STAGE_COUNT(Stat) FJoyCameraStageProfiler::AddCount(TEXT(#Stat))
+#else
+#define JOY_CAMERA_STAGE_SCOPE(Stat)
+#define JOY_CAMERA_STAGE_COUNT(Stat)
+#endif
+
+/**
+ * 同时记录 Cycle Stat、Insights CPU 事件与回放阶段计时。
+ * 关闭 STATS 的构建（Test、Shipping）中 SCOPE_CYCLE_COUNTER 为空，仍可通过 Insights 查看各阶段耗时。
+ */
+#define JOY_CAMERA_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat);               \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat);     \
+	JOY_CAMERA_STAGE_SCOPE(Stat)
+
+/** 同时累加 DWORD Stat 与回放阶段计数 */
+#define JOY_CAMERA_INC_DWORD_STAT(Stat) \
+	INC_DWORD_STAT(Stat);               \
+	JOY_CAMERA_STAGE_COUNT(Stat)
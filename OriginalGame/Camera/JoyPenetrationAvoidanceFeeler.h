@@ -39,6 +39,14 @@ struct FJoyPenetrationAvoidanceFeeler
 	UPROPERTY(transient)
 	int32 FramesUntilNextTrace;
 
+	/** 根据相机臂运动与最近命中调度后实际使用的检测间隔 */
+	UPROPERTY(transient)
+	int32 ScheduledTraceInterval;
+
+	/** 距离上次命中的帧数 */
+	UPROPERTY(transient)
+	int32 FramesSinceLastHit;
+
 	UPROPERTY()
 	bool bBlurDetection{false};
 
@@ -49,6 +57,8 @@ struct FJoyPenetrationAvoidanceFeeler
 		, Extent(0)
 		, TraceInterval(0)
 		, FramesUntilNextTrace(0)
+		, ScheduledTraceInterval(0)
+		, FramesSinceLastHit(MAX_int32)
 		, bBlurDetection(false)
 	{
 	}
@@ -62,6 +72,8 @@ struct FJoyPenetrationAvoidanceFeeler
 		, Extent(InExtent)
 		, TraceInterval(InTraceInterval)
 		, FramesUntilNextTrace(InFramesUntilNextTrace)
+		, ScheduledTraceInterval(InTraceInterval)
+		, FramesSinceLastHit(MAX_int32)
 		, bBlurDetection(InBlurDetection)
 	{
 	}
@@ -1,24 +1,33 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 #include "JoyPlayerCameraManager.h"
 
+#include "Algo/Compare.h"
+#include "Async/ParallelFor.h"
 #include "Camera/CameraModifier.h"
 #include "Character/JoyCharacter.h"
 #include "Components/CapsuleComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
 #include "GameDelegates.h"
 #include "GameFramework/PlayerController.h"
 #include "Gameplay/Gravity/JoyGravityManageSubsystem.h"
 #include "Gameplay/JoyCharacterControlManageSubsystem.h"
 #include "Gameplay/TimeDilation/JoyTimeDilationManageSubsystem.h"
 #include "JoyCameraComponent.h"
+#include "JoyCameraCurveCache.h"
+#include "JoyCameraStats.h"
 #include "JoyGameBlueprintLibrary.h"
 #include "Controller/JoyCameraConfigController.h"
 #include "Controller/JoyCameraInputController.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Memory/MemoryView.h"
 #include "Player/JoyPlayerController.h"
+#include "Replay/JoyCameraReplay.h"
 
 class AJoyHeroCharacter;
-DECLARE_CYCLE_STAT(TEXT("Camera ProcessViewRotation"), STAT_Camera_ProcessViewRotation, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarParallelModifierThreshold(TEXT("Joy.Camera.ParallelModifierThreshold"), 8,
+	TEXT("同一帧更新的相机 Modifier 数量达到该值时并行计算"),
+	ECVF_Default);
 
 FVirtualCamera& FVirtualCamera::operator=(const FVirtualCamera& Other)
 {
@@ -28,24 +37,106 @@ FVirtualCamera& FVirtualCamera::operator=(const FVirtualCamera& Other)
 
 void FVirtualCamera::CopyCamera(const FVirtualCamera& Other)
 {
-	ArmCenterOffset = Other.ArmCenterOffset;
-	ArmLength = Other.ArmLength;
-	MinArmLength = Other.MinArmLength;
-	MaxArmLength = Other.MaxArmLength;
-	LocalArmCenterOffset = Other.LocalArmCenterOffset;
-	WorldArmOffsetAdditional = Other.WorldArmOffsetAdditional;
-	Fov = Other.Fov;
-	ArmCenterRotation = Other.ArmCenterRotation;
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		VectorStore(VectorLoad(Other.GetLaneData(Lane)), GetLaneData(Lane));
+	}
 }
 
-void FVirtualCamera::SetArmCenterOffset(const FVector& NewArmCenterOffset)
+void FJoyCameraSocketCache::Reset()
 {
-	ArmCenterOffset = NewArmCenterOffset;
+	MeshComponent.Reset();
+	MeshAsset.Reset();
+	SocketLocalTransform = FTransform::Identity;
+	BoneIndex = INDEX_NONE;
+	bResolved = false;
 }
 
-void FVirtualCamera::SetArmCenterRotation(const FRotator& NewArmCenterRotation)
+void FJoyCameraSocketCache::Resolve(const APawn* TargetPawn, FName SocketName)
 {
-	ArmCenterRotation = NewArmCenterRotation;
+	Reset();
+	bResolved = true;
+
+	const auto* SkeletalComp = TargetPawn->FindComponentByClass<USkeletalMeshComponent>();
+	if (SkeletalComp == nullptr)
+	{
+		return;
+	}
+
+	MeshComponent = SkeletalComp;
+	MeshAsset = SkeletalComp->GetSkeletalMeshAsset();
+
+	const USkeletalMesh* SkeletalMeshAsset = MeshAsset.Get();
+	if (SkeletalMeshAsset == nullptr)
+	{
+		return;
+	}
+
+	// 与 USkeletalMeshComponent::GetSocketLocation 一致：挂点须存在于骨架上，网格体上的同名挂点优先
+	const USkeleton* Skeleton = SkeletalMeshAsset->GetSkeleton();
+	if (Skeleton == nullptr || Skeleton->FindSocket(SocketName) == nullptr)
+	{
+		return;
+	}
+
+	if (const USkeletalMeshSocket* Socket = SkeletalMeshAsset->FindSocket(SocketName))
+	{
+		BoneIndex = SkeletalComp->GetBoneIndex(Socket->BoneName);
+		SocketLocalTransform = Socket->GetSocketLocalTransform();
+	}
+}
+
+bool FJoyCameraSocketCache::GetSocketLocation(const APawn* TargetPawn, FName SocketName, FVector& OutLocation)
+{
+	const USkeletalMeshComponent* SkeletalComp = MeshComponent.Get();
+	const bool bMeshChanged = SkeletalComp != nullptr ? SkeletalComp->GetSkeletalMeshAsset() != MeshAsset.Get()
+													  : MeshComponent.IsStale();
+	if (!bResolved || bMeshChanged)
+	{
+		Resolve(TargetPawn, SocketName);
+		SkeletalComp = MeshComponent.Get();
+	}
+
+	if (SkeletalComp == nullptr || BoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutLocation = (SocketLocalTransform * SkeletalComp->GetBoneTransform(BoneIndex)).GetLocation();
+	return true;
+}
+
+namespace JoyCameraSocket
+{
+	static const FName CameraPoint(TEXT("CameraPoint"));
+	static const FName FacePoint(TEXT("FacePoint"));
+}
+
+namespace JoyCameraFade
+{
+	static VectorRegister4Float MakeLaneMask(bool bX, bool bY, bool bZ, bool bW)
+	{
+		return MakeVectorRegisterFloatMask(
+			bX ? 0xFFFFFFFF : 0, bY ? 0xFFFFFFFF : 0, bZ ? 0xFFFFFFFF : 0, bW ? 0xFFFFFFFF : 0);
+	}
+
+	/**
+	 * 按通道掩码混合单个相机：掩码内的通道取 From -> To 的线性插值，其余通道直接取 Desired。
+	 * To 与 Desired 仅在弹簧臂旋转一组上不同（Pitch、Yaw 的淡入目标来自配置）。
+	 */
+	static void BlendCamera(const FVirtualCamera& From, const FVirtualCamera& Desired,
+		const VectorRegister4Float (&To)[FVirtualCamera::NumLanes],
+		const VectorRegister4Float (&LaneMasks)[FVirtualCamera::NumLanes], const VectorRegister4Float& Alpha,
+		FVirtualCamera& Out)
+	{
+		for (int32 Lane = 0; Lane < FVirtualCamera::NumLanes; ++Lane)
+		{
+			const VectorRegister4Float FromValue = VectorLoad(From.GetLaneData(Lane));
+			const VectorRegister4Float DesiredValue = VectorLoad(Desired.GetLaneData(Lane));
+			const VectorRegister4Float Blended = VectorMultiplyAdd(VectorSubtract(To[Lane], FromValue), Alpha, FromValue);
+			VectorStore(VectorSelect(LaneMasks[Lane], Blended, DesiredValue), Out.GetLaneData(Lane));
+		}
+	}
 }
 
 void AJoyPlayerCameraManager::BlendViewInfo(FMinimalViewInfo& A, FMinimalViewInfo& B, float T)
@@ -114,52 +205,44 @@ void AJoyPlayerCameraManager::UpdateCameraConfigs(UJoyCameraComponent* CameraCom
 		return;
 	}
 
-	if (CameraComponent->IsCameraConfigDirty())
+	const uint32 StackVersion = CameraComponent->GetCameraIDStackVersion();
+	const bool bSameComponent = CameraConfigDescription.SourceCameraComponent.Get() == CameraComponent;
+	if (bSameComponent && !CameraConfigDescription.bForceUpdateCameraConfigSet &&
+		CameraConfigDescription.CameraStackVersion == StackVersion)
+	{
+		return;
+	}
+
+	TArray<FName>& CameraStack = CameraConfigDescription.CameraStack;
+	const TConstArrayView<FName> SubCameraIDs = CameraComponent->GetCameraIDs();
+	if (bSameComponent && !CameraConfigDescription.bForceUpdateCameraConfigSet)
 	{
-		const TArray<FName> SubCameraIDs = CameraComponent->GetCameraIDs();
-		if (SubCameraIDs.Num() < CameraConfigDescription.CameraStack.Num() && CameraConfigDescription.CameraStack.Num()
-		    > 0)
+		if (SubCameraIDs.Num() < CameraStack.Num() && CameraStack.Num() > 0)
 		{
-			CameraConfigDescription.FadeOutCamera = CameraConfigDescription.CameraStack[
-				CameraConfigDescription.CameraStack.Num() - 1];
+			CameraConfigDescription.FadeOutCamera = CameraStack.Last();
 		}
 
-		CameraConfigDescription.CameraStack = SubCameraIDs;
-		CameraComponent->RefreshCameraConfig();
+		CameraStack.Reset();
+		CameraStack.Append(SubCameraIDs.GetData(), SubCameraIDs.Num());
 		if (CameraConfigController != nullptr)
 		{
 			CameraConfigController->MarkDirty();
 		}
-
-		CameraConfigDescription.bForceUpdateCameraConfigSet = false;
 	}
-	else if (CameraConfigDescription.bForceUpdateCameraConfigSet)
+	else if (!Algo::Compare(CameraStack, SubCameraIDs))
 	{
-		const auto& CameraIDs = CameraComponent->GetCameraIDs();
-		bool bCameraConfigEqual = (CameraConfigDescription.CameraStack.Num() == CameraIDs.Num());
-		if (bCameraConfigEqual)
-		{
-			for (int i = 0; i < CameraIDs.Num(); i++)
-			{
-				if (CameraConfigDescription.CameraStack[i] != CameraIDs[i])
-				{
-					bCameraConfigEqual = false;
-					break;
-				}
-			}
-		}
-
-		if (!bCameraConfigEqual)
+		// 切换了相机组件，镜头 ID 栈相同时不需要重新过渡
+		CameraStack.Reset();
+		CameraStack.Append(SubCameraIDs.GetData(), SubCameraIDs.Num());
+		if (CameraConfigController != nullptr)
 		{
-			CameraConfigDescription.CameraStack = CameraIDs;
-			if (CameraConfigController != nullptr)
-			{
-				CameraConfigController->MarkDirty();
-			}
+			CameraConfigController->MarkDirty();
 		}
-
-		CameraConfigDescription.bForceUpdateCameraConfigSet = false;
 	}
+
+	CameraConfigDescription.SourceCameraComponent = CameraComponent;
+	CameraConfigDescription.CameraStackVersion = StackVersion;
+	CameraConfigDescription.bForceUpdateCameraConfigSet = false;
 }
 
 void AJoyPlayerCameraManager::UpdateCameraControllers(float DeltaTime)
@@ -167,13 +250,13 @@ void AJoyPlayerCameraManager::UpdateCameraControllers(float DeltaTime)
 	if (CameraConfigController != nullptr)
 	{
 		const AActor* TargetCameraOwner = PendingViewTarget.Target;
-		if (TargetCameraOwner == nullptr || !TargetCameraOwner->IsA<AJoyHeroCharacter>() ||
-		    UJoyCameraComponent::FindCameraComponent(TargetCameraOwner) == nullptr)
+		UJoyCameraComponent* Camera = FindViewTargetCamera(TargetCameraOwner);
+		if (TargetCameraOwner == nullptr || !TargetCameraOwner->IsA<AJoyHeroCharacter>() || Camera == nullptr)
 		{
-			TargetCameraOwner = ViewTarget.Target;
+			Camera = FindViewTargetCamera(ViewTarget.Target);
 		}
 
-		if (auto* Camera = UJoyCameraComponent::FindCameraComponent(TargetCameraOwner))
+		if (Camera != nullptr)
 		{
 			UpdateCameraConfigs(Camera);
 		}
@@ -185,59 +268,16 @@ void AJoyPlayerCameraManager::UpdateCameraControllers(float DeltaTime)
 	{
 		CameraInputController->Update(DeltaTime);
 	}
-
-	for (auto ItViewTarget = MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateConstIterator(); ItViewTarget;
-	     ++ItViewTarget)
-	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		const FViewTargetCameraInfo& CameraInfo = ItViewTarget.Value();
-
-		if (NewViewTarget.Get() == nullptr)
-		{
-			continue;
-		}
-
-		if (!NeedUpdateViewTarget(NewViewTarget.Get(), CameraInfo))
-		{
-			continue;
-		}
-
-		if (CameraInfo.CameraModifierController != nullptr)
-		{
-			CameraInfo.CameraModifierController->Update(DeltaTime);
-		}
-	}
 }
 
-void AJoyPlayerCameraManager::UpdateViewTargetPose()
+void AJoyPlayerCameraManager::UpdateViewTargetPose(FViewTargetCameraInfo& CameraInfo, const AActor* ControlCharacter) const
 {
-	const auto* CharacterControlManager = UJoyCharacterControlManageSubsystem::Get(GetWorld());
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
+	const AActor* CachedViewTarget = CameraInfo.ViewTarget.Get();
+	if (CachedViewTarget == ControlCharacter || CachedViewTarget == ViewTarget.Target ||
+	    CachedViewTarget == PendingViewTarget.Target)
 	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& CameraInfo = ItViewTarget.Value();
-
-		if (NewViewTarget.Get() == nullptr)
-		{
-			continue;
-		}
-
-		bool bViewTargetFound = false;
-		if (CharacterControlManager)
-		{
-			if (NewViewTarget == CharacterControlManager->GetCurrentControlCharacter())
-			{
-				bViewTargetFound = true;
-			}
-		}
-
-		if (bViewTargetFound || NewViewTarget == ViewTarget.Target || NewViewTarget == PendingViewTarget.Target)
-		{
-			// 此处做一些对 DesiredCamera 数据的重置操作
-			CameraInfo.DesiredCamera.ArmCenterRotation = CameraInfo.CurrentCamera.ArmCenterRotation;
-		}
+		// 此处做一些对 DesiredCamera 数据的重置操作
+		CameraInfo.DesiredCamera.SetArmCenterRotation(CameraInfo.CurrentCamera.GetArmCenterRotation());
 	}
 }
 
@@ -265,17 +305,58 @@ bool AJoyPlayerCameraManager::NeedUpdateViewTarget(AActor* InViewTarget, const F
 	return false;
 }
 
-void AJoyPlayerCameraManager::ClearUnusedViewTargets()
+void AJoyPlayerCameraManager::ActivateViewTarget(const FViewTargetCameraHandle& Handle)
 {
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
+	if (MultiViewTargetCameraManager.IsActive(Handle))
+	{
+		return;
+	}
+
+	if (FViewTargetCameraInfo* CameraInfo = MultiViewTargetCameraManager.Resolve(Handle))
+	{
+		// 非活跃期间标记不会被重置，加入时先清空
+		CameraInfo->ModifiedChannels = EJoyCameraChannel::None;
+
+		MultiViewTargetCameraManager.Activate(Handle);
+	}
+}
+
+void AJoyPlayerCameraManager::PrepareViewTargets()
+{
+	// 非活跃的 ViewTarget 每帧只抽查少量，用于回收已销毁的 Actor
+	constexpr int32 InactiveStaleCleanupBudget = 4;
+	MultiViewTargetCameraManager.RemoveStaleInactive(InactiveStaleCleanupBudget);
+
+	// ViewTarget 可能经由引擎内部流程被替换，每帧确保它们处于活跃集合中
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(ViewTarget.Target));
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(PendingViewTarget.Target));
+
+	const auto* CharacterControlManager = UJoyCharacterControlManageSubsystem::Get(GetWorld());
+	const AActor* ControlCharacter =
+		CharacterControlManager != nullptr ? CharacterControlManager->GetCurrentControlCharacter() : nullptr;
+
+	// 倒序遍历，删除时换入的元素已经处理过
+	for (int32 Index = MultiViewTargetCameraManager.NumActive() - 1; Index >= 0; --Index)
 	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		if (NewViewTarget.Get() == nullptr)
+		FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+
+		// 清理无用 View Targets
+		if (CameraInfo.ViewTarget.Get() == nullptr)
 		{
-			ItViewTarget.RemoveCurrent();
+			MultiViewTargetCameraManager.RemoveAt(Index);
+			continue;
 		}
+
+		/*
+		 * 预备修改相机参数前，设置 DesiredCamera 的 ArmRotation 相关参数
+		 * ArmRotation -> 重置为 PlayerController 的方向
+		 */
+		UpdateViewTargetPose(CameraInfo, ControlCharacter);
+
+		/*
+		 * 一部分相机参数修改后，会记录到修改通道中，于是在每帧修改之前，需把修改通道清空
+		 */
+		CameraInfo.ModifiedChannels = EJoyCameraChannel::None;
 	}
 }
 
@@ -290,154 +371,190 @@ void AJoyPlayerCameraManager::InternalUpdateCamera(float DeltaTime)
 	 *的基础上计算出来， 例如在 Fading 过程中，CurrentCamera 由 LastCamera 和
 	 *DesiredCamera 之间插值计算 得到。CurrentCamera
 	 *最终提供给外部，用于决定相机位置朝向。
+	 *
+	 * PrepareViewTargets 负责清理与重置；Config、Input 这类全局 Controller 执行完毕后，
+	 * UpdateViewTargets 先对活跃集合执行 Modifier，再整体将 DesiredCamera 混合到 CurrentCamera，最后收尾。
 	 */
+	JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_InternalUpdateCamera);
 
-	// 清理无用 View Targets
-	ClearUnusedViewTargets();
-
-	/*
-	 * 预备修改相机参数前，设置 DesiredCamera 的 ArmRotation 相关参数
-	 * ArmRotation -> 重置为 PlayerController 的方向
-	 */
-	UpdateViewTargetPose();
-
-	/*
-	 * 一部分相机参数修改后，会记录到标志位，于是在每帧修改之前，需把这些标志位置为
-	 * false
-	 */
-	ResetModifiedMarkers();
+	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_PrepareViewTargets);
+		PrepareViewTargets();
+	}
 
 	// 调整镜头位姿
-	UpdateCameraControllers(DeltaTime);
+	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateCameraControllers);
+		UpdateCameraControllers(DeltaTime);
+	}
 
 	// 还没实现，目前看也没必要
-	UpdateArmLocation(DeltaTime);
+	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateArmLocation);
+		UpdateArmLocation(DeltaTime);
+	}
 
-	/*
-	 * 上述代码修改过后的参数保留在 DesiredCamera 中，SyncDesireCameraData 将
-	 * DesiredCamera 数据同步到 CurrentCamera 中
-	 */
-	SyncDesireCameraData(DeltaTimeThisFrame_IgnoreTimeDilation);
-
-	/*
-	 * CurrentCamera 计算好之后做的一些扫尾工作
-	 */
-	UpdateActorTransform(DeltaTime);
+	UpdateViewTargets(DeltaTime);
 
 	bMoveInput = false;
 }
 
-void AJoyPlayerCameraManager::SyncDesireCameraData(float DeltaTime)
+void AJoyPlayerCameraManager::UpdateViewTargets(float DeltaTime)
 {
-	CameraConfigFadingDescription.ElapseTime += DeltaTime;
+	CameraConfigFadingDescription.ElapseTime += DeltaTimeThisFrame_IgnoreTimeDilation;
 	if (CameraConfigFadingDescription.bDuringFading && CameraConfigFadingDescription.ElapseTime >=
 	    CameraConfigFadingDescription.Duration)
 	{
 		EndCurrentCameraFadingProcess();
 	}
 
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
+	/*
+	 * 只遍历活跃集合。Modifier 分三个阶段更新：游戏线程收集、计算（数量超过阈值时并行）、游戏线程处理结束修改的副作用。
+	 * 计算阶段每个 Modifier 只读写自身与所修改 ViewTarget 的相机数据，结果与线程数无关。
+	 * Modifier 结束时可能切换 ViewTarget 并激活新的相机数据，新数据追加在活跃集合末尾，循环处理直至没有新增
+	 */
 	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& CameraInfo = ItViewTarget.Value();
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateModifiers);
 
-		if (NewViewTarget.Get() == nullptr)
+		TArray<UJoyCameraModifierController*, TInlineAllocator<16>> PendingModifiers;
+		int32 NumProcessed = 0;
+		while (NumProcessed < MultiViewTargetCameraManager.NumActive())
 		{
-			continue;
-		}
+			const int32 NumActive = MultiViewTargetCameraManager.NumActive();
+			PendingModifiers.Reset();
+			for (int32 Index = NumProcessed; Index < NumActive; ++Index)
+			{
+				const FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+				AActor* CachedViewTarget = CameraInfo.ViewTarget.Get();
+				if (CachedViewTarget == nullptr || !NeedUpdateViewTarget(CachedViewTarget, CameraInfo))
+				{
+					continue;
+				}
 
-		if (!NeedUpdateViewTarget(NewViewTarget.Get(), CameraInfo))
-		{
-			continue;
-		}
+				UJoyCameraModifierController* ModifierController = CameraInfo.CameraModifierController;
+				if (ModifierController != nullptr && ModifierController->IsActive())
+				{
+					if (ModifierController->IsModifiedAndNeedUpdate())
+					{
+						INC_DWORD_STAT(STAT_JoyCamera_ActiveModifiers);
+					}
 
-		if (!CameraConfigFadingDescription.bDuringFading)
-		{
-			CameraInfo.CurrentCamera.CopyCamera(CameraInfo.DesiredCamera);
-			continue;
-		}
+					if (ModifierController->PreUpdate(DeltaTime))
+					{
+						PendingModifiers.Add(ModifierController);
+					}
+				}
+			}
+			NumProcessed = NumActive;
 
-		if (!CameraInfo.bNeedFading)
-		{
-			CameraInfo.CurrentCamera.CopyCamera(CameraInfo.DesiredCamera);
-			continue;
-		}
+			const bool bParallel = PendingModifiers.Num() >= CVarParallelModifierThreshold.GetValueOnGameThread();
+			ParallelFor(
+				PendingModifiers.Num(), [&PendingModifiers](int32 Index) { PendingModifiers[Index]->ComputeUpdate(); },
+				bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-		const float BlendAlpha = FMath::Clamp(CameraConfigFadingDescription.ElapseTime / CameraConfigFadingDescription.Duration, 0, 1);
-		if (CameraInfo.bFadeArmLength && !CameraInfo.bCameraArmLength_HasModified)
-		{
-			CameraInfo.CurrentCamera.ArmLength =
-				FMath::Lerp(CameraInfo.LastCamera.ArmLength, CameraInfo.DesiredCamera.ArmLength, BlendAlpha);
-		}
-		else
-		{
-			CameraInfo.bFadeArmLength = false;
-			CameraInfo.CurrentCamera.ArmLength = CameraInfo.DesiredCamera.ArmLength;
+			for (UJoyCameraModifierController* ModifierController : PendingModifiers)
+			{
+				ModifierController->PostUpdate();
+			}
 		}
 
-		if (CameraInfo.bFadeArmLengthRange)
-		{
-			CameraInfo.CurrentCamera.MinArmLength =
-				FMath::Lerp(CameraInfo.LastCamera.MinArmLength, CameraInfo.DesiredCamera.MinArmLength, BlendAlpha);
-			CameraInfo.CurrentCamera.MaxArmLength =
-				FMath::Lerp(CameraInfo.LastCamera.MaxArmLength, CameraInfo.DesiredCamera.MaxArmLength, BlendAlpha);
-		}
-		else
+		// 不再是 ViewTarget，且 Modifier 已结束（包括 Fade Out），移出活跃集合；换入的元素尚未检查，下标不变
+		int32 Index = 0;
+		while (Index < MultiViewTargetCameraManager.NumActive())
 		{
-			CameraInfo.CurrentCamera.MinArmLength = CameraInfo.DesiredCamera.MinArmLength;
-			CameraInfo.CurrentCamera.MaxArmLength = CameraInfo.DesiredCamera.MaxArmLength;
+			const FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+			if (!NeedUpdateViewTarget(CameraInfo.ViewTarget.Get(), CameraInfo))
+			{
+				MultiViewTargetCameraManager.DeactivateAt(Index);
+				continue;
+			}
+
+			++Index;
 		}
+	}
 
-		if (CameraInfo.bFadeLocalArmCenterOffset && !CameraInfo.bCameraOffset_HasModified)
-		{
-			CameraInfo.CurrentCamera.LocalArmCenterOffset = FMath::Lerp(
-				CameraInfo.LastCamera.LocalArmCenterOffset, CameraInfo.DesiredCamera.LocalArmCenterOffset, BlendAlpha);
+	SET_DWORD_STAT(STAT_JoyCamera_ActiveViewTargets, MultiViewTargetCameraManager.NumActive());
 
-			CameraInfo.CurrentCamera.WorldArmOffsetAdditional =
-				FMath::Lerp(CameraInfo.LastCamera.WorldArmOffsetAdditional,
-					CameraInfo.DesiredCamera.WorldArmOffsetAdditional, BlendAlpha);
-		}
-		else
-		{
-			CameraInfo.bFadeLocalArmCenterOffset = false;
-			CameraInfo.CurrentCamera.LocalArmCenterOffset = CameraInfo.DesiredCamera.LocalArmCenterOffset;
-			CameraInfo.CurrentCamera.WorldArmOffsetAdditional = CameraInfo.DesiredCamera.WorldArmOffsetAdditional;
-		}
+	/*
+	 * 上述代码修改过后的参数保留在 DesiredCamera 中，此时活跃集合已连续存放，
+	 * 一次性将所有 DesiredCamera 数据同步到 CurrentCamera 中
+	 */
+	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_BlendViewTargetCameras);
+		BlendViewTargetCameras();
+	}
 
-		if (CameraInfo.bFadeArmPitch && !CameraInfo.bArmPitch_HasModified)
-		{
-			CameraInfo.CurrentCamera.ArmCenterRotation.Pitch =
-				FMath::Lerp(CameraInfo.LastCamera.ArmCenterRotation.Pitch, FadingTarget_ArmPitch, BlendAlpha);
-		}
-		else
-		{
-			CameraInfo.bFadeArmPitch = false;
-			CameraInfo.CurrentCamera.ArmCenterRotation.Pitch = CameraInfo.DesiredCamera.ArmCenterRotation.Pitch;
-		}
+	/*
+	 * CurrentCamera 计算好之后做的一些扫尾工作
+	 */
+	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateActorTransform);
 
-		if (CameraInfo.bFadeArmYaw && !CameraInfo.bArmYaw_HasModified)
+		const auto* GravityManager = UJoyGravityManageSubsystem::Get(GetWorld());
+		for (int32 ActiveIndex = 0; ActiveIndex < MultiViewTargetCameraManager.NumActive(); ++ActiveIndex)
 		{
-			CameraInfo.CurrentCamera.ArmCenterRotation.Yaw =
-				FMath::Lerp(CameraInfo.LastCamera.ArmCenterRotation.Yaw, FadingTarget_ArmYaw, BlendAlpha);
+			UpdateActorTransform(MultiViewTargetCameraManager.GetByIndex(ActiveIndex), GravityManager);
 		}
-		else
+	}
+}
+
+void AJoyPlayerCameraManager::BlendViewTargetCameras()
+{
+	const int32 NumActive = MultiViewTargetCameraManager.NumActive();
+	if (!CameraConfigFadingDescription.bDuringFading)
+	{
+		for (int32 Index = 0; Index < NumActive; ++Index)
 		{
-			CameraInfo.bFadeArmYaw = false;
-			CameraInfo.CurrentCamera.ArmCenterRotation.Yaw = CameraInfo.DesiredCamera.ArmCenterRotation.Yaw;
+			FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+			CameraInfo.CurrentCamera.CopyCamera(CameraInfo.DesiredCamera);
 		}
+		return;
+	}
 
-		if (CameraInfo.bFadeCameraFov && !CameraInfo.bCameraFov_HasModified)
+	const float BlendAlpha =
+		FMath::Clamp(CameraConfigFadingDescription.ElapseTime / CameraConfigFadingDescription.Duration, 0.f, 1.f);
+	const VectorRegister4Float AlphaValue = VectorSetFloat1(BlendAlpha);
+
+	for (int32 Index = 0; Index < NumActive; ++Index)
+	{
+		FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+		if (!CameraInfo.bNeedFading)
 		{
-			CameraInfo.CurrentCamera.Fov =
-				FMath::Lerp(CameraInfo.LastCamera.Fov, CameraInfo.DesiredCamera.Fov, BlendAlpha);
+			CameraInfo.CurrentCamera.CopyCamera(CameraInfo.DesiredCamera);
+			continue;
 		}
-		else
-		{
-			CameraInfo.bFadeCameraFov = false;
-			CameraInfo.CurrentCamera.Fov = CameraInfo.DesiredCamera.Fov;
-		}	
+
+		// 被修改过的通道本次淡入不再恢复
+		CameraInfo.FadeChannels &= ~CameraInfo.ModifiedChannels;
+		const EJoyCameraChannel Channels = CameraInfo.FadeChannels;
+
+		const FVirtualCamera& DesiredCamera = CameraInfo.DesiredCamera;
+		const VectorRegister4Float LaneMasks[FVirtualCamera::NumLanes] = {
+			JoyCameraFade::MakeLaneMask(EnumHasAnyFlags(Channels, EJoyCameraChannel::ArmLength),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::ArmLengthRange),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::ArmLengthRange),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Fov)),
+			JoyCameraFade::MakeLaneMask(EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset), false),
+			JoyCameraFade::MakeLaneMask(EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Offset), false),
+			JoyCameraFade::MakeLaneMask(EnumHasAnyFlags(Channels, EJoyCameraChannel::Pitch),
+				EnumHasAnyFlags(Channels, EJoyCameraChannel::Yaw), false, false),
+		};
+		const VectorRegister4Float TargetValues[FVirtualCamera::NumLanes] = {
+			VectorLoad(DesiredCamera.GetLaneData(0)),
+			VectorLoad(DesiredCamera.GetLaneData(1)),
+			VectorLoad(DesiredCamera.GetLaneData(2)),
+			MakeVectorRegisterFloat(FadingTarget_ArmPitch, FadingTarget_ArmYaw, 0.f, 0.f),
+		};
+
+		// 淡入期间 Roll 保持上一帧的结果，不跟随 DesiredCamera
+		const float CurrentArmRoll = CameraInfo.CurrentCamera.GetArmRoll();
+		JoyCameraFade::BlendCamera(
+			CameraInfo.LastCamera, DesiredCamera, TargetValues, LaneMasks, AlphaValue, CameraInfo.CurrentCamera);
+		CameraInfo.CurrentCamera.SetArmRoll(CurrentArmRoll);
 	}
 }
 
@@ -446,51 +563,37 @@ void AJoyPlayerCameraManager::UpdateArmLocation(float DeltaTime)
 	// @TODO
 }
 
-void AJoyPlayerCameraManager::UpdateActorTransform(float DeltaTime)
+void AJoyPlayerCameraManager::UpdateActorTransform(
+	FViewTargetCameraInfo& CameraInfo, const UJoyGravityManageSubsystem* GravityManager)
 {
-	const auto* GravityManager = UJoyGravityManageSubsystem::Get(GetWorld());
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
+	const AActor* CachedViewTarget = CameraInfo.ViewTarget.Get();
+	if (CachedViewTarget == nullptr)
 	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& CameraInfo = ItViewTarget.Value();
-
-		if (NewViewTarget.Get() == nullptr)
-		{
-			continue;
-		}
-
-		if (!NeedUpdateViewTarget(NewViewTarget.Get(), CameraInfo))
-		{
-			continue;
-		}
+		return;
+	}
 
-		// 对局部坐标下的 Rotator 做限制
-		FRotator WorldRotator = CameraInfo.CurrentCamera.ArmCenterRotation;
-		FRotator LocalRotator =
-			GravityManager != nullptr ? GravityManager->WorldRotatorToLocal(WorldRotator) : WorldRotator;
-		LocalRotator.Pitch = FMath::Clamp(LocalRotator.Pitch, MinArmPitch, MaxArmPitch);
-		WorldRotator = GravityManager != nullptr ? GravityManager->LocalRotatorToWorld(LocalRotator) : LocalRotator;
-		
-		// 更新 Controller 的控制方向
-		SetRotationInternal(NewViewTarget.Get(), WorldRotator);
+	// 对局部坐标下的 Rotator 做限制
+	FRotator WorldRotator = CameraInfo.CurrentCamera.GetArmCenterRotation();
+	FRotator LocalRotator =
+		GravityManager != nullptr ? GravityManager->WorldRotatorToLocal(WorldRotator) : WorldRotator;
+	LocalRotator.Pitch = FMath::Clamp(LocalRotator.Pitch, MinArmPitch, MaxArmPitch);
+	WorldRotator = GravityManager != nullptr ? GravityManager->LocalRotatorToWorld(LocalRotator) : LocalRotator;
 
-		// 计算 Camera Offset 对相机臂的偏移影响
-		const FRotator ViewRotator = GetViewTargetViewRotation(NewViewTarget.Get());
-		const FRotator CameraSpace = FRotator(ViewRotator.Pitch, ViewRotator.Yaw, ViewRotator.Roll);
+	// 更新 Controller 的控制方向
+	SetRotationInternal(CachedViewTarget, WorldRotator);
 
-		const FVector ForwardVec = CameraSpace.RotateVector(FVector(1.0, 0.0, 0.0));
-		const FVector RightVec = CameraSpace.RotateVector(FVector(0.0, 1.0, 0.0));
-		const FVector UpVec = CameraSpace.RotateVector(FVector(0.0, 0.0, 1.0));
+	// 计算 Camera Offset 对相机臂的偏移影响
+	const FRotator ViewRotator = GetViewTargetViewRotation(CachedViewTarget);
+	const FRotator CameraSpace = FRotator(ViewRotator.Pitch, ViewRotator.Yaw, ViewRotator.Roll);
 
-		CameraInfo.CurrentCamera.SetArmCenterOffset(CameraInfo.CurrentCamera.LocalArmCenterOffset.X * ForwardVec +
-		                                            CameraInfo.CurrentCamera.LocalArmCenterOffset.Y * RightVec +
-		                                            CameraInfo.CurrentCamera.LocalArmCenterOffset.Z * UpVec);
+	const FVector ForwardVec = CameraSpace.RotateVector(FVector(1.0, 0.0, 0.0));
+	const FVector RightVec = CameraSpace.RotateVector(FVector(0.0, 1.0, 0.0));
+	const FVector UpVec = CameraSpace.RotateVector(FVector(0.0, 0.0, 1.0));
 
-		CameraInfo.CurrentCamera.SetArmCenterOffset(
-			CameraInfo.CurrentCamera.ArmCenterOffset + CameraInfo.CurrentCamera.WorldArmOffsetAdditional);
-	}
+	const FVector LocalArmCenterOffset = CameraInfo.CurrentCamera.GetLocalArmCenterOffset();
+	CameraInfo.ArmCenterOffset = FVector3f(LocalArmCenterOffset.X * ForwardVec + LocalArmCenterOffset.Y * RightVec +
+	                                       LocalArmCenterOffset.Z * UpVec +
+	                                       CameraInfo.CurrentCamera.GetWorldArmOffsetAdditional());
 }
 
 void AJoyPlayerCameraManager::SetRotationInternal(const AActor* InViewTarget, FRotator Rotator)
@@ -513,6 +616,12 @@ void AJoyPlayerCameraManager::SetRotationInternal(const AActor* InViewTarget, FR
 
 void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 {
+	JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_DoUpdateCamera);
+
+#if JOY_CAMERA_WITH_REPLAY
+	FJoyCameraReplayRecorder::BeginFrame(this);
+#endif
+
 	InternalUpdateCamera(DeltaTimeThisFrame_IgnoreTimeDilation);
 
 	FMinimalViewInfo NewPOV = ViewTarget.POV;
@@ -537,6 +646,8 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 	{
 		// Update current view target
 		ViewTarget.CheckViewTarget(PCOwner);
+
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateViewTarget);
 		UpdateViewTarget(ViewTarget, DeltaTimeThisFrame_IgnoreTimeDilation);
 	}
 
@@ -550,7 +661,10 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 
 		// Update pending view target
 		PendingViewTarget.CheckViewTarget(PCOwner);
-		UpdateViewTarget(PendingViewTarget, DeltaTimeThisFrame_IgnoreTimeDilation);
+		{
+			JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_UpdateViewTarget);
+			UpdateViewTarget(PendingViewTarget, DeltaTimeThisFrame_IgnoreTimeDilation);
+		}
 
 		// blend....
 		if (BlendTimeToGo > 0)
@@ -585,10 +699,12 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 			}
 			else
 			{
-				BlendPct = FMath::Clamp(BlendViewCurve->GetFloatValue(DurationPct), 0.f, 1.f);
+				const float CurveValue = BlendViewBakedCurve->GetFloatValue(BlendViewCurve.Get(), DurationPct);
+				BlendPct = FMath::Clamp(CurveValue, 0.f, 1.f);
 			}
 
 			// Update pending view target blend
+			JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_BlendViewInfo);
 			NewPOV = ViewTarget.POV;
 			BlendViewInfo(NewPOV, PendingViewTarget.POV, BlendPct);
 		}
@@ -604,6 +720,7 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 
 			BlendTimeToGo = 0;
 			BlendViewCurve = nullptr;
+			BlendViewBakedCurve.Reset();
 
 			// our camera is now viewing there
 			NewPOV = PendingViewTarget.POV;
@@ -614,6 +731,8 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 
 	if (bEnableFading)
 	{
+		JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_ScreenFade);
+
 		if (bAutoAnimateFade)
 		{
 			FadeTimeRemaining = FMath::Max(FadeTimeRemaining - DeltaTimeThisFrame_IgnoreTimeDilation, 0.0f);
@@ -641,6 +760,10 @@ void AJoyPlayerCameraManager::DoUpdateCamera(float InDeltaTime)
 		bGameCameraCutThisFrame = bGameCameraCutThisFrame || bPhotographyCausedCameraCut;
 	}
 
+#if JOY_CAMERA_WITH_REPLAY
+	FJoyCameraReplayRecorder::EndFrame(this, NewPOV);
+#endif
+
 	// Cache results
 	FillCameraCache(NewPOV);
 }
@@ -654,13 +777,13 @@ void AJoyPlayerCameraManager::AddNewViewTarget(AActor* NewViewTarget)
 
 	// Virtual camera 的默认值
 	FVirtualCamera VirtualCamera{};
-	VirtualCamera.ArmLength = BaseArmLength;
-	VirtualCamera.MinArmLength = MinArmLength;
-	VirtualCamera.MaxArmLength = MaxArmLength;
-	VirtualCamera.Fov = BaseFov;
-	VirtualCamera.LocalArmCenterOffset = GetBaseLocalArmOffset();
-	VirtualCamera.WorldArmOffsetAdditional = FVector::ZeroVector;
-	VirtualCamera.ArmCenterRotation = GetViewTargetViewRotation(NewViewTarget);
+	VirtualCamera.SetArmLength(BaseArmLength);
+	VirtualCamera.SetMinArmLength(MinArmLength);
+	VirtualCamera.SetMaxArmLength(MaxArmLength);
+	VirtualCamera.SetFov(BaseFov);
+	VirtualCamera.SetLocalArmCenterOffset(GetBaseLocalArmOffset());
+	VirtualCamera.SetWorldArmOffsetAdditional(FVector::ZeroVector);
+	VirtualCamera.SetArmCenterRotation(GetViewTargetViewRotation(NewViewTarget));
 	// VirtualCamera.ArmCenterRotation = FRotator::ZeroRotator;
 	MultiViewTargetCameraManager.AddViewTarget(this, NewViewTarget, VirtualCamera);
 }
@@ -668,24 +791,22 @@ void AJoyPlayerCameraManager::AddNewViewTarget(AActor* NewViewTarget)
 void AJoyPlayerCameraManager::InitializeFor(APlayerController* PC)
 {
 	// 初始化 CurrentCamera
-	for (TPair<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>& ModifierContainer :
-	     MultiViewTargetCameraManager.ViewTargetCameraInfos)
+	for (int32 Index = 0; Index < MultiViewTargetCameraManager.Num(); ++Index)
 	{
-		auto NewViewTarget = ModifierContainer.Key;
-		FViewTargetCameraInfo& CameraInfo = ModifierContainer.Value;
-		if (!NeedUpdateViewTarget(NewViewTarget.Get(), CameraInfo))
+		FViewTargetCameraInfo& CameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+		if (!NeedUpdateViewTarget(CameraInfo.ViewTarget.Get(), CameraInfo))
 		{
 			continue;
 		}
 
 		// 初始化 CameraInfo.CurrentCamera
-		CameraInfo.CurrentCamera.ArmLength = BaseArmLength;
-		CameraInfo.CurrentCamera.MinArmLength = MinArmLength;
-		CameraInfo.CurrentCamera.MaxArmLength = MaxArmLength;
-		CameraInfo.CurrentCamera.Fov = BaseFov;
-		CameraInfo.CurrentCamera.LocalArmCenterOffset = GetBaseLocalArmOffset();
-		CameraInfo.CurrentCamera.WorldArmOffsetAdditional = FVector::ZeroVector;
-		CameraInfo.CurrentCamera.ArmCenterRotation = FRotator::ZeroRotator;
+		CameraInfo.CurrentCamera.SetArmLength(BaseArmLength);
+		CameraInfo.CurrentCamera.SetMinArmLength(MinArmLength);
+		CameraInfo.CurrentCamera.SetMaxArmLength(MaxArmLength);
+		CameraInfo.CurrentCamera.SetFov(BaseFov);
+		CameraInfo.CurrentCamera.SetLocalArmCenterOffset(GetBaseLocalArmOffset());
+		CameraInfo.CurrentCamera.SetWorldArmOffsetAdditional(FVector::ZeroVector);
+		CameraInfo.CurrentCamera.SetArmCenterRotation(FRotator::ZeroRotator);
 
 		// 初始化 LastCamera、CurrentCamera、DesiredCamera
 		CameraInfo.LastCamera.CopyCamera(CameraInfo.CurrentCamera);
@@ -694,7 +815,8 @@ void AJoyPlayerCameraManager::InitializeFor(APlayerController* PC)
 		CameraInfo.CameraModifierController = NewObject<UJoyCameraModifierController>(this);
 		check(CameraInfo.CameraModifierController);
 		CameraInfo.CameraModifierController->InitializeFor(this);
-		CameraInfo.CameraModifierController->ModifiedViewTarget = NewViewTarget.Get();
+		CameraInfo.CameraModifierController->SetModifyTarget(
+			CameraInfo.ViewTarget.Get(), MultiViewTargetCameraManager.FindHandle(CameraInfo.ViewTarget.Get()));
 	}
 
 	CameraInputController = NewObject<UJoyCameraInputController>(this);
@@ -710,28 +832,6 @@ void AJoyPlayerCameraManager::InitializeFor(APlayerController* PC)
 	FGameDelegates::Get().GetViewTargetChangedDelegate().AddUObject(this, &ThisClass::OnViewTargetChanged);
 }
 
-void AJoyPlayerCameraManager::ResetModifiedMarkers()
-{
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
-	{
-		TWeakObjectPtr<AActor> NewViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& CameraInfo = ItViewTarget.Value();
-
-		if (NewViewTarget.Get() == nullptr)
-		{
-			continue;
-		}
-
-		CameraInfo.bCameraOffset_HasModified = false;
-		CameraInfo.bCameraArmLength_HasModified = false;
-		CameraInfo.bArmPitch_HasModified = false;
-		CameraInfo.bArmYaw_HasModified = false;
-		CameraInfo.bArmRoll_HasModified = false;
-	}
-}
-
 FVector AJoyPlayerCameraManager::GetBaseLocalArmOffset() const
 {
 	return FVector(ArmCenterOffsetX, ArmCenterOffsetY, ArmCenterOffsetZ);
@@ -818,24 +918,22 @@ FVector AJoyPlayerCameraManager::GetCharacterFaceBase(const AActor* Target)
 		return FVector::ZeroVector;
 	}
 
-	const AActor* TargetActor = Target;
-	check(TargetActor);
-
-	if (const APawn* TargetPawn = Cast<APawn>(TargetActor))
+	if (const APawn* TargetPawn = Cast<APawn>(Target))
 	{
-		if (const auto* SkeletalComp = TargetPawn->FindComponentByClass<USkeletalMeshComponent>())
+		FVector SocketLocation;
+		if (const FViewTargetCameraInfo* CameraInfo =
+				MultiViewTargetCameraManager.Resolve(MultiViewTargetCameraManager.FindHandle(TargetPawn)))
 		{
-			if (const USkeletalMesh* SkeletalMeshAsset = SkeletalComp->GetSkeletalMeshAsset())
+			if (CameraInfo->FacePointSocketCache.GetSocketLocation(TargetPawn, JoyCameraSocket::FacePoint, SocketLocation))
 			{
-				if (const USkeleton* Skeleton = SkeletalMeshAsset->GetSkeleton())
-				{
-					if (Skeleton->FindSocket(FName("FacePoint")) != nullptr)
-					{
-						return SkeletalComp->GetSocketLocation(FName("FacePoint"));
-					}
-				}
+				return SocketLocation;
 			}
 		}
+		else if (FJoyCameraSocketCache().GetSocketLocation(TargetPawn, JoyCameraSocket::FacePoint, SocketLocation))
+		{
+			// 未纳入镜头管理的对象不做缓存
+			return SocketLocation;
+		}
 	}
 
 	return GetCharacterHeadLocation(Target);
@@ -848,34 +946,80 @@ FVector AJoyPlayerCameraManager::GetCharacterCameraBase(const AActor* Target) co
 		return FVector::ZeroVector;
 	}
 
-	const AActor* TargetActor = Target;
-	check(TargetActor);
-
-	if (const APawn* TargetPawn = Cast<APawn>(TargetActor))
+	if (const APawn* TargetPawn = Cast<APawn>(Target))
 	{
-		if (const auto* SkeletalComp = TargetPawn->FindComponentByClass<USkeletalMeshComponent>())
+		FVector SocketLocation;
+		if (const FViewTargetCameraInfo* CameraInfo =
+				MultiViewTargetCameraManager.Resolve(MultiViewTargetCameraManager.FindHandle(TargetPawn)))
 		{
-			if (const USkeletalMesh* SkeletalMeshAsset = SkeletalComp->GetSkeletalMeshAsset())
+			if (CameraInfo->CameraPointSocketCache.GetSocketLocation(
+					TargetPawn, JoyCameraSocket::CameraPoint, SocketLocation))
 			{
-				if (const USkeleton* Skeleton = SkeletalMeshAsset->GetSkeleton())
-				{
-					if (Skeleton->FindSocket(FName("CameraPoint")) != nullptr)
-					{
-						return SkeletalComp->GetSocketLocation(FName("CameraPoint"));
-					}
-				}
+				return SocketLocation;
 			}
 		}
+		else if (FJoyCameraSocketCache().GetSocketLocation(TargetPawn, JoyCameraSocket::CameraPoint, SocketLocation))
+		{
+			// 未纳入镜头管理的对象不做缓存
+			return SocketLocation;
+		}
 	}
 
 	return GetCharacterHeadLocation(Target);
 }
 
+UJoyCameraComponent* AJoyPlayerCameraManager::FindViewTargetCamera(const AActor* InViewTarget) const
+{
+	if (InViewTarget == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (MultiViewTargetCameraManager.ContainsViewTarget(InViewTarget))
+	{
+		return MultiViewTargetCameraManager.GetCameraComponent(InViewTarget);
+	}
+
+	return UJoyCameraComponent::FindCameraComponent(InViewTarget);
+}
+
+void AJoyPlayerCameraManager::OnCameraComponentRegistered(UJoyCameraComponent* CameraComponent)
+{
+	const AActor* Owner = CameraComponent != nullptr ? CameraComponent->GetOwner() : nullptr;
+	if (Owner != nullptr && MultiViewTargetCameraManager.GetCameraComponent(Owner) == nullptr)
+	{
+		MultiViewTargetCameraManager.BindCameraComponent(Owner, CameraComponent);
+	}
+}
+
+void AJoyPlayerCameraManager::OnCameraComponentUnregistered(UJoyCameraComponent* CameraComponent)
+{
+	const AActor* Owner = CameraComponent != nullptr ? CameraComponent->GetOwner() : nullptr;
+	if (Owner == nullptr || MultiViewTargetCameraManager.GetCameraComponent(Owner) != CameraComponent)
+	{
+		return;
+	}
+
+	// 注销过程中组件仍在 Owner 的组件列表里，需要跳过自身寻找其余相机组件
+	UJoyCameraComponent* OtherCamera = nullptr;
+	TInlineComponentArray<UJoyCameraComponent*> CameraComponents(Owner);
+	for (UJoyCameraComponent* Camera : CameraComponents)
+	{
+		if (Camera != CameraComponent && Camera->IsRegistered())
+		{
+			OtherCamera = Camera;
+			break;
+		}
+	}
+
+	MultiViewTargetCameraManager.BindCameraComponent(Owner, OtherCamera);
+}
+
 FRotator AJoyPlayerCameraManager::GetCurrentCameraArmCenterRotation(AActor* InViewTarget) const
 {
 	if (InViewTarget != nullptr && MultiViewTargetCameraManager.ContainsViewTarget(InViewTarget))
 	{
-		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.ArmCenterRotation;
+		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.GetArmCenterRotation();
 	}
 
 	return FRotator::ZeroRotator;
@@ -885,7 +1029,7 @@ float AJoyPlayerCameraManager::GetCurrentArmLength(AActor* InViewTarget) const
 {
 	if (InViewTarget != nullptr && MultiViewTargetCameraManager.ContainsViewTarget(InViewTarget))
 	{
-		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.ArmLength;
+		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.GetArmLength();
 	}
 
 	return 0.;
@@ -910,7 +1054,7 @@ FVector AJoyPlayerCameraManager::GetCurrentArmCenterOffset(AActor* InViewTarget)
 {
 	if (InViewTarget != nullptr && MultiViewTargetCameraManager.ContainsViewTarget(InViewTarget))
 	{
-		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.ArmCenterOffset;
+		return FVector(MultiViewTargetCameraManager[InViewTarget].ArmCenterOffset);
 	}
 
 	return FVector::ZeroVector;
@@ -920,7 +1064,7 @@ float AJoyPlayerCameraManager::GetCurrentCameraFov(AActor* InViewTarget) const
 {
 	if (InViewTarget != nullptr && MultiViewTargetCameraManager.ContainsViewTarget(InViewTarget))
 	{
-		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.Fov;
+		return MultiViewTargetCameraManager[InViewTarget].CurrentCamera.GetFov();
 	}
 
 	return 0.f;
@@ -938,58 +1082,71 @@ bool AJoyPlayerCameraManager::IsDuringMemberSwitching() const
 
 void AJoyPlayerCameraManager::SetViewTarget(AActor* NewViewTarget, FViewTargetTransitionParams TransitionParams)
 {
-	if (NewViewTarget)
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
 	{
-		TInlineComponentArray<UJoyCameraComponent*> CameraComponents;
-		NewViewTarget->GetComponents(CameraComponents);
-
-		for (auto* Camera : CameraComponents)
-		{
-			if (Camera->IsActive())
-			{
-				Camera->CameraDataThisFrame.Clean();
-			}
-		}
+		Recorder->RecordSetViewTarget(NewViewTarget, TransitionParams);
+	}
+#endif
 
+	if (NewViewTarget)
+	{
 		// 新 ViewTarget 纳入镜头管理
 		if (auto* NewPawn = Cast<APawn>(NewViewTarget); NewPawn != nullptr)
 		{
 			AddNewViewTarget(NewPawn);
 		}
+
+		if (auto* Camera = FindViewTargetCamera(NewViewTarget); Camera != nullptr && Camera->IsActive())
+		{
+			Camera->CameraDataThisFrame.Clean();
+		}
 	}
 
 	Super::SetViewTarget(NewViewTarget, TransitionParams);
+
+	// 新的 ViewTarget、PendingViewTarget 加入活跃集合
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(ViewTarget.Target));
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(PendingViewTarget.Target));
 }
 
 void AJoyPlayerCameraManager::SetViewTargetWithCurveBlend(AActor* NewViewTarget, TObjectPtr<UCurveFloat> BlendCurve,
 	bool bEnableUpdateCameraConfig, FViewTargetTransitionParams TransitionParams)
 {
-	if (NewViewTarget)
+#if JOY_CAMERA_WITH_REPLAY
+	if (auto* Recorder = FJoyCameraReplayRecorder::Get())
 	{
-		TInlineComponentArray<UJoyCameraComponent*> TargetCameras;
-		NewViewTarget->GetComponents(TargetCameras);
-		for (auto* Camera : TargetCameras)
-		{
-			if (Camera->IsActive())
-			{
-				Camera->CameraDataThisFrame.Clean();
-			}
-		}
+		Recorder->RecordSetViewTarget(NewViewTarget, TransitionParams, BlendCurve, bEnableUpdateCameraConfig);
+	}
+#endif
 
+	if (NewViewTarget)
+	{
 		// 新 ViewTarget 纳入镜头管理
 		if (auto* NewPawn = Cast<APawn>(NewViewTarget); NewPawn != nullptr)
 		{
 			AddNewViewTarget(NewPawn);
 		}
 
+		if (auto* Camera = FindViewTargetCamera(NewViewTarget); Camera != nullptr && Camera->IsActive())
+		{
+			Camera->CameraDataThisFrame.Clean();
+		}
+
 		BlendViewCurve = nullptr;
+		BlendViewBakedCurve.Reset();
 		if (BlendCurve)
 		{
 			BlendViewCurve = BlendCurve;
+			BlendViewBakedCurve = FJoyCameraCurveCache::GetBakedCurve(BlendCurve);
 		}
 	}
 
 	Super::SetViewTarget(NewViewTarget, TransitionParams);
+
+	// 新的 ViewTarget、PendingViewTarget 加入活跃集合
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(ViewTarget.Target));
+	ActivateViewTarget(MultiViewTargetCameraManager.FindHandle(PendingViewTarget.Target));
 }
 
 bool AJoyPlayerCameraManager::IsCurrentViewTarget(const AActor* TestViewTarget) const
@@ -1159,7 +1316,7 @@ void AJoyPlayerCameraManager::ProcessViewRotation(float DeltaTime, FRotator& Out
 	 * @param OutDelta: 增量
 	 */
 
-	SCOPE_CYCLE_COUNTER(STAT_Camera_ProcessViewRotation);
+	JOY_CAMERA_SCOPE_CYCLE_COUNTER(STAT_JoyCamera_ProcessViewRotation);
 	const FRotator OldViewRotation = OutViewRotation;
 
 	for (int32 ModifierIdx = 0; ModifierIdx < ModifierList.Num(); ModifierIdx++)
@@ -1245,39 +1402,222 @@ UJoyCameraModifierController* AJoyPlayerCameraManager::GetCameraModifier(AActor*
 
 TObjectPtr<class UJoyCameraModifierController> FMultiViewTargetCameraManager::GetCameraModifier(AActor* InViewTarget)
 {
-	if (InViewTarget != nullptr && ViewTargetCameraInfos.Contains(InViewTarget))
+	if (const FViewTargetCameraInfo* CameraInfo = Resolve(FindHandle(InViewTarget)))
+	{
+		return CameraInfo->CameraModifierController;
+	}
+
+	return nullptr;
+}
+
+UJoyCameraComponent* FMultiViewTargetCameraManager::GetCameraComponent(const AActor* InViewTarget) const
+{
+	if (const FViewTargetCameraInfo* CameraInfo = Resolve(FindHandle(InViewTarget)))
 	{
-		return ViewTargetCameraInfos[InViewTarget].CameraModifierController;
+		return CameraInfo->CameraComponent.Get();
 	}
 
 	return nullptr;
 }
 
+void FMultiViewTargetCameraManager::BindCameraComponent(const AActor* InViewTarget, UJoyCameraComponent* CameraComponent)
+{
+	if (FViewTargetCameraInfo* CameraInfo = Resolve(FindHandle(InViewTarget)))
+	{
+		CameraInfo->CameraComponent = CameraComponent;
+	}
+}
+
 bool FMultiViewTargetCameraManager::ContainsViewTarget(const AActor* InViewTarget) const
 {
-	return InViewTarget != nullptr && ViewTargetCameraInfos.Contains(InViewTarget);
+	return InViewTarget != nullptr && ViewTargetLookup.Contains(FObjectKey(InViewTarget));
+}
+
+FViewTargetCameraHandle FMultiViewTargetCameraManager::FindHandle(const AActor* InViewTarget) const
+{
+	if (InViewTarget != nullptr)
+	{
+		if (const FViewTargetCameraHandle* Handle = ViewTargetLookup.Find(FObjectKey(InViewTarget)))
+		{
+			return *Handle;
+		}
+	}
+
+	return FViewTargetCameraHandle();
 }
 
-void FMultiViewTargetCameraManager::AddViewTarget(
+FViewTargetCameraInfo* FMultiViewTargetCameraManager::Resolve(const FViewTargetCameraHandle& Handle)
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return nullptr;
+	}
+
+	const FViewTargetCameraSlot& Slot = Slots[Handle.SlotIndex];
+	if (Slot.Generation != Handle.Generation || Slot.DenseIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &ViewTargetCameraInfos[Slot.DenseIndex];
+}
+
+const FViewTargetCameraInfo* FMultiViewTargetCameraManager::Resolve(const FViewTargetCameraHandle& Handle) const
+{
+	return const_cast<FMultiViewTargetCameraManager*>(this)->Resolve(Handle);
+}
+
+FViewTargetCameraHandle FMultiViewTargetCameraManager::AddViewTarget(
 	class AJoyPlayerCameraManager* CameraManager, AActor* InViewTarget, const FVirtualCamera& VirtualCamera)
 {
 	if (InViewTarget == nullptr || ContainsViewTarget(InViewTarget) || CameraManager == nullptr)
 	{
-		return;
+		return FindHandle(InViewTarget);
 	}
 
-	ViewTargetCameraInfos.Add(InViewTarget, FViewTargetCameraInfo());
-	FViewTargetCameraInfo& CameraInfo = ViewTargetCameraInfos[InViewTarget];
+	// 优先复用空闲槽位
+	const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop() : Slots.AddDefaulted();
+	FViewTargetCameraSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = ViewTargetCameraInfos.AddDefaulted();
+
+	FViewTargetCameraHandle Handle;
+	Handle.SlotIndex = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	ViewTargetLookup.Add(FObjectKey(InViewTarget), Handle);
+
+	FViewTargetCameraInfo& CameraInfo = ViewTargetCameraInfos[Slot.DenseIndex];
+	CameraInfo.ViewTarget = InViewTarget;
+	CameraInfo.ViewTargetKey = FObjectKey(InViewTarget);
+	CameraInfo.SlotIndex = SlotIndex;
 
 	// 初始化 CameraInfo.CurrentCamera
 	CameraInfo.CurrentCamera.CopyCamera(VirtualCamera);
 	// 初始化 LastCamera、CurrentCamera、DesiredCamera
 	CameraInfo.LastCamera.CopyCamera(VirtualCamera);
 	CameraInfo.DesiredCamera.CopyCamera(VirtualCamera);
-	CameraInfo.CameraModifierController = NewObject<UJoyCameraModifierController>(CameraManager);
+	CameraInfo.CameraModifierController = FreeModifierControllers.Num() > 0
+		? FreeModifierControllers.Pop()
+		: NewObject<UJoyCameraModifierController>(CameraManager);
 	check(CameraInfo.CameraModifierController);
 	CameraInfo.CameraModifierController->InitializeFor(CameraManager);
-	CameraInfo.CameraModifierController->SetModifyTarget(InViewTarget);
+	CameraInfo.CameraModifierController->SetModifyTarget(InViewTarget, Handle);
+	CameraInfo.CameraComponent = UJoyCameraComponent::FindCameraComponent(InViewTarget);
+
+	return Handle;
+}
+
+bool FMultiViewTargetCameraManager::IsActive(const FViewTargetCameraHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		return false;
+	}
+
+	const FViewTargetCameraSlot& Slot = Slots[Handle.SlotIndex];
+	return Slot.Generation == Handle.Generation && Slot.DenseIndex != INDEX_NONE &&
+	       Slot.DenseIndex < NumActiveViewTargets;
+}
+
+void FMultiViewTargetCameraManager::Activate(const FViewTargetCameraHandle& Handle)
+{
+	if (Resolve(Handle) == nullptr || IsActive(Handle))
+	{
+		return;
+	}
+
+	// 换到活跃集合末尾的下一个位置，再扩大活跃集合
+	SwapElements(Slots[Handle.SlotIndex].DenseIndex, NumActiveViewTargets);
+	++NumActiveViewTargets;
+}
+
+void FMultiViewTargetCameraManager::DeactivateAt(int32 DenseIndex)
+{
+	if (DenseIndex < 0 || DenseIndex >= NumActiveViewTargets)
+	{
+		return;
+	}
+
+	--NumActiveViewTargets;
+	SwapElements(DenseIndex, NumActiveViewTargets);
+}
+
+void FMultiViewTargetCameraManager::SwapElements(int32 DenseIndexA, int32 DenseIndexB)
+{
+	if (DenseIndexA == DenseIndexB)
+	{
+		return;
+	}
+
+	ViewTargetCameraInfos.Swap(DenseIndexA, DenseIndexB);
+	Slots[ViewTargetCameraInfos[DenseIndexA].SlotIndex].DenseIndex = DenseIndexA;
+	Slots[ViewTargetCameraInfos[DenseIndexB].SlotIndex].DenseIndex = DenseIndexB;
+}
+
+void FMultiViewTargetCameraManager::RemoveAt(int32 DenseIndex)
+{
+	if (!ViewTargetCameraInfos.IsValidIndex(DenseIndex))
+	{
+		return;
+	}
+
+	// 先移出活跃集合，保证删除时活跃集合保持连续
+	if (DenseIndex < NumActiveViewTargets)
+	{
+		DeactivateAt(DenseIndex);
+		DenseIndex = NumActiveViewTargets;
+	}
+
+	const FViewTargetCameraInfo& RemovedInfo = ViewTargetCameraInfos[DenseIndex];
+	ViewTargetLookup.Remove(RemovedInfo.ViewTargetKey);
+
+	// Modifier 清空状态后回收，所有者代数递增，仍持有它的一方使用旧句柄时不会影响下一个 ViewTarget
+	if (UJoyCameraModifierController* ModifierController = RemovedInfo.CameraModifierController)
+	{
+		ModifierController->ResetForReuse();
+		if (FreeModifierControllers.Num() < MaxFreeModifierControllers)
+		{
+			FreeModifierControllers.Add(ModifierController);
+		}
+	}
+
+	// 回收槽位，递增 Generation 使旧句柄失效
+	FViewTargetCameraSlot& RemovedSlot = Slots[RemovedInfo.SlotIndex];
+	RemovedSlot.DenseIndex = INDEX_NONE;
+	++RemovedSlot.Generation;
+	FreeSlots.Add(RemovedInfo.SlotIndex);
+
+	ViewTargetCameraInfos.RemoveAtSwap(DenseIndex);
+	if (ViewTargetCameraInfos.IsValidIndex(DenseIndex))
+	{
+		Slots[ViewTargetCameraInfos[DenseIndex].SlotIndex].DenseIndex = DenseIndex;
+	}
+}
+
+void FMultiViewTargetCameraManager::RemoveStaleInactive(int32 Budget)
+{
+	const int32 NumInactive = ViewTargetCameraInfos.Num() - NumActiveViewTargets;
+	for (int32 Checked = 0; Checked < FMath::Min(Budget, NumInactive); ++Checked)
+	{
+		if (NumActiveViewTargets >= ViewTargetCameraInfos.Num())
+		{
+			break;
+		}
+
+		if (StaleCleanupCursor < NumActiveViewTargets || StaleCleanupCursor >= ViewTargetCameraInfos.Num())
+		{
+			StaleCleanupCursor = NumActiveViewTargets;
+		}
+
+		if (ViewTargetCameraInfos[StaleCleanupCursor].ViewTarget.Get() == nullptr)
+		{
+			// 删除后当前位置换入了末尾元素，游标保持不动
+			RemoveAt(StaleCleanupCursor);
+		}
+		else
+		{
+			++StaleCleanupCursor;
+		}
+	}
 }
 
 void AJoyPlayerCameraManager::SetArmPitchInputEnabled(bool bEnabled)
@@ -1323,7 +1663,7 @@ bool AJoyPlayerCameraManager::BlockMouseScrollInput_Implementation(UObject* Inpu
 	return InputOverrideDescription.BlockArmLengthCounter > 0;
 }
 
-void AJoyPlayerCameraManager::SetConfigs(const TMap<EJoyCameraBasic, float>& Config)
+void AJoyPlayerCameraManager::SetConfigs(const FJoyCameraBasicConfig& Config)
 {
 	// 基础镜头设置
 	UPDATE_BASIC_CONFIGS(BaseArmLength);
@@ -1355,29 +1695,23 @@ void AJoyPlayerCameraManager::ApplyConfig()
 		FadingTarget_ArmPitch = CameraConfigController->FadeTargetArmPitch;
 	}
 
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
+	// 失效的 ViewTarget 统一在 PrepareViewTargets 中清理，这里只跳过
+	for (int32 Index = 0; Index < MultiViewTargetCameraManager.Num(); ++Index)
 	{
-		TWeakObjectPtr<AActor> CachedViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& CachedCameraInfo = ItViewTarget.Value();
-
-		if (CachedViewTarget.Get() == nullptr)
+		FViewTargetCameraInfo& CachedCameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+		if (CachedCameraInfo.ViewTarget.Get() == nullptr)
 		{
-			ItViewTarget.RemoveCurrent();
 			continue;
 		}
 
 		// 将当前基础相机参数更新到缓存的 ViewTarget 上
-		CachedCameraInfo.DesiredCamera.ArmLength = BaseArmLength + OverlayArmLength;
-		CachedCameraInfo.DesiredCamera.MinArmLength = MinArmLength;
-		CachedCameraInfo.DesiredCamera.MaxArmLength = MaxArmLength;
-		CachedCameraInfo.DesiredCamera.SetArmCenterOffset(
+		CachedCameraInfo.DesiredCamera.SetArmLength(BaseArmLength + OverlayArmLength);
+		CachedCameraInfo.DesiredCamera.SetMinArmLength(MinArmLength);
+		CachedCameraInfo.DesiredCamera.SetMaxArmLength(MaxArmLength);
+		CachedCameraInfo.DesiredCamera.SetLocalArmCenterOffset(
 			FVector(ArmCenterOffsetX, ArmCenterOffsetY, ArmCenterOffsetZ));
-		CachedCameraInfo.DesiredCamera.LocalArmCenterOffset =
-			FVector(ArmCenterOffsetX, ArmCenterOffsetY, ArmCenterOffsetZ);
-		CachedCameraInfo.DesiredCamera.WorldArmOffsetAdditional = FVector::ZeroVector;
-		CachedCameraInfo.DesiredCamera.Fov = BaseFov;
+		CachedCameraInfo.DesiredCamera.SetWorldArmOffsetAdditional(FVector::ZeroVector);
+		CachedCameraInfo.DesiredCamera.SetFov(BaseFov);
 	}
 }
 
@@ -1385,29 +1719,26 @@ void AJoyPlayerCameraManager::StartFade(float InFadeDuration, bool bFadeArmLengt
 	bool bInFadeArmRotationPitch, bool bInFadeArmRotationYaw, bool bInFadeLocalArmCenterOffset, bool bInFadeFov,
 	bool bIgnoreTimeDilationDuringFading, bool bOverrideCameraInput)
 {
-	for (TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo>::TIterator ItViewTarget =
-		     MultiViewTargetCameraManager.ViewTargetCameraInfos.CreateIterator();
-	     ItViewTarget; ++ItViewTarget)
-	{
-		TWeakObjectPtr<AActor> FadeViewTarget = ItViewTarget.Key();
-		FViewTargetCameraInfo& FadeCameraInfo = ItViewTarget.Value();
+	EJoyCameraChannel FadeChannels = EJoyCameraChannel::None;
+	FadeChannels |= bFadeArmLengthRange ? EJoyCameraChannel::ArmLengthRange : EJoyCameraChannel::None;
+	FadeChannels |= bInFadeArmLength ? EJoyCameraChannel::ArmLength : EJoyCameraChannel::None;
+	FadeChannels |= bInFadeArmRotationPitch ? EJoyCameraChannel::Pitch : EJoyCameraChannel::None;
+	FadeChannels |= bInFadeArmRotationYaw ? EJoyCameraChannel::Yaw : EJoyCameraChannel::None;
+	FadeChannels |= bInFadeLocalArmCenterOffset ? EJoyCameraChannel::Offset : EJoyCameraChannel::None;
+	FadeChannels |= bInFadeFov ? EJoyCameraChannel::Fov : EJoyCameraChannel::None;
 
-		if (FadeViewTarget.Get() == nullptr)
+	for (int32 Index = 0; Index < MultiViewTargetCameraManager.Num(); ++Index)
+	{
+		FViewTargetCameraInfo& FadeCameraInfo = MultiViewTargetCameraManager.GetByIndex(Index);
+		if (FadeCameraInfo.ViewTarget.Get() == nullptr)
 		{
-			ItViewTarget.RemoveCurrent();
 			continue;
 		}
 
 		// @TODO 如果在 Fade 期间同时进行了 CameraModifier，表现会异常，因为这两套机制同时写入了 LastCamera 变量
 		FadeCameraInfo.LastCamera.CopyCamera(FadeCameraInfo.CurrentCamera);
-		FadeCameraInfo.bFadeArmLengthRange = bFadeArmLengthRange;
-		FadeCameraInfo.bFadeArmLength = bInFadeArmLength;
-		FadeCameraInfo.bFadeArmPitch = bInFadeArmRotationPitch;
-		FadeCameraInfo.bFadeArmYaw = bInFadeArmRotationYaw;
-		FadeCameraInfo.bFadeLocalArmCenterOffset = bInFadeLocalArmCenterOffset;
-
+		FadeCameraInfo.FadeChannels = FadeChannels;
 		FadeCameraInfo.bNeedFading = true;
-		FadeCameraInfo.bFadeCameraFov = bInFadeFov;
 	}
 
 	if (CameraConfigFadingDescription.bDuringFading)
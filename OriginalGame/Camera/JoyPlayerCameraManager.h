@@ -3,12 +3,15 @@
 #include "Camera/PlayerCameraManager.h"
 #include "Camera/Controller/JoyCameraMeta.h"
 #include "Camera/Controller/JoyCameraModifierController.h"
+#include "Camera/JoyViewTargetCameraHandle.h"
 #include "Input/JoyInputBlocker.h"
+#include "UObject/ObjectKey.h"
 
 #include "JoyPlayerCameraManager.generated.h"
 
 struct FGameplayTag;
 struct FCameraModifyHandle;
+struct FJoyBakedCurve;
 class AJoyCharacter;
 class FDebugDisplayInfo;
 class UCanvas;
@@ -17,6 +20,9 @@ class UJoyCameraComponent;
 class UJoyCameraConfigController;
 class UJoyCameraInputController;
 class UJoyCameraModifierController;
+class UJoyGravityManageSubsystem;
+class USkeletalMesh;
+class USkeletalMeshComponent;
 
 #define JOY_CAMERA_DEFAULT_FOV (80.0f)
 #define JOY_CAMERA_DEFAULT_PITCH_MIN (-88.0f)
@@ -37,42 +43,191 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FOnViewTargetBlendComplete, AActor* ViewTar
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
 	FOnCameraModifyFinishedDelegate, AActor*, CameraActor, FCameraModifyHandle, ModifierHandle);
 
+/**
+ * 虚拟相机参数
+ *
+ * 全部使用单精度，按 4 个 float 一组共 4 组存放在 Lanes 中（64 字节），淡入时每组参数可直接整组载入向量寄存器混合。
+ * 各组依次为：[ArmLength, MinArmLength, MaxArmLength, Fov]、[LocalArmCenterOffset, -]、
+ * [WorldArmOffsetAdditional, -]、[ArmCenterRotation, -]，通过具名的 Get/Set 访问，调整分组时需同步修改淡入内核。
+ */
 USTRUCT()
 struct FVirtualCamera
 {
 	GENERATED_BODY()
 
-	UPROPERTY()
-	FVector ArmCenterOffset = FVector::ZeroVector;
+	static constexpr int32 NumLanes = 4;
 
-	UPROPERTY()
-	float ArmLength = 0.;
+	// 各组参数在 Lanes 中的下标
+	static constexpr int32 ArmLane = 0;
+	static constexpr int32 LocalOffsetLane = 1;
+	static constexpr int32 WorldOffsetLane = 2;
+	static constexpr int32 RotationLane = 3;
 
-	UPROPERTY()
-	float MinArmLength = 0;
+	FVirtualCamera& operator=(const FVirtualCamera& Other);
 
-	UPROPERTY()
-	float MaxArmLength = 0;
+	void CopyCamera(const FVirtualCamera& Other);
 
-	FVirtualCamera& operator=(const FVirtualCamera& Other);
+	float GetArmLength() const
+	{
+		return Lanes[ArmLane][0];
+	}
 
-	UPROPERTY(DisplayName = "设置相机额外偏移(局部空间)")
-	FVector LocalArmCenterOffset = FVector::ZeroVector;
+	void SetArmLength(float NewArmLength)
+	{
+		Lanes[ArmLane][0] = NewArmLength;
+	}
 
-	UPROPERTY(DisplayName = "设置相机额外偏移(世界空间)")
-	FVector WorldArmOffsetAdditional = FVector::ZeroVector;
+	float GetMinArmLength() const
+	{
+		return Lanes[ArmLane][1];
+	}
 
-	UPROPERTY()
-	float Fov = 0;
+	void SetMinArmLength(float NewMinArmLength)
+	{
+		Lanes[ArmLane][1] = NewMinArmLength;
+	}
 
-	UPROPERTY()
-	FRotator ArmCenterRotation = FRotator::ZeroRotator;
+	float GetMaxArmLength() const
+	{
+		return Lanes[ArmLane][2];
+	}
 
-	void CopyCamera(const FVirtualCamera& Other);
+	void SetMaxArmLength(float NewMaxArmLength)
+	{
+		Lanes[ArmLane][2] = NewMaxArmLength;
+	}
+
+	float GetFov() const
+	{
+		return Lanes[ArmLane][3];
+	}
+
+	void SetFov(float NewFov)
+	{
+		Lanes[ArmLane][3] = NewFov;
+	}
+
+	// 相机额外偏移（局部空间）
+	FVector GetLocalArmCenterOffset() const
+	{
+		return GetLaneVector(LocalOffsetLane);
+	}
+
+	void SetLocalArmCenterOffset(const FVector& NewLocalArmCenterOffset)
+	{
+		SetLaneVector(LocalOffsetLane, NewLocalArmCenterOffset);
+	}
+
+	// 相机额外偏移（世界空间）
+	FVector GetWorldArmOffsetAdditional() const
+	{
+		return GetLaneVector(WorldOffsetLane);
+	}
+
+	void SetWorldArmOffsetAdditional(const FVector& NewWorldArmOffsetAdditional)
+	{
+		SetLaneVector(WorldOffsetLane, NewWorldArmOffsetAdditional);
+	}
+
+	FRotator GetArmCenterRotation() const
+	{
+		return FRotator(GetArmPitch(), GetArmYaw(), GetArmRoll());
+	}
+
+	void SetArmCenterRotation(const FRotator& NewArmCenterRotation)
+	{
+		SetArmPitch(static_cast<float>(NewArmCenterRotation.Pitch));
+		SetArmYaw(static_cast<float>(NewArmCenterRotation.Yaw));
+		SetArmRoll(static_cast<float>(NewArmCenterRotation.Roll));
+	}
+
+	float GetArmPitch() const
+	{
+		return Lanes[RotationLane][0];
+	}
+
+	void SetArmPitch(float NewPitch)
+	{
+		Lanes[RotationLane][0] = NewPitch;
+	}
+
+	float GetArmYaw() const
+	{
+		return Lanes[RotationLane][1];
+	}
+
+	void SetArmYaw(float NewYaw)
+	{
+		Lanes[RotationLane][1] = NewYaw;
+	}
+
+	float GetArmRoll() const
+	{
+		return Lanes[RotationLane][2];
+	}
+
+	void SetArmRoll(float NewRoll)
+	{
+		Lanes[RotationLane][2] = NewRoll;
+	}
+
+	/** 第 Lane 组参数的首地址，每组 4 个 float */
+	const float* GetLaneData(int32 Lane) const
+	{
+		return Lanes[Lane];
+	}
+
+	float* GetLaneData(int32 Lane)
+	{
+		return Lanes[Lane];
+	}
+
+private:
+	FVector GetLaneVector(int32 Lane) const
+	{
+		return FVector(Lanes[Lane][0], Lanes[Lane][1], Lanes[Lane][2]);
+	}
+
+	void SetLaneVector(int32 Lane, const FVector& NewVector)
+	{
+		Lanes[Lane][0] = static_cast<float>(NewVector.X);
+		Lanes[Lane][1] = static_cast<float>(NewVector.Y);
+		Lanes[Lane][2] = static_cast<float>(NewVector.Z);
+	}
+
+	// 每组最后一个 float 为填充，始终为 0
+	alignas(16) float Lanes[NumLanes][4] = {};
+};
+
+static_assert(sizeof(FVirtualCamera) == FVirtualCamera::NumLanes * 4 * sizeof(float),
+	"FVirtualCamera must stay tightly packed into float lanes");
 
-	void SetArmCenterOffset(const FVector& NewArmCenterOffset);
+/**
+ * ViewTarget 骨骼挂点的解析缓存
+ *
+ * 缓存挂点所在的骨骼网格体组件、骨骼下标与挂点相对骨骼的变换，每次取位置只需读取骨骼变换；
+ * 组件失效或网格体资源被替换时重新解析。
+ */
+struct FJoyCameraSocketCache
+{
+	/** 取挂点世界坐标，目标没有该挂点时返回 false */
+	bool GetSocketLocation(const APawn* TargetPawn, FName SocketName, FVector& OutLocation);
+
+	void Reset();
+
+private:
+	void Resolve(const APawn* TargetPawn, FName SocketName);
+
+	TWeakObjectPtr<const USkeletalMeshComponent> MeshComponent;
+
+	// 解析时的网格体资源，与组件当前资源不一致说明网格体被替换
+	TWeakObjectPtr<const USkeletalMesh> MeshAsset;
+
+	FTransform SocketLocalTransform = FTransform::Identity;
+
+	int32 BoneIndex = INDEX_NONE;
 
-	void SetArmCenterRotation(const FRotator& NewArmCenterRotation);
+	bool bResolved = false;
 };
 
 USTRUCT()
@@ -80,6 +235,16 @@ struct FViewTargetCameraInfo
 {
 	GENERATED_BODY()
 
+	/** 该相机数据所属的 ViewTarget */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> ViewTarget;
+
+	// ViewTarget 在查找表中的键，ViewTarget 失效后仍可用它移除查找表条目
+	FObjectKey ViewTargetKey;
+
+	// 反向索引到 FMultiViewTargetCameraManager 的槽位表
+	int32 SlotIndex = INDEX_NONE;
+
 	/** 对相机执行 Modifier 之前保存的相机参数 */
 	UPROPERTY()
 	FVirtualCamera LastCamera;
@@ -92,55 +257,37 @@ struct FViewTargetCameraInfo
 	UPROPERTY()
 	FVirtualCamera CurrentCamera;
 
-	/** 若 Modify 修正结束后需恢复，则恢复到 RestoreCamera 镜头，一般
-	 * RestoreCamera 与 LastCamera 一致， 但若一段 Modify 未执行完就被新的 Modify
-	 * 打断时，就需要存储上一段 Modify 的恢复位置 */
+	/** 若 Modify 修正结束后需恢复，则恢复到该弹簧臂旋转，一般与 LastCamera 一致，
+	 * 但若一段 Modify 未执行完就被新的 Modify 打断时，就需要存储上一段 Modify 的恢复位置 */
 	UPROPERTY()
-	FVirtualCamera RestoreCamera;
-
-	bool bNeedFading = false;
-
-	// 是否要对弹簧臂长度变动做淡入
-	bool bFadeArmLength = true;
-
-	// 是否对弹簧臂长度范围做淡入
-	bool bFadeArmLengthRange = true;
+	FRotator3f RestoreArmCenterRotation = FRotator3f::ZeroRotator;
 
-	// 是否要对弹簧臂旋转变动做淡入
-	bool bFadeArmPitch = true;
-
-	bool bFadeArmYaw = true;
+	/** 世界坐标系下相机臂偏移，由 CurrentCamera 的局部偏移与世界偏移在每帧收尾时计算得到 */
+	UPROPERTY()
+	FVector3f ArmCenterOffset = FVector3f::ZeroVector;
 
-	// 是否对相机的 local arm center Offset 做 fade 变换
-	bool bFadeLocalArmCenterOffset = true;
+	bool bNeedFading = false;
 
-	bool bFadeCameraFov = true;
+	// 需要做淡入的参数通道，被 Modify 修改过的通道会在本次淡入中被移除
+	EJoyCameraChannel FadeChannels = EJoyCameraChannel::All;
 
 	// 做 Fading 时，Arm 变化速度
 	float ModifyArmLagSpeed = 1.0;
 
-	/** ************ Current Camera Attributes Begin ************* */
-	// 弹簧臂臂长是否被修改
-	bool bCameraArmLength_HasModified = false;
-
-	// 相机基础位置是否被修改
-	bool bCameraOffset_HasModified = false;
-
-	// 弹簧臂 Yaw 是否被修改
-	bool bArmYaw_HasModified = false;
+	// 本帧被修改过的参数通道，每帧更新前整体清零
+	EJoyCameraChannel ModifiedChannels = EJoyCameraChannel::None;
 
-	// 弹簧臂 Pitch 是否被修改
-	bool bArmPitch_HasModified = false;
+	UPROPERTY()
+	TObjectPtr<class UJoyCameraModifierController> CameraModifierController;
 
-	// 弹簧臂 Roll 是否被修改
-	bool bArmRoll_HasModified = false;
+	/** ViewTarget 上的相机组件，登记时绑定，组件注册/注销时更新 */
+	UPROPERTY()
+	TWeakObjectPtr<UJoyCameraComponent> CameraComponent;
 
-	// 相机 Fov 是否被修改
-	bool bCameraFov_HasModified = false;
-	/** ************ Current Camera Attributes End ************* */
+	// 相机挂点与脸部挂点的解析缓存，在 const 查询中惰性填充
+	mutable FJoyCameraSocketCache CameraPointSocketCache;
 
-	UPROPERTY()
-	TObjectPtr<class UJoyCameraModifierController> CameraModifierController;
+	mutable FJoyCameraSocketCache FacePointSocketCache;
 };
 
 USTRUCT()
@@ -156,8 +303,35 @@ struct FCameraConfigDescription
 
 	UPROPERTY()
 	FName FadeOutCamera{};
+
+	// CameraStack 来自的相机组件以及当时的栈版本，两者都不变时无需比较
+	UPROPERTY()
+	TWeakObjectPtr<const UJoyCameraComponent> SourceCameraComponent{};
+
+	UPROPERTY()
+	uint32 CameraStackVersion{0};
 };
 
+USTRUCT()
+struct FViewTargetCameraSlot
+{
+	GENERATED_BODY()
+
+	// 槽位当前指向的紧凑数组下标，空闲槽位为 INDEX_NONE
+	int32 DenseIndex = INDEX_NONE;
+
+	uint32 Generation = 0;
+};
+
+/**
+ * 多 ViewTarget 相机数据容器
+ *
+ * 相机数据紧凑存放在 ViewTargetCameraInfos 中，每帧的更新直接按下标遍历连续内存；
+ * 外部通过 FViewTargetCameraHandle 间接访问，删除时将末尾元素换入空位并修正其槽位。
+ *
+ * 数组前 NumActive 项为活跃集合（ViewTarget、PendingViewTarget 以及正在被 Modifier 修改的对象），
+ * 每帧更新只遍历活跃集合，其余仅做登记，开销与登记数量无关。
+ */
 USTRUCT()
 struct FMultiViewTargetCameraManager
 {
@@ -167,21 +341,92 @@ struct FMultiViewTargetCameraManager
 
 	bool ContainsViewTarget(const AActor* InViewTarget) const;
 
+	/** 返回登记时绑定的相机组件，未登记的对象返回 nullptr */
+	UJoyCameraComponent* GetCameraComponent(const AActor* InViewTarget) const;
+
+	/** 重新绑定 ViewTarget 上的相机组件，未登记的对象不做处理 */
+	void BindCameraComponent(const AActor* InViewTarget, UJoyCameraComponent* CameraComponent);
+
+	FViewTargetCameraHandle FindHandle(const AActor* InViewTarget) const;
+
+	FViewTargetCameraInfo* Resolve(const FViewTargetCameraHandle& Handle);
+
+	const FViewTargetCameraInfo* Resolve(const FViewTargetCameraHandle& Handle) const;
+
 	FViewTargetCameraInfo& operator[](const AActor* InViewTarget)
 	{
-		return ViewTargetCameraInfos[InViewTarget];
+		FViewTargetCameraInfo* CameraInfo = Resolve(FindHandle(InViewTarget));
+		check(CameraInfo);
+		return *CameraInfo;
 	}
 
 	const FViewTargetCameraInfo& operator[](const AActor* InViewTarget) const
 	{
-		return ViewTargetCameraInfos[InViewTarget];
+		const FViewTargetCameraInfo* CameraInfo = Resolve(FindHandle(InViewTarget));
+		check(CameraInfo);
+		return *CameraInfo;
 	}
 
-	void AddViewTarget(
+	int32 Num() const
+	{
+		return ViewTargetCameraInfos.Num();
+	}
+
+	FViewTargetCameraInfo& GetByIndex(int32 DenseIndex)
+	{
+		return ViewTargetCameraInfos[DenseIndex];
+	}
+
+	const FViewTargetCameraInfo& GetByIndex(int32 DenseIndex) const
+	{
+		return ViewTargetCameraInfos[DenseIndex];
+	}
+
+	int32 NumActive() const
+	{
+		return NumActiveViewTargets;
+	}
+
+	bool IsActive(const FViewTargetCameraHandle& Handle) const;
+
+	/** 将 ViewTarget 加入活跃集合，已在集合中时不做处理 */
+	void Activate(const FViewTargetCameraHandle& Handle);
+
+	/** 将活跃集合中的一项移出，活跃集合末尾元素会被换到 DenseIndex 处 */
+	void DeactivateAt(int32 DenseIndex);
+
+	FViewTargetCameraHandle AddViewTarget(
 		class AJoyPlayerCameraManager* CameraManager, AActor* InViewTarget, const FVirtualCamera& VirtualCamera);
 
+	/** 移除紧凑数组中的一项，末尾元素会被换到 DenseIndex 处 */
+	void RemoveAt(int32 DenseIndex);
+
+	/** 分摊清理非活跃集合中已失效的 ViewTarget，每次最多检查 Budget 项 */
+	void RemoveStaleInactive(int32 Budget);
+
+private:
+	void SwapElements(int32 DenseIndexA, int32 DenseIndexB);
+
+	UPROPERTY()
+	TArray<FViewTargetCameraInfo> ViewTargetCameraInfos{};
+
+	int32 NumActiveViewTargets = 0;
+
+	// 非活跃集合分摊清理的游标
+	int32 StaleCleanupCursor = 0;
+
+	TArray<FViewTargetCameraSlot> Slots{};
+
+	TArray<int32> FreeSlots{};
+
+	TMap<FObjectKey, FViewTargetCameraHandle> ViewTargetLookup{};
+
+	// 空闲 Modifier 的数量上限，超出的部分交给 GC 回收，避免短时间内大量 ViewTarget 移除后一直占用内存
+	static constexpr int32 MaxFreeModifierControllers = 8;
+
+	// 已移除 ViewTarget 回收的 Modifier，新增 ViewTarget 时优先复用，避免短生命周期对象反复创建 UObject
 	UPROPERTY()
-	TMap<TWeakObjectPtr<AActor>, FViewTargetCameraInfo> ViewTargetCameraInfos{};
+	TArray<TObjectPtr<UJoyCameraModifierController>> FreeModifierControllers{};
 };
 
 USTRUCT()
@@ -230,6 +475,8 @@ class ORIGINALGAME_API AJoyPlayerCameraManager : public APlayerCameraManager, pu
 	friend class UJoyCameraModifierController;
 	friend class UJoyCameraConfigController;
 	friend class UJoyCameraInputController;
+	friend class FJoyCameraReplayRecorder;
+	friend class FJoyCameraReplayer;
 
 public:
 	virtual bool BlockMoveInput_Implementation(
@@ -351,6 +598,13 @@ public:
 
 	FVector GetCharacterHeadLocation(const AActor* Character) const;
 
+	/** 获取 ViewTarget 上的相机组件，已纳入镜头管理的对象直接读取绑定结果，不遍历组件 */
+	UJoyCameraComponent* FindViewTargetCamera(const AActor* InViewTarget) const;
+
+	void OnCameraComponentRegistered(UJoyCameraComponent* CameraComponent);
+
+	void OnCameraComponentUnregistered(UJoyCameraComponent* CameraComponent);
+
 	FVector GetNegativeGravityNormal() const;
 
 	/**
@@ -390,15 +644,14 @@ protected:
 
 	virtual void InternalUpdateCamera(float DeltaTime);
 
-	virtual void ClearUnusedViewTargets();
-
-	virtual void UpdateViewTargetPose();
+	/** 帧首遍历：清理失效 ViewTarget、重置 DesiredCamera 旋转以及修改标记 */
+	virtual void PrepareViewTargets();
 
 	virtual bool NeedUpdateViewTarget(AActor* InViewTarget, const FViewTargetCameraInfo& CameraInfo) const;
 
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
 
-	void SetConfigs(const TMap<EJoyCameraBasic, float>& Config);
+	void SetConfigs(const FJoyCameraBasicConfig& Config);
 
 	void ApplyConfig();
 
@@ -526,11 +779,18 @@ private:
 
 	void UpdateCameraControllers(float DeltaTime);
 
-	void ResetModifiedMarkers();
+	/** 帧内主遍历：依次执行每个 ViewTarget 的 Modifier、Desired -> Current 同步以及 Actor 朝向更新 */
+	void UpdateViewTargets(float DeltaTime);
+
+	void UpdateViewTargetPose(FViewTargetCameraInfo& CameraInfo, const AActor* ControlCharacter) const;
 
-	void SyncDesireCameraData(float DeltaTime);
+	/** ViewTarget 加入活跃集合，新加入时重置其修改标记 */
+	void ActivateViewTarget(const FViewTargetCameraHandle& Handle);
 
-	void UpdateActorTransform(float DeltaTime);
+	/** 将活跃集合中所有 ViewTarget 的 DesiredCamera 同步到 CurrentCamera，淡入期间按通道掩码与 LastCamera 混合 */
+	void BlendViewTargetCameras();
+
+	void UpdateActorTransform(FViewTargetCameraInfo& CameraInfo, const UJoyGravityManageSubsystem* GravityManager);
 
 	void UpdateArmLocation(float DeltaTime);
 
@@ -552,6 +812,9 @@ private:
 	UPROPERTY()
 	TWeakObjectPtr<UCurveFloat> BlendViewCurve{nullptr};
 
+	// BlendViewCurve 的烘焙结果，设置曲线时取得
+	TSharedPtr<const FJoyBakedCurve> BlendViewBakedCurve;
+
 	UPROPERTY()
 	FInputOverrideDescription InputOverrideDescription{};
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "JoyViewTargetCameraHandle.generated.h"
+
+/**
+ * 指向 FMultiViewTargetCameraManager 中某个相机数据的稳定句柄，
+ * 槽位被回收复用时 Generation 会递增，旧句柄随之失效
+ */
+USTRUCT()
+struct FViewTargetCameraHandle
+{
+	GENERATED_BODY()
+
+	int32 SlotIndex = INDEX_NONE;
+
+	uint32 Generation = 0;
+
+	bool IsValid() const
+	{
+		return SlotIndex != INDEX_NONE;
+	}
+
+	void Invalidate()
+	{
+		SlotIndex = INDEX_NONE;
+		Generation = 0;
+	}
+
+	friend bool operator==(const FViewTargetCameraHandle& L, const FViewTargetCameraHandle& R)
+	{
+		return L.SlotIndex == R.SlotIndex && L.Generation == R.Generation;
+	}
+
+	friend bool operator!=(const FViewTargetCameraHandle& L, const FViewTargetCameraHandle& R)
+	{
+		return !(L == R);
+	}
+};
@@ -0,0 +1,332 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraCollisionBenchmarkCommandlet.h"
+
+#include "Camera/CameraMode/JoyCameraMode_ThirdPerson.h"
+#include "Camera/JoyCameraComponent.h"
+#include "Camera/JoyPlayerCameraManager.h"
+#include "Character/JoyCharacter.h"
+#include "Components/BoxComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "JoyCameraReplay.h"
+#include "JoyLogChannels.h"
+
+UJoyCameraCollisionBenchmarkCommandlet::UJoyCameraCollisionBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+#if JOY_CAMERA_WITH_REPLAY
+
+namespace JoyCameraCollisionBenchmark
+{
+	static constexpr int32 NumHistogramBuckets = 10;
+
+	// 角色周围不放置图元的半径，避免角色生成在图元内部
+	static constexpr float ClearRadius = 150.f;
+
+	struct FSettings
+	{
+		int32 NumPrimitives = 500;
+
+		float Radius = 3000.f;
+
+		int32 Seed = 0;
+
+		int32 NumFrames = 600;
+
+		float DeltaTime = 1.f / 60.f;
+
+		float YawInput = 1.f;
+
+		float PitchInput = 0.5f;
+	};
+
+	struct FResult
+	{
+		int32 NumFrames = 0;
+
+		uint64 TotalUpdateCycles = 0;
+
+		uint64 TotalAsyncWaitCycles = 0;
+
+		uint64 PenetrationCycles = 0;
+
+		uint32 NumSweeps = 0;
+
+		uint32 NumCachedBlocks = 0;
+
+		double SumBlockedPct = 0.;
+
+		float MinBlockedPct = 1.f;
+
+		int32 Histogram[NumHistogramBuckets] = {};
+	};
+
+	/** 临时修改控制台变量，离开作用域时恢复 */
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, bool bValue)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (Variable != nullptr)
+			{
+				OldValue = Variable->GetString();
+				Variable->Set(bValue, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (Variable != nullptr)
+			{
+				Variable->Set(*OldValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* Variable = nullptr;
+
+		FString OldValue;
+	};
+
+	static void SpawnBlockingPrimitives(UWorld* World, const FSettings& Settings)
+	{
+		FRandomStream RandomStream(Settings.Seed);
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		for (int32 Index = 0; Index < Settings.NumPrimitives; ++Index)
+		{
+			const float Distance = RandomStream.FRandRange(ClearRadius, Settings.Radius);
+			const float Angle = RandomStream.FRandRange(0.f, UE_TWO_PI);
+			const FVector Location(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle),
+				RandomStream.FRandRange(-200.f, 400.f));
+			const FTransform Transform(FRotator(0.f, RandomStream.FRandRange(0.f, 360.f), 0.f), Location);
+
+			AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), Transform, SpawnParameters);
+			if (Actor == nullptr)
+			{
+				continue;
+			}
+
+			// 盒体与球体各占一半
+			UShapeComponent* Shape = nullptr;
+			if (RandomStream.FRand() < 0.5f)
+			{
+				UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+				Box->SetBoxExtent(FVector(RandomStream.FRandRange(20.f, 200.f), RandomStream.FRandRange(20.f, 200.f),
+									  RandomStream.FRandRange(20.f, 300.f)),
+					false);
+				Shape = Box;
+			}
+			else
+			{
+				USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+				Sphere->SetSphereRadius(RandomStream.FRandRange(20.f, 200.f), false);
+				Shape = Sphere;
+			}
+
+			Shape->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+			Actor->SetRootComponent(Shape);
+			Shape->RegisterComponent();
+			Shape->SetWorldTransform(Transform);
+		}
+	}
+
+	static uint64 FindStageCycles(const TArray<FJoyCameraStageProfiler::FStageResult>& Stages, const TCHAR* StageName)
+	{
+		const FJoyCameraStageProfiler::FStageResult* Stage = Stages.FindByPredicate(
+			[StageName](const FJoyCameraStageProfiler::FStageResult& Result)
+			{
+				return Result.StageName == StageName;
+			});
+		return Stage != nullptr ? Stage->TotalCycles : 0;
+	}
+
+	static uint32 FindStageCount(const TArray<FJoyCameraStageProfiler::FStageResult>& Stages, const TCHAR* StageName)
+	{
+		const FJoyCameraStageProfiler::FStageResult* Stage = Stages.FindByPredicate(
+			[StageName](const FJoyCameraStageProfiler::FStageResult& Result)
+			{
+				return Result.StageName == StageName;
+			});
+		return Stage != nullptr ? Stage->NumCalls : 0;
+	}
+
+	static bool Run(const FSettings& Settings, bool bAsync, FResult& OutResult)
+	{
+		UWorld* World = JoyCameraReplay::CreateHeadlessWorld(FString(), TEXT("JoyCameraCollisionBenchmark"));
+		if (World == nullptr)
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraCollisionBenchmark: 创建 World 失败"));
+			return false;
+		}
+
+		FScopedConsoleVariable AsyncPenetration(TEXT("Joy.Camera.AsyncPenetration"), bAsync);
+
+		// 保证每帧都执行穿透检测
+		FScopedConsoleVariable ForceFullEvaluation(TEXT("Joy.Camera.ForceFullEvaluation"), true);
+
+		bool bSucceeded = false;
+		{
+			FJoyCameraReplayer Replayer(World);
+			if (Replayer.Initialize())
+			{
+				SpawnBlockingPrimitives(World, Settings);
+
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				AJoyCharacter* Character = World->SpawnActor<AJoyCharacter>(
+					AJoyCharacter::StaticClass(), FTransform::Identity, SpawnParameters);
+				UJoyCameraComponent* CameraComponent = UJoyCameraComponent::FindCameraComponent(Character);
+
+				AJoyPlayerCameraManager* CameraManager = Replayer.GetCameraManager();
+				APlayerController* PlayerController = CameraManager->GetOwningPlayerController();
+				if (CameraComponent != nullptr && PlayerController != nullptr)
+				{
+					CameraComponent->PushCameraMode(UJoyCameraMode_ThirdPerson::StaticClass(), false);
+					CameraManager->SetViewTarget(Character);
+
+					FJoyCameraStageProfiler::Reset();
+					FJoyCameraStageProfiler::SetEnabled(true);
+
+					for (int32 Frame = 0; Frame < Settings.NumFrames; ++Frame)
+					{
+						// 水平匀速环绕，俯仰来回摆动
+						const float Time = Frame * Settings.DeltaTime;
+						Replayer.AddInput(EJoyCameraReplayEvent::YawInput, Settings.YawInput);
+						Replayer.AddInput(EJoyCameraReplayEvent::PitchInput, Settings.PitchInput * FMath::Sin(Time));
+
+						// 与 World Tick 一致，帧开始时等待上一帧的异步检测完成，帧结束时派发本帧的检测
+						const uint64 WaitStartCycles = FPlatformTime::Cycles64();
+						World->ResetAsyncTrace();
+						OutResult.TotalAsyncWaitCycles += FPlatformTime::Cycles64() - WaitStartCycles;
+
+						OutResult.TotalUpdateCycles += Replayer.UpdateCamera(Settings.DeltaTime, Settings.DeltaTime);
+						OutResult.NumFrames++;
+
+						World->FinishAsyncTrace();
+
+						// 没有 PlayerTick，手动把输入应用到控制器旋转
+						PlayerController->UpdateRotation(Settings.DeltaTime);
+						PlayerController->RotationInput = FRotator::ZeroRotator;
+
+						if (const UJoyCameraMode_ThirdPerson* CameraMode = Cast<UJoyCameraMode_ThirdPerson>(
+								CameraComponent->GetCameraModeInstance(UJoyCameraMode_ThirdPerson::StaticClass())))
+						{
+							const float BlockedPct = FMath::Clamp(CameraMode->AimLineToDesiredPosBlockedPct, 0.f, 1.f);
+							OutResult.SumBlockedPct += BlockedPct;
+							OutResult.MinBlockedPct = FMath::Min(OutResult.MinBlockedPct, BlockedPct);
+							OutResult.Histogram[FMath::Min(
+								FMath::FloorToInt32(BlockedPct * NumHistogramBuckets), NumHistogramBuckets - 1)]++;
+						}
+					}
+
+					FJoyCameraStageProfiler::SetEnabled(false);
+
+					const TArray<FJoyCameraStageProfiler::FStageResult> Stages = FJoyCameraStageProfiler::GetResults();
+					OutResult.PenetrationCycles =
+						FindStageCycles(Stages, TEXT("STAT_JoyCamera_UpdatePreventPenetration"));
+					OutResult.NumSweeps = FindStageCount(Stages, TEXT("STAT_JoyCamera_PenetrationSweeps"));
+					OutResult.NumCachedBlocks = FindStageCount(Stages, TEXT("STAT_JoyCamera_PenetrationCachedBlocks"));
+					bSucceeded = true;
+				}
+				else
+				{
+					UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraCollisionBenchmark: 生成 AJoyCharacter 失败"));
+				}
+			}
+		}
+
+		JoyCameraReplay::DestroyHeadlessWorld(World);
+		return bSucceeded;
+	}
+
+	static void Report(const TCHAR* ModeName, const FResult& Result)
+	{
+		const double FrameCount = FMath::Max(Result.NumFrames, 1);
+		UE_LOG(LogJoyCamera, Display, TEXT("JoyCameraCollisionBenchmark [%s]: %d 帧"), ModeName, Result.NumFrames);
+		UE_LOG(LogJoyCamera, Display, TEXT("  UpdateCamera            %10.2f us/帧"),
+			JoyCameraReplay::CyclesToNanoseconds(Result.TotalUpdateCycles, Result.NumFrames) / 1000.);
+		UE_LOG(LogJoyCamera, Display, TEXT("  PreventCameraPenetration %9.2f us/帧"),
+			JoyCameraReplay::CyclesToNanoseconds(Result.PenetrationCycles, Result.NumFrames) / 1000.);
+		UE_LOG(LogJoyCamera, Display, TEXT("  等待异步检测            %10.2f us/帧"),
+			JoyCameraReplay::CyclesToNanoseconds(Result.TotalAsyncWaitCycles, Result.NumFrames) / 1000.);
+		UE_LOG(LogJoyCamera, Display, TEXT("  场景检测 %.2f 次/帧，缓存确认 %.2f 次/帧"), Result.NumSweeps / FrameCount,
+			Result.NumCachedBlocks / FrameCount);
+		UE_LOG(LogJoyCamera, Display, TEXT("  DistBlockedPct 平均 %.3f，最小 %.3f"), Result.SumBlockedPct / FrameCount,
+			Result.MinBlockedPct);
+
+		for (int32 Bucket = 0; Bucket < NumHistogramBuckets; ++Bucket)
+		{
+			UE_LOG(LogJoyCamera, Display, TEXT("    [%.1f, %.1f%c %6d 帧 %6.2f%%"),
+				static_cast<float>(Bucket) / NumHistogramBuckets, static_cast<float>(Bucket + 1) / NumHistogramBuckets,
+				Bucket + 1 < NumHistogramBuckets ? TEXT(')') : TEXT(']'), Result.Histogram[Bucket],
+				100. * Result.Histogram[Bucket] / FrameCount);
+		}
+	}
+}
+
+int32 UJoyCameraCollisionBenchmarkCommandlet::Main(const FString& Params)
+{
+	JoyCameraCollisionBenchmark::FSettings Settings;
+	FParse::Value(*Params, TEXT("Primitives="), Settings.NumPrimitives);
+	FParse::Value(*Params, TEXT("Radius="), Settings.Radius);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	FParse::Value(*Params, TEXT("Frames="), Settings.NumFrames);
+	FParse::Value(*Params, TEXT("DeltaTime="), Settings.DeltaTime);
+	FParse::Value(*Params, TEXT("YawInput="), Settings.YawInput);
+	FParse::Value(*Params, TEXT("PitchInput="), Settings.PitchInput);
+
+	if (Settings.NumFrames <= 0 || Settings.DeltaTime <= 0.f)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraCollisionBenchmark: -Frames 与 -DeltaTime 必须大于 0"));
+		return 1;
+	}
+
+	FString ModesString(TEXT("Sync,Async"));
+	FParse::Value(*Params, TEXT("Modes="), ModesString, false);
+
+	TArray<FString> Modes;
+	ModesString.ParseIntoArray(Modes, TEXT(","));
+
+	UE_LOG(LogJoyCamera, Display, TEXT("JoyCameraCollisionBenchmark: %d 个图元，半径 %.0f，种子 %d"),
+		Settings.NumPrimitives, Settings.Radius, Settings.Seed);
+
+	for (const FString& Mode : Modes)
+	{
+		const bool bAsync = Mode.Equals(TEXT("Async"), ESearchCase::IgnoreCase);
+		if (!bAsync && !Mode.Equals(TEXT("Sync"), ESearchCase::IgnoreCase))
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraCollisionBenchmark: 未知的检测模式 %s"), *Mode);
+			return 1;
+		}
+
+		JoyCameraCollisionBenchmark::FResult Result;
+		if (!JoyCameraCollisionBenchmark::Run(Settings, bAsync, Result))
+		{
+			return 1;
+		}
+
+		JoyCameraCollisionBenchmark::Report(*Mode, Result);
+	}
+
+	return 0;
+}
+
+#else
+
+int32 UJoyCameraCollisionBenchmarkCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraCollisionBenchmark: 当前配置未开启阶段计时"));
+	return 1;
+}
+
+#endif
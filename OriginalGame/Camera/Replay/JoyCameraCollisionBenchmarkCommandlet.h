@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "JoyCameraCollisionBenchmarkCommandlet.generated.h"
+
+/**
+ * 无渲染的相机碰撞基准测试
+ *
+ * 在空 World 中随机放置 N 个阻挡图元，生成带 UJoyCameraComponent 的 AJoyCharacter，通过 UJoyCameraInputController
+ * 按固定路径环绕角色转动相机，输出每帧检测次数、每帧穿透处理耗时以及 DistBlockedPct 的分布。
+ * 同一场景依次在同步与异步检测模式下运行，便于对比。
+ *
+ * 参数:
+ *	-Primitives=<数量>		阻挡图元数量，默认 500
+ *	-Radius=<半径>			图元分布半径，默认 3000
+ *	-Seed=<种子>			随机种子，默认 0
+ *	-Frames=<帧数>			每种模式运行的帧数，默认 600
+ *	-DeltaTime=<秒>			每帧时间，默认 1/60
+ *	-YawInput=, -PitchInput=	每帧的水平输入与俯仰输入幅度
+ *	-Modes=Sync,Async		运行的检测模式，默认两种都运行
+ *
+ * 示例: UnrealEditor-Cmd OriginalGame -run=JoyCameraCollisionBenchmark -Primitives=2000 -nullrhi
+ */
+UCLASS()
+class UJoyCameraCollisionBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraCollisionBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
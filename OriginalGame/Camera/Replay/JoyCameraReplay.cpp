@@ -0,0 +1,636 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraReplay.h"
+
+#if JOY_CAMERA_WITH_REPLAY
+
+#include "Camera/Controller/JoyCameraInputController.h"
+#include "Camera/JoyCameraComponent.h"
+#include "Camera/JoyPlayerCameraManager.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "JoyLogChannels.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace JoyCameraReplay
+{
+	static constexpr uint32 ReplayMagic = 0x5052434A;	 // "JCRP"
+	static constexpr uint32 GoldenMagic = 0x4447434A;	 // "JCGD"
+	static constexpr int32 FileVersion = 3;
+
+	template <typename T>
+	static void SaveStruct(const T& Struct, TArray<uint8>& OutPayload)
+	{
+		FMemoryWriter Writer(OutPayload);
+		FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+		T::StaticStruct()->SerializeItem(Ar, const_cast<T*>(&Struct), nullptr);
+	}
+
+	template <typename T>
+	static void LoadStruct(const TArray<uint8>& Payload, T& OutStruct)
+	{
+		FMemoryReader Reader(Payload);
+		FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+		T::StaticStruct()->SerializeItem(Ar, &OutStruct, nullptr);
+	}
+
+	bool SerializeHeader(FArchive& Ar, uint32 ExpectedMagic)
+	{
+		uint32 Magic = ExpectedMagic;
+		int32 Version = FileVersion;
+		Ar << Magic;
+		Ar << Version;
+		return !Ar.IsError() && Magic == ExpectedMagic && Version == FileVersion;
+	}
+
+	bool LoadFrames(const FString& FilePath, TArray<FJoyCameraReplayFrame>& OutFrames)
+	{
+		const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!Reader.IsValid() || !SerializeHeader(*Reader, ReplayMagic))
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("LoadFrames: %s 不是有效的相机录制文件"), *FilePath);
+			return false;
+		}
+
+		// 录制过程中逐帧追加写入，没有帧数头，读到文件末尾为止
+		OutFrames.Reset();
+		while (Reader->Tell() < Reader->TotalSize() && !Reader->IsError())
+		{
+			*Reader << OutFrames.Emplace_GetRef();
+		}
+
+		return !Reader->IsError();
+	}
+
+	bool LoadGolden(const FString& FilePath, TArray<FJoyCameraReplayPOV>& OutPOVs)
+	{
+		const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!Reader.IsValid() || !SerializeHeader(*Reader, GoldenMagic))
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("LoadGolden: %s 不是有效的相机基准文件"), *FilePath);
+			return false;
+		}
+
+		*Reader << OutPOVs;
+		return !Reader->IsError();
+	}
+
+	bool SaveGolden(const FString& FilePath, TArray<FJoyCameraReplayPOV>& POVs)
+	{
+		const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer.IsValid())
+		{
+			UE_LOG(LogJoyCamera, Error, TEXT("SaveGolden: 无法写入 %s"), *FilePath);
+			return false;
+		}
+
+		SerializeHeader(*Writer, GoldenMagic);
+		*Writer << POVs;
+		return Writer->Close();
+	}
+
+	UWorld* CreateHeadlessWorld(const FString& MapName, const TCHAR* WorldName)
+	{
+		UWorld* World = nullptr;
+		if (MapName.IsEmpty())
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, WorldName);
+		}
+		else if (UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None))
+		{
+			World = UWorld::FindWorldInPackage(Package);
+			if (World != nullptr)
+			{
+				World->WorldType = EWorldType::Game;
+				World->AddToRoot();
+				World->InitWorld();
+			}
+		}
+
+		if (World == nullptr)
+		{
+			return nullptr;
+		}
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	void DestroyHeadlessWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+	}
+
+	double CyclesToNanoseconds(uint64 Cycles, int32 NumFrames)
+	{
+		return NumFrames > 0 ? FPlatformTime::ToSeconds64(Cycles) * 1e9 / NumFrames : 0.;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FJoyCameraReplayEvent& Event)
+{
+	uint8 Type = static_cast<uint8>(Event.Type);
+	Ar << Type;
+	Event.Type = static_cast<EJoyCameraReplayEvent>(Type);
+	Ar << Event.ActorIndex;
+
+	// 每种事件只写入用到的字段
+	switch (Event.Type)
+	{
+		case EJoyCameraReplayEvent::RegisterActor:
+			Ar << Event.Text;
+			break;
+		case EJoyCameraReplayEvent::ActorTransform:
+			Ar << Event.Transform;
+			break;
+		case EJoyCameraReplayEvent::YawInput:
+		case EJoyCameraReplayEvent::PitchInput:
+			Ar << Event.Value;
+			Ar << Event.Time;
+			break;
+		case EJoyCameraReplayEvent::ArmLengthInput:
+			Ar << Event.Value;
+			break;
+		case EJoyCameraReplayEvent::SetViewTarget:
+			Ar << Event.Text;
+			Ar << Event.bFlag;
+			Ar << Event.Payload;
+			break;
+		case EJoyCameraReplayEvent::ApplyCameraModify:
+			Ar << Event.Value;
+			Ar << Event.BlendInTime;
+			Ar << Event.BlendOutTime;
+			Ar << Event.bFlag;
+			Ar << Event.Payload;
+			Ar << Event.Priority;
+			Ar << Event.BlendMode;
+			Ar << Event.SequenceID;
+			break;
+		case EJoyCameraReplayEvent::BreakModifier:
+			Ar << Event.SequenceID;
+			break;
+		case EJoyCameraReplayEvent::PushCameraConfig:
+			Ar << Event.Text;
+			Ar << Event.SequenceID;
+			break;
+		case EJoyCameraReplayEvent::RemoveCameraConfig:
+			Ar << Event.SequenceID;
+			break;
+		case EJoyCameraReplayEvent::RemoveCameraConfigByID:
+			Ar << Event.Text;
+			break;
+		default:
+			Ar.SetError();
+			break;
+	}
+
+	return Ar;
+}
+
+FJoyCameraReplayPOV::FJoyCameraReplayPOV(const FMinimalViewInfo& ViewInfo)
+	: Location(ViewInfo.Location)
+	, Rotation(ViewInfo.Rotation)
+	, FOV(ViewInfo.FOV)
+{
+}
+
+FArchive& operator<<(FArchive& Ar, FJoyCameraReplayPOV& POV)
+{
+	Ar << POV.Location;
+	Ar << POV.Rotation;
+	Ar << POV.FOV;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FJoyCameraReplayFrame& Frame)
+{
+	Ar << Frame.DeltaTime;
+	Ar << Frame.DeltaTimeIgnoreTimeDilation;
+	Ar << Frame.LookInputTime;
+	Ar << Frame.Events;
+	Ar << Frame.POV;
+	return Ar;
+}
+
+/** ****************** FJoyCameraReplayRecorder ****************** */
+TUniquePtr<FJoyCameraReplayRecorder> FJoyCameraReplayRecorder::ActiveRecorder;
+
+FJoyCameraReplayRecorder::FJoyCameraReplayRecorder(
+	AJoyPlayerCameraManager* InCameraManager, TUniquePtr<FArchive>&& InWriter)
+	: CameraManager(InCameraManager)
+	, Writer(MoveTemp(InWriter))
+{
+}
+
+FJoyCameraReplayRecorder* FJoyCameraReplayRecorder::Get()
+{
+	FJoyCameraReplayRecorder* Recorder = ActiveRecorder.Get();
+	return Recorder != nullptr && !Recorder->bInsideUpdate ? Recorder : nullptr;
+}
+
+bool FJoyCameraReplayRecorder::Start(AJoyPlayerCameraManager* CameraManager, const FString& FilePath)
+{
+	check(IsInGameThread());
+
+	Stop();
+
+	if (CameraManager == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("FJoyCameraReplayRecorder::Start: CameraManager is null"));
+		return false;
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("FJoyCameraReplayRecorder::Start: 无法写入 %s"), *FilePath);
+		return false;
+	}
+
+	JoyCameraReplay::SerializeHeader(*Writer, JoyCameraReplay::ReplayMagic);
+	ActiveRecorder.Reset(new FJoyCameraReplayRecorder(CameraManager, MoveTemp(Writer)));
+
+	// 录制开始时的 ViewTarget 作为第一个事件，回放从同样的状态开始
+	ActiveRecorder->RecordSetViewTarget(CameraManager->GetViewTarget(), FViewTargetTransitionParams());
+	return true;
+}
+
+void FJoyCameraReplayRecorder::Stop()
+{
+	if (ActiveRecorder.IsValid())
+	{
+		ActiveRecorder->Writer->Close();
+		ActiveRecorder.Reset();
+	}
+}
+
+void FJoyCameraReplayRecorder::BeginFrame(const AJoyPlayerCameraManager* InCameraManager)
+{
+	FJoyCameraReplayRecorder* Recorder = ActiveRecorder.Get();
+	if (Recorder == nullptr || InCameraManager != Recorder->CameraManager.Get())
+	{
+		return;
+	}
+
+	FJoyCameraReplayFrame& PendingFrame = Recorder->PendingFrame;
+	PendingFrame.DeltaTime = InCameraManager->DeltaTimeThisFrame;
+	PendingFrame.DeltaTimeIgnoreTimeDilation = InCameraManager->DeltaTimeThisFrame_IgnoreTimeDilation;
+
+	// 相机更新过程中镜头方向输入使用同一个时间，与回放时一致
+	UJoyCameraInputController* InputController = InCameraManager->CameraInputController;
+	PendingFrame.LookInputTime = InputController->GetLookInputTime();
+	InputController->SetLookInputTimeOverride(PendingFrame.LookInputTime);
+
+	// 记录所有参与本帧更新的 ViewTarget 位置
+	const FMultiViewTargetCameraManager& ViewTargets = InCameraManager->MultiViewTargetCameraManager;
+	for (int32 Index = 0; Index < ViewTargets.NumActive(); ++Index)
+	{
+		if (AActor* ViewTarget = ViewTargets.GetByIndex(Index).ViewTarget.Get())
+		{
+			Recorder->AddEvent(EJoyCameraReplayEvent::ActorTransform, ViewTarget).Transform = ViewTarget->GetActorTransform();
+		}
+	}
+
+	Recorder->bInsideUpdate = true;
+}
+
+void FJoyCameraReplayRecorder::EndFrame(const AJoyPlayerCameraManager* InCameraManager, const FMinimalViewInfo& POV)
+{
+	FJoyCameraReplayRecorder* Recorder = ActiveRecorder.Get();
+	if (Recorder == nullptr || InCameraManager != Recorder->CameraManager.Get())
+	{
+		return;
+	}
+
+	Recorder->bInsideUpdate = false;
+	InCameraManager->CameraInputController->ClearLookInputTimeOverride();
+
+	Recorder->PendingFrame.POV = FJoyCameraReplayPOV(POV);
+	*Recorder->Writer << Recorder->PendingFrame;
+	Recorder->PendingFrame.Events.Reset();
+}
+
+int32 FJoyCameraReplayRecorder::GetActorIndex(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ActorIndex = ActorIndices.Find(FObjectKey(Actor)))
+	{
+		return *ActorIndex;
+	}
+
+	const int32 NewIndex = ActorIndices.Add(FObjectKey(Actor), ActorIndices.Num());
+	FJoyCameraReplayEvent& Event = PendingFrame.Events.Emplace_GetRef();
+	Event.Type = EJoyCameraReplayEvent::RegisterActor;
+	Event.ActorIndex = NewIndex;
+	Event.Text = Actor->GetClass()->GetPathName();
+	return NewIndex;
+}
+
+FJoyCameraReplayEvent& FJoyCameraReplayRecorder::AddEvent(EJoyCameraReplayEvent Type, AActor* Actor)
+{
+	// 先登记 Actor，保证回放时登记事件位于引用它的事件之前
+	const int32 ActorIndex = GetActorIndex(Actor);
+
+	FJoyCameraReplayEvent& Event = PendingFrame.Events.Emplace_GetRef();
+	Event.Type = Type;
+	Event.ActorIndex = ActorIndex;
+	return Event;
+}
+
+void FJoyCameraReplayRecorder::RecordInput(EJoyCameraReplayEvent Type, float Value, double Time)
+{
+	FJoyCameraReplayEvent& Event = AddEvent(Type, nullptr);
+	Event.Value = Value;
+	Event.Time = Time;
+}
+
+void FJoyCameraReplayRecorder::RecordSetViewTarget(AActor* NewViewTarget,
+	const FViewTargetTransitionParams& TransitionParams, const UCurveFloat* BlendCurve, bool bEnableUpdateCameraConfig)
+{
+	FJoyCameraReplayEvent& Event = AddEvent(EJoyCameraReplayEvent::SetViewTarget, NewViewTarget);
+	Event.Text = BlendCurve != nullptr ? BlendCurve->GetPathName() : FString();
+	Event.bFlag = bEnableUpdateCameraConfig;
+	JoyCameraReplay::SaveStruct(TransitionParams, Event.Payload);
+}
+
+void FJoyCameraReplayRecorder::RecordApplyCameraModify(AActor* ModifyTarget, float Duration, float BlendInTime,
+	float BlendOutTime, const FCameraModifiers& CameraModifiers, bool bNeedManualBreak, int32 Priority,
+	EJoyCameraModifyBlendMode BlendMode, int64 HandleID)
+{
+	FJoyCameraReplayEvent& Event = AddEvent(EJoyCameraReplayEvent::ApplyCameraModify, ModifyTarget);
+	Event.Value = Duration;
+	Event.BlendInTime = BlendInTime;
+	Event.BlendOutTime = BlendOutTime;
+	Event.bFlag = bNeedManualBreak;
+	Event.Priority = Priority;
+	Event.BlendMode = static_cast<uint8>(BlendMode);
+	Event.SequenceID = HandleID;
+	JoyCameraReplay::SaveStruct(CameraModifiers, Event.Payload);
+}
+
+void FJoyCameraReplayRecorder::RecordBreakModifier(AActor* ModifyTarget, int64 HandleID)
+{
+	AddEvent(EJoyCameraReplayEvent::BreakModifier, ModifyTarget).SequenceID = HandleID;
+}
+
+void FJoyCameraReplayRecorder::RecordPushCameraConfig(AActor* Owner, FName CameraID, int64 HandleID)
+{
+	FJoyCameraReplayEvent& Event = AddEvent(EJoyCameraReplayEvent::PushCameraConfig, Owner);
+	Event.Text = CameraID.ToString();
+	Event.SequenceID = HandleID;
+}
+
+void FJoyCameraReplayRecorder::RecordRemoveCameraConfig(AActor* Owner, int64 HandleID)
+{
+	AddEvent(EJoyCameraReplayEvent::RemoveCameraConfig, Owner).SequenceID = HandleID;
+}
+
+void FJoyCameraReplayRecorder::RecordRemoveCameraConfigByID(AActor* Owner, FName CameraID)
+{
+	AddEvent(EJoyCameraReplayEvent::RemoveCameraConfigByID, Owner).Text = CameraID.ToString();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GJoyCameraReplayRecordCommand(TEXT("Joy.Camera.Replay.Record"),
+	TEXT("开始录制相机输入，参数为输出文件路径，默认写入 Saved/CameraReplay/"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args, UWorld* World)
+		{
+			APlayerController* PlayerController = World != nullptr ? World->GetFirstPlayerController() : nullptr;
+			auto* CameraManager =
+				PlayerController != nullptr ? Cast<AJoyPlayerCameraManager>(PlayerController->PlayerCameraManager) : nullptr;
+
+			const FString FilePath = Args.Num() > 0
+				? Args[0]
+				: FPaths::ProjectSavedDir() / TEXT("CameraReplay") / FDateTime::Now().ToString() + TEXT(".jcrp");
+			if (FJoyCameraReplayRecorder::Start(CameraManager, FilePath))
+			{
+				UE_LOG(LogJoyCamera, Display, TEXT("开始录制相机输入: %s"), *FilePath);
+			}
+		}));
+
+static FAutoConsoleCommand GJoyCameraReplayStopCommand(TEXT("Joy.Camera.Replay.Stop"), TEXT("停止录制相机输入"),
+	FConsoleCommandDelegate::CreateStatic(&FJoyCameraReplayRecorder::Stop));
+
+/** ****************** FJoyCameraReplayer ****************** */
+FJoyCameraReplayer::FJoyCameraReplayer(UWorld* InWorld)
+	: World(InWorld)
+{
+}
+
+bool FJoyCameraReplayer::Initialize()
+{
+	if (World == nullptr)
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.bDeferConstruction = true;
+
+	APlayerController* PlayerController =
+		World->SpawnActor<APlayerController>(APlayerController::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (PlayerController == nullptr)
+	{
+		return false;
+	}
+
+	PlayerController->PlayerCameraManagerClass = AJoyPlayerCameraManager::StaticClass();
+	PlayerController->FinishSpawning(FTransform::Identity);
+
+	CameraManager = Cast<AJoyPlayerCameraManager>(PlayerController->PlayerCameraManager);
+	if (CameraManager == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("FJoyCameraReplayer: 生成 AJoyPlayerCameraManager 失败"));
+		return false;
+	}
+
+	// 没有 LocalPlayer，需要关闭客户端相机更新的判断，否则 UpdateCamera 不会执行
+	CameraManager->bUseClientSideCameraUpdates = false;
+	return true;
+}
+
+AActor* FJoyCameraReplayer::GetActor(int32 ActorIndex) const
+{
+	return Actors.IsValidIndex(ActorIndex) ? Actors[ActorIndex].Get() : nullptr;
+}
+
+void FJoyCameraReplayer::ApplyEvent(const FJoyCameraReplayEvent& Event)
+{
+	AActor* Actor = GetActor(Event.ActorIndex);
+	switch (Event.Type)
+	{
+		case EJoyCameraReplayEvent::RegisterActor:
+		{
+			// 优先生成录制时的类以保留其相机组件，类不存在时退化为 Pawn，保证仍被相机管理
+			UClass* ActorClass = LoadClass<AActor>(nullptr, *Event.Text);
+			if (ActorClass == nullptr)
+			{
+				UE_LOG(LogJoyCamera, Warning, TEXT("FJoyCameraReplayer: 找不到类 %s，使用 APawn 代替"), *Event.Text);
+				ActorClass = APawn::StaticClass();
+			}
+
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			Actors.SetNum(FMath::Max(Actors.Num(), Event.ActorIndex + 1));
+			Actors[Event.ActorIndex] = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParameters);
+			break;
+		}
+		case EJoyCameraReplayEvent::ActorTransform:
+			if (Actor != nullptr)
+			{
+				Actor->SetActorTransform(Event.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			}
+			break;
+		case EJoyCameraReplayEvent::YawInput:
+			CameraManager->CameraInputController->SetLookInputTimeOverride(Event.Time);
+			CameraManager->CameraInputController->AddYawInput(Event.Value);
+			break;
+		case EJoyCameraReplayEvent::PitchInput:
+			CameraManager->CameraInputController->SetLookInputTimeOverride(Event.Time);
+			CameraManager->CameraInputController->AddPitchInput(Event.Value);
+			break;
+		case EJoyCameraReplayEvent::ArmLengthInput:
+			CameraManager->CameraInputController->AddDeviceArmLengthInput(Event.Value);
+			break;
+		case EJoyCameraReplayEvent::SetViewTarget:
+		{
+			FViewTargetTransitionParams TransitionParams;
+			JoyCameraReplay::LoadStruct(Event.Payload, TransitionParams);
+			if (Event.Text.IsEmpty())
+			{
+				CameraManager->SetViewTarget(Actor, TransitionParams);
+			}
+			else
+			{
+				CameraManager->SetViewTargetWithCurveBlend(
+					Actor, LoadObject<UCurveFloat>(nullptr, *Event.Text), Event.bFlag, TransitionParams);
+			}
+			break;
+		}
+		case EJoyCameraReplayEvent::ApplyCameraModify:
+			if (UJoyCameraModifierController* ModifierController = CameraManager->GetCameraModifier(Actor))
+			{
+				FCameraModifiers CameraModifiers;
+				JoyCameraReplay::LoadStruct(Event.Payload, CameraModifiers);
+				const FCameraModifyHandle Handle = ModifierController->ApplyCameraModify(Event.Value,
+					Event.BlendInTime, Event.BlendOutTime, CameraModifiers, Event.bFlag, Event.Priority,
+					static_cast<EJoyCameraModifyBlendMode>(Event.BlendMode));
+				ModifyHandles.Add(TPair<int32, int64>(Event.ActorIndex, Event.SequenceID), Handle.SequenceID);
+			}
+			break;
+		case EJoyCameraReplayEvent::BreakModifier:
+			if (UJoyCameraModifierController* ModifierController = CameraManager->GetCameraModifier(Actor))
+			{
+				const int64* HandleID = ModifyHandles.Find(TPair<int32, int64>(Event.ActorIndex, Event.SequenceID));
+				ModifierController->BreakModifier(FCameraModifyHandle(HandleID != nullptr ? *HandleID : 0));
+			}
+			break;
+		case EJoyCameraReplayEvent::PushCameraConfig:
+			if (UJoyCameraComponent* CameraComponent = UJoyCameraComponent::FindCameraComponent(Actor))
+			{
+				const FJoyCameraIDHandle Handle = CameraComponent->PushCameraConfig(FName(*Event.Text));
+				CameraConfigHandles.Add(TPair<int32, int64>(Event.ActorIndex, Event.SequenceID), Handle.SequenceID);
+			}
+			break;
+		case EJoyCameraReplayEvent::RemoveCameraConfig:
+			if (UJoyCameraComponent* CameraComponent = UJoyCameraComponent::FindCameraComponent(Actor))
+			{
+				int64 HandleID = 0;
+				CameraConfigHandles.RemoveAndCopyValue(TPair<int32, int64>(Event.ActorIndex, Event.SequenceID), HandleID);
+				CameraComponent->RemoveCameraConfig(FJoyCameraIDHandle(HandleID));
+			}
+			break;
+		case EJoyCameraReplayEvent::RemoveCameraConfigByID:
+			if (UJoyCameraComponent* CameraComponent = UJoyCameraComponent::FindCameraComponent(Actor))
+			{
+				CameraComponent->RemoveCameraConfigByID(FName(*Event.Text));
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+void FJoyCameraReplayer::Run(const TArray<FJoyCameraReplayFrame>& Frames, TArray<FJoyCameraReplayPOV>& OutPOVs,
+	FJoyCameraReplayTiming& OutTiming)
+{
+	check(CameraManager != nullptr);
+
+	OutPOVs.Reset(Frames.Num());
+	OutTiming = FJoyCameraReplayTiming();
+
+	FJoyCameraStageProfiler::Reset();
+	FJoyCameraStageProfiler::SetEnabled(true);
+
+	for (const FJoyCameraReplayFrame& Frame : Frames)
+	{
+		for (const FJoyCameraReplayEvent& Event : Frame.Events)
+		{
+			ApplyEvent(Event);
+		}
+
+		OutTiming.TotalUpdateCycles +=
+			UpdateCamera(Frame.DeltaTime, Frame.DeltaTimeIgnoreTimeDilation, Frame.LookInputTime);
+		OutTiming.NumFrames++;
+
+		OutPOVs.Emplace(CameraManager->GetCameraCacheView());
+	}
+
+	FJoyCameraStageProfiler::SetEnabled(false);
+	OutTiming.Stages = FJoyCameraStageProfiler::GetResults();
+}
+
+void FJoyCameraReplayer::AddInput(EJoyCameraReplayEvent Type, float Value)
+{
+	check(Type == EJoyCameraReplayEvent::YawInput || Type == EJoyCameraReplayEvent::PitchInput ||
+		  Type == EJoyCameraReplayEvent::ArmLengthInput);
+
+	FJoyCameraReplayEvent Event;
+	Event.Type = Type;
+	Event.Value = Value;
+	Event.Time = LookInputTime + LastDeltaTimeIgnoreTimeDilation;
+	ApplyEvent(Event);
+}
+
+uint64 FJoyCameraReplayer::UpdateCamera(float DeltaTime, float DeltaTimeIgnoreTimeDilation)
+{
+	return UpdateCamera(DeltaTime, DeltaTimeIgnoreTimeDilation, LookInputTime + DeltaTimeIgnoreTimeDilation);
+}
+
+uint64 FJoyCameraReplayer::UpdateCamera(float DeltaTime, float DeltaTimeIgnoreTimeDilation, double InLookInputTime)
+{
+	check(CameraManager != nullptr);
+
+	LookInputTime = InLookInputTime;
+	LastDeltaTimeIgnoreTimeDilation = DeltaTimeIgnoreTimeDilation;
+	CameraManager->CameraInputController->SetLookInputTimeOverride(LookInputTime);
+
+	// Tick 中根据时间膨胀计算的 DeltaTime 直接使用给定值
+	CameraManager->DeltaTimeThisFrame = DeltaTime;
+	CameraManager->DeltaTimeThisFrame_IgnoreTimeDilation = DeltaTimeIgnoreTimeDilation;
+	World->TimeSeconds += DeltaTime;
+	World->RealTimeSeconds += DeltaTimeIgnoreTimeDilation;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	CameraManager->UpdateCamera(DeltaTime);
+	return FPlatformTime::Cycles64() - StartCycles;
+}
+
+#endif
@@ -0,0 +1,254 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/CameraTypes.h"
+#include "Camera/Controller/JoyCameraModifierController.h"
+#include "Camera/JoyCameraStats.h"
+#include "Camera/PlayerCameraManager.h"
+#include "UObject/ObjectKey.h"
+
+// 回放依赖阶段计时统计耗时，两者同时开启
+#define JOY_CAMERA_WITH_REPLAY JOY_CAMERA_WITH_STAGE_PROFILER
+
+#if JOY_CAMERA_WITH_REPLAY
+
+class AActor;
+class AJoyPlayerCameraManager;
+class UCurveFloat;
+class UWorld;
+
+/** 回放文件中记录的相机事件类型，数值写入文件，只能在末尾追加 */
+enum class EJoyCameraReplayEvent : uint8
+{
+	// 首次引用某个 Actor 时登记，Text 为其类路径
+	RegisterActor = 0,
+	ActorTransform,
+	YawInput,
+	PitchInput,
+	ArmLengthInput,
+	// Payload 为 FViewTargetTransitionParams，Text 为混合曲线路径，bFlag 为 bEnableUpdateCameraConfig
+	SetViewTarget,
+	// Value、BlendInTime、BlendOutTime 对应 Duration、BlendInTime、BlendOutTime，Payload 为 FCameraModifiers，
+	// Priority、BlendMode 为修改层参数，SequenceID 为录制时返回的句柄
+	ApplyCameraModify,
+	// SequenceID 为录制时的句柄，0 表示所有层
+	BreakModifier,
+	// Text 为 CameraID，SequenceID 为录制时返回的句柄
+	PushCameraConfig,
+	RemoveCameraConfig,
+	RemoveCameraConfigByID,
+};
+
+struct ORIGINALGAME_API FJoyCameraReplayEvent
+{
+	EJoyCameraReplayEvent Type = EJoyCameraReplayEvent::RegisterActor;
+
+	int32 ActorIndex = INDEX_NONE;
+
+	float Value = 0.f;
+
+	// YawInput、PitchInput 输入时的时间，回放时按此时间积分
+	double Time = 0.;
+
+	float BlendInTime = 0.f;
+
+	float BlendOutTime = 0.f;
+
+	bool bFlag = false;
+
+	int32 Priority = 0;
+
+	uint8 BlendMode = 0;
+
+	int64 SequenceID = 0;
+
+	FString Text;
+
+	FTransform Transform = FTransform::Identity;
+
+	TArray<uint8> Payload;
+
+	friend FArchive& operator<<(FArchive& Ar, FJoyCameraReplayEvent& Event);
+};
+
+/** 一帧相机更新的输出结果 */
+struct ORIGINALGAME_API FJoyCameraReplayPOV
+{
+	FVector Location = FVector::ZeroVector;
+
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	float FOV = 0.f;
+
+	FJoyCameraReplayPOV() = default;
+
+	explicit FJoyCameraReplayPOV(const FMinimalViewInfo& ViewInfo);
+
+	friend FArchive& operator<<(FArchive& Ar, FJoyCameraReplayPOV& POV);
+};
+
+struct ORIGINALGAME_API FJoyCameraReplayFrame
+{
+	float DeltaTime = 0.f;
+
+	float DeltaTimeIgnoreTimeDilation = 0.f;
+
+	/** 本帧相机更新时镜头方向输入使用的时间 */
+	double LookInputTime = 0.;
+
+	/** 在本帧相机更新之前发生的事件，按发生顺序排列 */
+	TArray<FJoyCameraReplayEvent> Events;
+
+	/** 录制时本帧相机更新的结果 */
+	FJoyCameraReplayPOV POV;
+
+	friend FArchive& operator<<(FArchive& Ar, FJoyCameraReplayFrame& Frame);
+};
+
+namespace JoyCameraReplay
+{
+	/** 写入文件头并校验读取到的文件头 */
+	ORIGINALGAME_API bool SerializeHeader(FArchive& Ar, uint32 ExpectedMagic);
+
+	ORIGINALGAME_API bool LoadFrames(const FString& FilePath, TArray<FJoyCameraReplayFrame>& OutFrames);
+
+	ORIGINALGAME_API bool LoadGolden(const FString& FilePath, TArray<FJoyCameraReplayPOV>& OutPOVs);
+
+	ORIGINALGAME_API bool SaveGolden(const FString& FilePath, TArray<FJoyCameraReplayPOV>& POVs);
+
+	/** 创建不渲染的游戏 World 并开始游戏，MapName 为空时创建空 World */
+	ORIGINALGAME_API UWorld* CreateHeadlessWorld(const FString& MapName, const TCHAR* WorldName);
+
+	ORIGINALGAME_API void DestroyHeadlessWorld(UWorld* World);
+
+	ORIGINALGAME_API double CyclesToNanoseconds(uint64 Cycles, int32 NumFrames);
+}
+
+/**
+ * 相机录制器
+ *
+ * 录制期间把外部对相机系统的调用（输入、切换 ViewTarget、Modify、镜头配置）以及每帧的
+ * DeltaTime、ViewTarget 位置和相机结果逐帧写入二进制文件。相机更新过程中产生的调用是更新的结果，
+ * 回放时会被重新产生，因此不做记录。
+ */
+class ORIGINALGAME_API FJoyCameraReplayRecorder
+{
+public:
+	/** 当前正在录制且不处于相机更新过程中时返回录制器 */
+	static FJoyCameraReplayRecorder* Get();
+
+	static bool Start(AJoyPlayerCameraManager* CameraManager, const FString& FilePath);
+
+	static void Stop();
+
+	/** 相机更新开始前调用，记录本帧 DeltaTime 与 ViewTarget 位置，并屏蔽更新过程中产生的调用 */
+	static void BeginFrame(const AJoyPlayerCameraManager* CameraManager);
+
+	/** 相机更新结束后调用，记录本帧结果并写入文件 */
+	static void EndFrame(const AJoyPlayerCameraManager* CameraManager, const FMinimalViewInfo& POV);
+
+	/** Time 为镜头方向输入时的时间，只对 YawInput、PitchInput 有效 */
+	void RecordInput(EJoyCameraReplayEvent Type, float Value, double Time = 0.);
+
+	void RecordSetViewTarget(AActor* NewViewTarget, const FViewTargetTransitionParams& TransitionParams,
+		const UCurveFloat* BlendCurve = nullptr, bool bEnableUpdateCameraConfig = false);
+
+	void RecordApplyCameraModify(AActor* ModifyTarget, float Duration, float BlendInTime, float BlendOutTime,
+		const FCameraModifiers& CameraModifiers, bool bNeedManualBreak, int32 Priority,
+		EJoyCameraModifyBlendMode BlendMode, int64 HandleID);
+
+	void RecordBreakModifier(AActor* ModifyTarget, int64 HandleID);
+
+	void RecordPushCameraConfig(AActor* Owner, FName CameraID, int64 HandleID);
+
+	void RecordRemoveCameraConfig(AActor* Owner, int64 HandleID);
+
+	void RecordRemoveCameraConfigByID(AActor* Owner, FName CameraID);
+
+private:
+	FJoyCameraReplayRecorder(AJoyPlayerCameraManager* InCameraManager, TUniquePtr<FArchive>&& InWriter);
+
+	int32 GetActorIndex(AActor* Actor);
+
+	FJoyCameraReplayEvent& AddEvent(EJoyCameraReplayEvent Type, AActor* Actor);
+
+	TWeakObjectPtr<AJoyPlayerCameraManager> CameraManager;
+
+	TUniquePtr<FArchive> Writer;
+
+	TMap<FObjectKey, int32> ActorIndices;
+
+	FJoyCameraReplayFrame PendingFrame;
+
+	bool bInsideUpdate = false;
+
+	static TUniquePtr<FJoyCameraReplayRecorder> ActiveRecorder;
+};
+
+/** 回放过程中每个阶段的耗时统计 */
+struct ORIGINALGAME_API FJoyCameraReplayTiming
+{
+	int32 NumFrames = 0;
+
+	uint64 TotalUpdateCycles = 0;
+
+	TArray<FJoyCameraStageProfiler::FStageResult> Stages;
+};
+
+/**
+ * 相机回放器
+ *
+ * 在给定 World 中生成 PlayerController 与 AJoyPlayerCameraManager，按录制顺序重放事件并逐帧驱动相机更新，
+ * 不依赖渲染，可在 -nullrhi 下运行。
+ */
+class ORIGINALGAME_API FJoyCameraReplayer
+{
+public:
+	explicit FJoyCameraReplayer(UWorld* InWorld);
+
+	bool Initialize();
+
+	void Run(const TArray<FJoyCameraReplayFrame>& Frames, TArray<FJoyCameraReplayPOV>& OutPOVs,
+		FJoyCameraReplayTiming& OutTiming);
+
+	/**
+	 * 直接输入相机旋转或臂长，Type 为 YawInput、PitchInput 或 ArmLengthInput
+	 * 镜头方向输入的时间按上一帧的间隔估计为下一帧相机更新的时间
+	 */
+	void AddInput(EJoyCameraReplayEvent Type, float Value);
+
+	/** 以给定的 DeltaTime 推进 World 时间与镜头方向输入时钟并更新一帧相机，返回 UpdateCamera 的耗时 */
+	uint64 UpdateCamera(float DeltaTime, float DeltaTimeIgnoreTimeDilation);
+
+	AJoyPlayerCameraManager* GetCameraManager() const
+	{
+		return CameraManager;
+	}
+
+private:
+	uint64 UpdateCamera(float DeltaTime, float DeltaTimeIgnoreTimeDilation, double InLookInputTime);
+
+	void ApplyEvent(const FJoyCameraReplayEvent& Event);
+
+	AActor* GetActor(int32 ActorIndex) const;
+
+	UWorld* World = nullptr;
+
+	AJoyPlayerCameraManager* CameraManager = nullptr;
+
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	// 镜头方向输入时钟，回放录制文件时为录制时的时间
+	double LookInputTime = 0.;
+
+	float LastDeltaTimeIgnoreTimeDilation = 0.f;
+
+	// (ActorIndex, 录制时的句柄) -> 回放时的句柄
+	TMap<TPair<int32, int64>, int64> CameraConfigHandles;
+
+	// (ActorIndex, 录制时的修改句柄) -> 回放时的修改句柄
+	TMap<TPair<int32, int64>, int64> ModifyHandles;
+};
+
+#endif
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraReplayCommandlet.h"
+
+#include "Engine/World.h"
+#include "JoyCameraReplay.h"
+#include "JoyLogChannels.h"
+
+UJoyCameraReplayCommandlet::UJoyCameraReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+#if JOY_CAMERA_WITH_REPLAY
+
+int32 UJoyCameraReplayCommandlet::Main(const FString& Params)
+{
+	FString ReplayPath;
+	if (!FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraReplay: 缺少 -Replay=<录制文件>"));
+		return 1;
+	}
+
+	FString GoldenPath;
+	FString WriteGoldenPath;
+	FString MapName;
+	FParse::Value(*Params, TEXT("Golden="), GoldenPath);
+	FParse::Value(*Params, TEXT("WriteGolden="), WriteGoldenPath);
+	FParse::Value(*Params, TEXT("Map="), MapName);
+
+	float LocationTolerance = 0.01f;
+	float RotationTolerance = 0.01f;
+	float FovTolerance = 0.01f;
+	FParse::Value(*Params, TEXT("LocationTolerance="), LocationTolerance);
+	FParse::Value(*Params, TEXT("RotationTolerance="), RotationTolerance);
+	FParse::Value(*Params, TEXT("FovTolerance="), FovTolerance);
+
+	TArray<FJoyCameraReplayFrame> Frames;
+	if (!JoyCameraReplay::LoadFrames(ReplayPath, Frames))
+	{
+		return 1;
+	}
+
+	// 基准结果默认使用录制时的相机结果
+	TArray<FJoyCameraReplayPOV> ExpectedPOVs;
+	if (GoldenPath.IsEmpty())
+	{
+		for (const FJoyCameraReplayFrame& Frame : Frames)
+		{
+			ExpectedPOVs.Add(Frame.POV);
+		}
+	}
+	else if (!JoyCameraReplay::LoadGolden(GoldenPath, ExpectedPOVs))
+	{
+		return 1;
+	}
+
+	UWorld* World = JoyCameraReplay::CreateHeadlessWorld(MapName, TEXT("JoyCameraReplay"));
+	if (World == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraReplay: 创建 World 失败 %s"), *MapName);
+		return 1;
+	}
+
+	TArray<FJoyCameraReplayPOV> POVs;
+	FJoyCameraReplayTiming Timing;
+	{
+		FJoyCameraReplayer Replayer(World);
+		if (!Replayer.Initialize())
+		{
+			JoyCameraReplay::DestroyHeadlessWorld(World);
+			return 1;
+		}
+
+		Replayer.Run(Frames, POVs, Timing);
+	}
+
+	JoyCameraReplay::DestroyHeadlessWorld(World);
+
+	UE_LOG(LogJoyCamera, Display, TEXT("JoyCameraReplay: %d 帧，UpdateCamera 平均 %.1f ns/帧"), Timing.NumFrames,
+		JoyCameraReplay::CyclesToNanoseconds(Timing.TotalUpdateCycles, Timing.NumFrames));
+	for (const FJoyCameraStageProfiler::FStageResult& Stage : Timing.Stages)
+	{
+		UE_LOG(LogJoyCamera, Display, TEXT("  %-48s %10.1f ns/帧 %8.2f 次/帧"), *Stage.StageName,
+			JoyCameraReplay::CyclesToNanoseconds(Stage.TotalCycles, Timing.NumFrames),
+			Timing.NumFrames > 0 ? static_cast<float>(Stage.NumCalls) / Timing.NumFrames : 0.f);
+	}
+
+	if (!WriteGoldenPath.IsEmpty() && !JoyCameraReplay::SaveGolden(WriteGoldenPath, POVs))
+	{
+		return 1;
+	}
+
+	if (ExpectedPOVs.Num() != POVs.Num())
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraReplay: 帧数不一致，基准 %d 帧，回放 %d 帧"), ExpectedPOVs.Num(),
+			POVs.Num());
+		return 1;
+	}
+
+	int32 FirstDivergentFrame = INDEX_NONE;
+	double MaxLocationError = 0.;
+	double MaxRotationError = 0.;
+	float MaxFovError = 0.f;
+	for (int32 Index = 0; Index < POVs.Num(); ++Index)
+	{
+		const FJoyCameraReplayPOV& Expected = ExpectedPOVs[Index];
+		const FJoyCameraReplayPOV& Actual = POVs[Index];
+
+		const double LocationError = FVector::Dist(Expected.Location, Actual.Location);
+		const double RotationError = (Expected.Rotation - Actual.Rotation).GetNormalized().GetManhattanDistance(FRotator::ZeroRotator);
+		const float FovError = FMath::Abs(Expected.FOV - Actual.FOV);
+
+		MaxLocationError = FMath::Max(MaxLocationError, LocationError);
+		MaxRotationError = FMath::Max(MaxRotationError, RotationError);
+		MaxFovError = FMath::Max(MaxFovError, FovError);
+
+		if (FirstDivergentFrame == INDEX_NONE &&
+			(LocationError > LocationTolerance || RotationError > RotationTolerance || FovError > FovTolerance))
+		{
+			FirstDivergentFrame = Index;
+		}
+	}
+
+	UE_LOG(LogJoyCamera, Display, TEXT("JoyCameraReplay: 最大误差 Location %.4f, Rotation %.4f, Fov %.4f"),
+		MaxLocationError, MaxRotationError, MaxFovError);
+
+	if (FirstDivergentFrame != INDEX_NONE)
+	{
+		const FJoyCameraReplayPOV& Expected = ExpectedPOVs[FirstDivergentFrame];
+		const FJoyCameraReplayPOV& Actual = POVs[FirstDivergentFrame];
+		UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraReplay: 第 %d 帧开始偏离基准，期望 %s %s %.2f，实际 %s %s %.2f"),
+			FirstDivergentFrame, *Expected.Location.ToString(), *Expected.Rotation.ToString(), Expected.FOV,
+			*Actual.Location.ToString(), *Actual.Rotation.ToString(), Actual.FOV);
+		return 1;
+	}
+
+	return 0;
+}
+
+#else
+
+int32 UJoyCameraReplayCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogJoyCamera, Error, TEXT("JoyCameraReplay: 当前配置未开启相机回放"));
+	return 1;
+}
+
+#endif
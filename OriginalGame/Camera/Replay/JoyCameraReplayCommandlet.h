@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "JoyCameraReplayCommandlet.generated.h"
+
+/**
+ * 无渲染回放相机录制文件，输出各阶段每帧耗时，并与基准结果比对
+ *
+ * 参数:
+ *	-Replay=<录制文件>		必填
+ *	-Golden=<基准文件>		与基准结果比对，不指定时与录制时的结果比对
+ *	-WriteGolden=<基准文件>	将本次回放结果写为新的基准
+ *	-Map=<地图>				回放使用的地图，不指定时使用空 World
+ *	-LocationTolerance=, -RotationTolerance=, -FovTolerance=	比对容差
+ *
+ * 示例: UnrealEditor-Cmd OriginalGame -run=JoyCameraReplay -Replay=Saved/CameraReplay/Test.jcrp -nullrhi
+ */
+UCLASS()
+class UJoyCameraReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -69,10 +69,17 @@ void AJoyPlayerController::RemoveTimeDilation()
 
 void AJoyPlayerController::DoSwitchCharacter()
 {
+	const auto* JoyCameraManager = Cast<AJoyPlayerCameraManager>(PlayerCameraManager);
+	const auto FindCamera = [JoyCameraManager](const AActor* Character)
+	{
+		return JoyCameraManager != nullptr ? JoyCameraManager->FindViewTargetCamera(Character)
+										   : UJoyCameraComponent::FindCameraComponent(Character);
+	};
+
 	if (CharacterSwitchSpec.From != nullptr)
 	{
 		CharacterSwitchSpec.From->bUseControllerRotationYaw = false;
-		if (const auto* FromCamera = UJoyCameraComponent::FindCameraComponent(CharacterSwitchSpec.From.Get()))
+		if (const auto* FromCamera = FindCamera(CharacterSwitchSpec.From.Get()))
 		{
 			FromCamera->PushCameraMode(UJoyCameraMode_PlayerSwitching::StaticClass(), true);
 		}
@@ -81,7 +88,7 @@ void AJoyPlayerController::DoSwitchCharacter()
 	if (CharacterSwitchSpec.ToController != nullptr && CharacterSwitchSpec.To != nullptr)
 	{
 		CharacterSwitchSpec.To->bUseControllerRotationYaw = false;
-		const auto* ToCamera = UJoyCameraComponent::FindCameraComponent(CharacterSwitchSpec.To.Get());
+		const auto* ToCamera = FindCamera(CharacterSwitchSpec.To.Get());
 		if (ToCamera && CharacterSwitchSpec.ExtraParam.BlendType != EJoyCameraBlendType::Default)
 		{
 			ToCamera->PushCameraMode(UJoyCameraMode_PlayerSwitching::StaticClass(), true);
@@ -8,6 +8,7 @@
 
 struct FJoyCameraConfigTable;
 class UJoyCameraData;
+class UJoyCameraModifierPreset;
 
 /**
  * 游戏全局配置。
@@ -24,6 +25,10 @@ public:
 
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Joy|Camera")
 	TSoftObjectPtr<UJoyCameraData> CameraDataConfig{};
+
+	// 启动时加载并注册的相机修改预设
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Joy|Camera")
+	TArray<TSoftObjectPtr<UJoyCameraModifierPreset>> CameraModifierPresets{};
 	
 private:
 	static UJoyGlobalGameSettings const* GetCDO();
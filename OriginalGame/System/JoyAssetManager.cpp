@@ -4,6 +4,7 @@
 
 #include "AbilitySystem/JoyGameplayCueManager.h"
 #include "AbilitySystemGlobals.h"
+#include "Camera/JoyCameraModifierPreset.h"
 #include "Engine/Engine.h"
 #include "JoyLogChannels.h"
 #include "Misc/App.h"
@@ -113,6 +114,7 @@ void UJoyAssetManager::StartInitialLoading()
 
 	STARTUP_JOB(InitializeAbilitySystem());
 	STARTUP_JOB(InitializeGameplayCueManager());
+	STARTUP_JOB(InitializeCameraModifierPresets());
 
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
@@ -134,6 +136,13 @@ void UJoyAssetManager::InitializeGameplayCueManager()
 	GCM->LoadAlwaysLoadedCues();
 }
 
+void UJoyAssetManager::InitializeCameraModifierPresets()
+{
+	SCOPED_BOOT_TIMING("UJoyAssetManager::InitializeCameraModifierPresets");
+
+	FJoyCameraModifierPresetRegistry::Initialize();
+}
+
 void UJoyAssetManager::DoAllStartupJobs()
 {
 	SCOPED_BOOT_TIMING("UJoyAssetManager::DoAllStartupJobs");
@@ -69,6 +69,9 @@ private:
 	void InitializeAbilitySystem();
 	void InitializeGameplayCueManager();
 
+	// Loads and validates the shared camera modifier presets
+	void InitializeCameraModifierPresets();
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
@@ -5,6 +5,7 @@
 #include "Camera/JoyCameraComponent.h"
 #include "Camera/JoyPlayerCameraManager.h"
 #include "JoyGameBlueprintLibrary.h"
+#include "JoyLogChannels.h"
 #include "Camera/JoyCameraData.h"
 #include "Kismet/GameplayStatics.h"
 #include "Player/JoyPlayerController.h"
@@ -37,7 +38,8 @@ void UJoyCameraBlueprintLibrary::ApplyCameraSettings_Immediately(
 }
 
 FCameraModifyHandle UJoyCameraBlueprintLibrary::ApplyCameraSettings(AActor* OwnerActor, float Duration,
-	float BlendInTime, float BlendOutTime, FCameraModifiers const& CameraModifiers, bool bNeedManualBreak)
+	float BlendInTime, float BlendOutTime, FCameraModifiers const& CameraModifiers, bool bNeedManualBreak,
+	int32 Priority, EJoyCameraModifyBlendMode BlendMode)
 {
 	if (OwnerActor == nullptr)
 	{
@@ -61,7 +63,46 @@ FCameraModifyHandle UJoyCameraBlueprintLibrary::ApplyCameraSettings(AActor* Owne
 		return FCameraModifyHandle(0);
 	}
 
-	return Modifier->ApplyCameraModify(Duration, BlendInTime, BlendOutTime, CameraModifiers, bNeedManualBreak);
+	return Modifier->ApplyCameraModify(
+		Duration, BlendInTime, BlendOutTime, CameraModifiers, bNeedManualBreak, Priority, BlendMode);
+}
+
+FCameraModifyHandle UJoyCameraBlueprintLibrary::ApplyCameraPreset(AActor* OwnerActor, FName PresetId,
+	float Duration, float BlendInTime, float BlendOutTime, bool bNeedManualBreak)
+{
+	return ApplyCameraPresetWithOverrides(OwnerActor, PresetId, Duration, BlendInTime, BlendOutTime,
+		FJoyCameraModifierPresetOverrides(), bNeedManualBreak);
+}
+
+FCameraModifyHandle UJoyCameraBlueprintLibrary::ApplyCameraPresetWithOverrides(AActor* OwnerActor, FName PresetId,
+	float Duration, float BlendInTime, float BlendOutTime, const FJoyCameraModifierPresetOverrides& Overrides,
+	bool bNeedManualBreak)
+{
+	if (OwnerActor == nullptr)
+	{
+		return FCameraModifyHandle(0);
+	}
+
+	const UJoyCameraModifierPreset* Preset = FJoyCameraModifierPresetRegistry::Find(PresetId);
+	if (Preset == nullptr)
+	{
+		UE_LOG(LogJoyCamera, Error, TEXT("ApplyCameraPreset: 找不到相机修改预设 %s"), *PresetId.ToString());
+		return FCameraModifyHandle(0);
+	}
+
+	UJoyCameraModifierController* Modifier = nullptr;
+	if (AJoyPlayerCameraManager* CameraManager = GetJoyPlayerCameraManager(OwnerActor->GetWorld()))
+	{
+		CameraManager->AddNewViewTarget(OwnerActor);
+		Modifier = CameraManager->GetCameraModifier(OwnerActor);
+	}
+
+	if (Modifier == nullptr)
+	{
+		return FCameraModifyHandle(0);
+	}
+
+	return Modifier->ApplyCameraPreset(Preset, Duration, BlendInTime, BlendOutTime, bNeedManualBreak, &Overrides);
 }
 
 void UJoyCameraBlueprintLibrary::ManualBreakCameraModifier(AActor* OwnerActor, FCameraModifyHandle ModifyHandler)
@@ -85,6 +126,28 @@ void UJoyCameraBlueprintLibrary::ManualBreakCameraModifier(AActor* OwnerActor, F
 	Modifier->BreakModifier(ModifyHandler);
 }
 
+void UJoyCameraBlueprintLibrary::EndCameraModifier(AActor* OwnerActor, FCameraModifyHandle ModifyHandler)
+{
+	if (OwnerActor == nullptr)
+	{
+		return;
+	}
+
+	UJoyCameraModifierController* Modifier = nullptr;
+	if (AJoyPlayerCameraManager* CameraManager = GetJoyPlayerCameraManager(OwnerActor->GetWorld()))
+	{
+		Modifier = CameraManager->GetCameraModifier(OwnerActor);
+	}
+
+	if (Modifier == nullptr)
+	{
+		return;
+	}
+
+	Modifier->EndModify(ModifyHandler);
+	Modifier->ResetViewTarget();
+}
+
 bool UJoyCameraBlueprintLibrary::CheckTargetInsideScreen(const UObject* WorldContextObject, const AActor* Target)
 {
 	if (Target == nullptr)
@@ -154,10 +217,20 @@ AJoyPlayerCameraManager* UJoyCameraBlueprintLibrary::GetJoyPlayerCameraManager(c
 	return nullptr;
 }
 
-void UJoyCameraBlueprintLibrary::GetCameraConfigMap(UObject const* WorldContextObject, TMap<FName, FJoyCameraConfigTable>& ConfigMapRef)
+FJoyCameraConfigRegistryPtr UJoyCameraBlueprintLibrary::GetCameraConfigRegistry(UObject const* WorldContextObject)
 {
 	if (UJoyCameraData const* CameraDataConfig = UJoyGlobalGameSettings::GetCameraDataConfig(WorldContextObject))
 	{
-		ConfigMapRef = CameraDataConfig->CacheCameraConfigs;
+		return CameraDataConfig->GetConfigRegistry();
+	}
+
+	return nullptr;
+}
+
+void UJoyCameraBlueprintLibrary::GetCameraConfigMap(UObject const* WorldContextObject, TMap<FName, FJoyCameraConfigTable>& ConfigMapRef)
+{
+	if (const FJoyCameraConfigRegistryPtr Registry = GetCameraConfigRegistry(WorldContextObject))
+	{
+		Registry->ToTableMap(ConfigMapRef);
 	}	
 }
@@ -4,6 +4,7 @@
 
 #include "Camera/Controller/JoyCameraModifierController.h"
 #include "Camera/JoyCameraData.h"
+#include "Camera/JoyCameraModifierPreset.h"
 #include "CoreMinimal.h"
 
 #include "JoyCameraBlueprintLibrary.generated.h"
@@ -31,10 +32,27 @@ public:
 	 * @param CameraModifiers 参数修改数据
 	 * @param bNeedManualBreak 是否需要手动中断修改过程，当为 true 时代表你需要手动调用 @function{BreakCameraModifier}
 	 * 使参数进入 BlendOut 状态
+	 * @param Priority 修改层优先级，高优先级的层覆盖低优先级的层，同优先级的覆盖层互相打断
+	 * @param BlendMode 修改层与低优先级层结果的混合方式
 	 */
 	UFUNCTION(BlueprintCallable, Category = Camera)
 	static FCameraModifyHandle ApplyCameraSettings(AActor* OwnerActor, float Duration, float BlendInTime,
-		float BlendOutTime, FCameraModifiers const& CameraModifiers, bool bNeedManualBreak = false);
+		float BlendOutTime, FCameraModifiers const& CameraModifiers, bool bNeedManualBreak = false,
+		int32 Priority = 0, EJoyCameraModifyBlendMode BlendMode = EJoyCameraModifyBlendMode::Override);
+
+	/**
+	 * 以预设 ID 引用共享的相机修改预设，优先级与混合方式取自预设
+	 * @param PresetId 预设 ID，对应 UJoyGlobalGameSettings::CameraModifierPresets 中的预设
+	 */
+	UFUNCTION(BlueprintCallable, Category = Camera)
+	static FCameraModifyHandle ApplyCameraPreset(AActor* OwnerActor, FName PresetId, float Duration, float BlendInTime,
+		float BlendOutTime, bool bNeedManualBreak = false);
+
+	/** 在预设的基础上覆盖少量参数，会拷贝一份修改设置 */
+	UFUNCTION(BlueprintCallable, Category = Camera)
+	static FCameraModifyHandle ApplyCameraPresetWithOverrides(AActor* OwnerActor, FName PresetId, float Duration,
+		float BlendInTime, float BlendOutTime, const FJoyCameraModifierPresetOverrides& Overrides,
+		bool bNeedManualBreak = false);
 
 	UFUNCTION(BlueprintCallable, Category = Camera)
 	static void ApplyCameraSettings_Immediately(AActor* OwnerActor, FCameraModifiers const& CameraModifiers);
@@ -42,6 +60,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Camera)
 	static void ManualBreakCameraModifier(AActor* OwnerActor, FCameraModifyHandle ModifyHandler);
 
+	/** 立即结束修改层，不经过 BlendOut */
+	UFUNCTION(BlueprintCallable, Category = Camera)
+	static void EndCameraModifier(AActor* OwnerActor, FCameraModifyHandle ModifyHandler);
+
 	UFUNCTION(BlueprintPure, Category = "Camera", DisplayName = "目标是否在屏幕内",
 		meta = (WorldContext = "WorldContextObject"))
 	static bool CheckTargetInsideScreen(const UObject* WorldContextObject, const AActor* Target);
@@ -53,6 +75,10 @@ public:
 	static void GetCameraViewFromTarget(
 		AActor* Target, FMinimalViewInfo& OutView, bool bRealTime = false, float DeltaTime = 0.f);
 
+	/** 获取共享的只读镜头配置注册表，不拷贝配置 */
+	static FJoyCameraConfigRegistryPtr GetCameraConfigRegistry(UObject const* WorldContextObject);
+
+	/** 拷贝一份完整的镜头配置，只读访问应使用 GetCameraConfigRegistry */
 	static void GetCameraConfigMap(
 		UObject const* WorldContextObject, UPARAM(ref) TMap<FName, FJoyCameraConfigTable>& ConfigMapRef);	
 };
@@ -19,6 +19,7 @@ public class OriginalGameEditor : ModuleRules
                 "CoreUObject",
                 "BlueprintGraph",
                 "Engine",
+                "OriginalGame",
                 "Slate",
                 "SlateCore"
             }
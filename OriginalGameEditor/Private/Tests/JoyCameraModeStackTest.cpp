@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JoyCameraModeStackTest.h"
+
+#include "Camera/CameraMode/JoyCameraModeStack.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJoyCameraModeStackBlendTest, "OriginalGame.Camera.ModeStack.Blend",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FJoyCameraModeStackBlendTest::RunTest(const FString& Parameters)
+{
+	UJoyCameraModeStack* Stack = NewObject<UJoyCameraModeStack>(GetTransientPackage());
+	const TSubclassOf<UJoyCameraMode> BaseClass = UJoyCameraModeStackTestMode_Base::StaticClass();
+	const TSubclassOf<UJoyCameraMode> SlowClass = UJoyCameraModeStackTestMode_Slow::StaticClass();
+	const TSubclassOf<UJoyCameraMode> FastClass = UJoyCameraModeStackTestMode_Fast::StaticClass();
+
+	float BlendInfoWeight = 0.f;
+	FGameplayTag BlendInfoTag;
+	FJoyCameraModeView View;
+
+	// 栈底不混合，后压入的模式从 0 开始混入
+	Stack->PushCameraMode(BaseClass);
+	Stack->PushCameraMode(SlowClass);
+	UJoyCameraMode* BaseMode = Stack->GetCameraModeInstance(BaseClass);
+	UJoyCameraMode* SlowMode = Stack->GetCameraModeInstance(SlowClass);
+	TestEqual(TEXT("压入后栈大小"), Stack->GetCameraStackNum(), 2);
+	TestTrue(TEXT("后压入的模式位于栈顶"), Stack->GetTopCameraMode() == SlowMode);
+	TestEqual(TEXT("栈底权重"), BaseMode->GetBlendWeight(), 1.f);
+	TestEqual(TEXT("新压入模式的初始权重"), SlowMode->GetBlendWeight(), 0.f);
+
+	int32 RemoveCount = Stack->UpdateStack(0.25f);
+	Stack->BlendStack(View, RemoveCount);
+	TestEqual(TEXT("混合中不跳过任何模式"), RemoveCount, 0);
+	TestEqual(TEXT("Slow 混入 0.25 秒的权重"), SlowMode->GetBlendWeight(), 0.25f, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("两层混合的 Fov"), View.FieldOfView, 82.5f, UE_KINDA_SMALL_NUMBER);
+
+	// GetBlendInfo 读取栈底的层
+	Stack->GetBlendInfo(BlendInfoWeight, BlendInfoTag);
+	TestEqual(TEXT("GetBlendInfo 的权重取自栈底"), BlendInfoWeight, BaseMode->GetBlendWeight());
+
+	Stack->PushCameraMode(FastClass);
+	UJoyCameraMode* FastMode = Stack->GetCameraModeInstance(FastClass);
+	RemoveCount = Stack->UpdateStack(0.25f);
+	Stack->BlendStack(View, RemoveCount);
+	TestEqual(TEXT("三层混合中不跳过任何模式"), RemoveCount, 0);
+	TestEqual(TEXT("Fast 混入 0.25 秒的权重"), FastMode->GetBlendWeight(), 0.5f, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Slow 混入 0.5 秒的权重"), SlowMode->GetBlendWeight(), 0.5f, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("三层混合的 Fov"), View.FieldOfView, 97.5f, UE_KINDA_SMALL_NUMBER);
+
+	// 栈顶完全混入后，其下的模式不再更新也不参与混合
+	RemoveCount = Stack->UpdateStack(0.25f);
+	Stack->BlendStack(View, RemoveCount);
+	TestEqual(TEXT("完全混入的栈顶之下的模式数量"), RemoveCount, 2);
+	TestEqual(TEXT("Fast 完全混入"), FastMode->GetBlendWeight(), 1.f);
+	TestEqual(TEXT("被覆盖的 Slow 不再更新"), SlowMode->GetBlendWeight(), 0.5f, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("只输出栈顶的 Fov"), View.FieldOfView, 120.f, UE_KINDA_SMALL_NUMBER);
+	Stack->GetBlendInfo(BlendInfoWeight, BlendInfoTag);
+	TestEqual(TEXT("栈顶完全混入后 GetBlendInfo 仍取自栈底"), BlendInfoWeight, BaseMode->GetBlendWeight());
+
+	// 相邻的同类压栈与出栈互相抵消
+	Stack->AddCameraMode(BaseClass);
+	Stack->RemoveCameraMode(BaseClass);
+	Stack->UpdateCameraStack();
+	TestEqual(TEXT("抵消的操作不改变栈大小"), Stack->GetCameraStackNum(), 3);
+	TestTrue(TEXT("抵消的操作不改变栈顶"), Stack->GetTopCameraMode() == FastMode);
+
+	// 出栈后从 Slow 的当前权重继续混合
+	Stack->RemoveTopCameraMode();
+	TestTrue(TEXT("出栈后的栈顶"), Stack->GetTopCameraMode() == SlowMode);
+	RemoveCount = Stack->UpdateStack(0.25f);
+	Stack->BlendStack(View, RemoveCount);
+	TestEqual(TEXT("出栈后不跳过任何模式"), RemoveCount, 0);
+	TestEqual(TEXT("Slow 继续混入的权重"), SlowMode->GetBlendWeight(), 0.75f, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("出栈后的 Fov"), View.FieldOfView, 67.5f, UE_KINDA_SMALL_NUMBER);
+
+	RemoveCount = Stack->UpdateStack(0.25f);
+	Stack->BlendStack(View, RemoveCount);
+	TestEqual(TEXT("Slow 完全混入后跳过栈底"), RemoveCount, 1);
+	TestEqual(TEXT("Slow 完全混入后的 Fov"), View.FieldOfView, 60.f, UE_KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/CameraMode/JoyCameraMode.h"
+#include "CoreMinimal.h"
+
+#include "JoyCameraModeStackTest.generated.h"
+
+/**
+ * 相机模式栈自动化测试使用的模式，不依赖 ViewTarget，输出固定的 Fov，按线性方式混合
+ * 只用于测试，放在编辑器模块中，不随游戏打包
+ */
+UCLASS(Abstract, NotBlueprintable, HideDropdown)
+class UJoyCameraModeStackTestMode : public UJoyCameraMode
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraModeStackTestMode()
+	{
+		BlendFunction = EJoyCameraModeBlendFunction::Linear;
+	}
+
+	virtual void OnActivation() override
+	{
+	}
+
+protected:
+	virtual void UpdateView(float DeltaTime) override
+	{
+		View.FieldOfView = FieldOfView;
+	}
+
+	float FieldOfView = 90.f;
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class UJoyCameraModeStackTestMode_Base : public UJoyCameraModeStackTestMode
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraModeStackTestMode_Base()
+	{
+		BlendTime = 0.f;
+		FieldOfView = 90.f;
+	}
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class UJoyCameraModeStackTestMode_Slow : public UJoyCameraModeStackTestMode
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraModeStackTestMode_Slow()
+	{
+		BlendTime = 1.f;
+		FieldOfView = 60.f;
+	}
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class UJoyCameraModeStackTestMode_Fast : public UJoyCameraModeStackTestMode
+{
+	GENERATED_BODY()
+
+public:
+	UJoyCameraModeStackTestMode_Fast()
+	{
+		BlendTime = 0.5f;
+		FieldOfView = 120.f;
+	}
+};